@@ -10,25 +10,34 @@
 
 #include <algorithm>
 #include <array>
+#include <map>
 #include <set>
 #include <utility>
 
+#include "core/fpdfapi/edit/cpdf_stringarchivestream.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_encryptor.h"
 #include "core/fpdfapi/parser/cpdf_flateencoder.h"
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_security_handler.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fpdfapi/parser/object_tree_traversal_util.h"
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
 #include "core/fxcrt/containers/contains.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_size_data_vector.h"
 #include "core/fxcrt/fx_extension.h"
+#include "core/fxcrt/fx_parallel.h"
 #include "core/fxcrt/fx_random.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/raw_span.h"
@@ -79,14 +88,21 @@ bool CFX_FileBufferArchive::WriteBlock(pdfium::span<const uint8_t> buffer) {
     return true;
   }
 
-  pdfium::span<const uint8_t> src_span = buffer;
-  while (!src_span.empty()) {
-    size_t copy_size = std::min(available_.size(), src_span.size());
-    available_ = fxcrt::spancpy(available_, src_span.first(copy_size));
-    src_span = src_span.subspan(copy_size);
-    if (available_.empty() && !Flush()) {
+  if (buffer.size() >= buffer_.size()) {
+    // Pass large blocks, such as a copy of the original file, straight through.
+    if (!Flush() || !backing_file_->WriteBlock(buffer)) {
       return false;
     }
+  } else {
+    pdfium::span<const uint8_t> src_span = buffer;
+    while (!src_span.empty()) {
+      size_t copy_size = std::min(available_.size(), src_span.size());
+      available_ = fxcrt::spancpy(available_, src_span.first(copy_size));
+      src_span = src_span.subspan(copy_size);
+      if (available_.empty() && !Flush()) {
+        return false;
+      }
+    }
   }
 
   FX_SAFE_FILESIZE safe_offset = offset_;
@@ -118,8 +134,31 @@ bool OutputIndex(IFX_ArchiveStream* archive, FX_FILESIZE offset) {
          archive->WriteByte(0);
 }
 
+// Appends `value` to `data` as a big-endian number of `width` bytes.
+void AppendXRefField(uint64_t value, size_t width, DataVector<uint8_t>* data) {
+  for (size_t i = width; i > 0; --i) {
+    data->push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+  }
+}
+
 }  // namespace
 
+CPDF_Creator::PendingObject::PendingObject(uint32_t objnum,
+                                           uint32_t gennum,
+                                           RetainPtr<const CPDF_Object> object,
+                                           bool delete_after_write)
+    : objnum(objnum),
+      gennum(gennum),
+      object(std::move(object)),
+      delete_after_write(delete_after_write) {}
+
+CPDF_Creator::PendingObject::PendingObject(PendingObject&&) noexcept = default;
+
+CPDF_Creator::PendingObject& CPDF_Creator::PendingObject::operator=(
+    PendingObject&&) noexcept = default;
+
+CPDF_Creator::PendingObject::~PendingObject() = default;
+
 CPDF_Creator::CPDF_Creator(CPDF_Document* pDoc,
                            RetainPtr<IFX_RetainableWriteStream> archive)
     : document_(pDoc),
@@ -127,47 +166,190 @@ CPDF_Creator::CPDF_Creator(CPDF_Document* pDoc,
       encrypt_dict_(parser_ ? parser_->GetEncryptDict() : nullptr),
       security_handler_(parser_ ? parser_->GetSecurityHandler() : nullptr),
       last_obj_num_(document_->GetLastObjNum()),
-      archive_(std::make_unique<CFX_FileBufferArchive>(std::move(archive))) {}
+      archive_(std::make_unique<CFX_FileBufferArchive>(std::move(archive))),
+      encode_thread_count_(fxcrt::GetMaxParallelism()) {}
 
 CPDF_Creator::~CPDF_Creator() = default;
 
-bool CPDF_Creator::WriteIndirectObj(uint32_t objnum, const CPDF_Object* pObj) {
-  if (!archive_->WriteDWord(objnum) || !archive_->WriteString(" 0 obj\r\n")) {
+bool CPDF_Creator::WriteIndirectObj(uint32_t objnum,
+                                    uint32_t gennum,
+                                    const CPDF_Object* pObj,
+                                    DataVector<uint8_t> encoded_data) {
+  if (!archive_->WriteDWord(objnum) || !archive_->WriteString(" ") ||
+      !archive_->WriteDWord(gennum) || !archive_->WriteString(" obj\r\n")) {
     return false;
   }
 
   std::unique_ptr<CPDF_Encryptor> encryptor;
   if (GetCryptoHandler() && pObj != encrypt_dict_) {
-    encryptor = std::make_unique<CPDF_Encryptor>(GetCryptoHandler(), objnum);
+    encryptor =
+        std::make_unique<CPDF_Encryptor>(GetCryptoHandler(), objnum, gennum);
   }
 
-  if (!pObj->WriteTo(archive_.get(), encryptor.get())) {
+  if (!encoded_data.empty()) {
+    if (!pObj->AsStream()->WriteEncodedTo(archive_.get(), encryptor.get(),
+                                          std::move(encoded_data))) {
+      return false;
+    }
+  } else if (!pObj->WriteTo(archive_.get(), encryptor.get())) {
     return false;
   }
 
   return archive_->WriteString("\r\nendobj\r\n");
 }
 
+bool CPDF_Creator::AddPendingObject(uint32_t objnum,
+                                    uint32_t gennum,
+                                    RetainPtr<const CPDF_Object> pObj,
+                                    bool delete_after_write) {
+  // Bounds the memory held by objects that are waiting to be written.
+  static constexpr size_t kMaxPendingObjects = 256;
+  static constexpr size_t kMaxPendingEncodeBytes = 32 * 1024 * 1024;
+
+  const CPDF_Stream* pStream = pObj->AsStream();
+  if (pStream && pStream->IsFlateEncodedOnWrite()) {
+    pending_encode_bytes_ += pStream->GetRawSize();
+  }
+  pending_objects_.emplace_back(objnum, gennum, std::move(pObj),
+                                delete_after_write);
+  if (encode_thread_count_ > 1 &&
+      pending_objects_.size() < kMaxPendingObjects &&
+      pending_encode_bytes_ < kMaxPendingEncodeBytes) {
+    return true;
+  }
+  return FlushPendingObjects();
+}
+
+bool CPDF_Creator::FlushPendingObjects() {
+  std::vector<size_t> encode_indices;
+  for (size_t i = 0; i < pending_objects_.size(); ++i) {
+    const CPDF_Stream* pStream = pending_objects_[i].object->AsStream();
+    if (pStream && pStream->IsFlateEncodedOnWrite()) {
+      encode_indices.push_back(i);
+    }
+  }
+  // A lone stream gets compressed as it is written, like without threads.
+  if (encode_indices.size() > 1) {
+    // Only the raw data is handed to the other threads, since the objects
+    // themselves are not safe to use from them.
+    std::vector<RetainPtr<CPDF_StreamAcc>> accessors;
+    std::vector<pdfium::span<const uint8_t>> raw_data;
+    accessors.reserve(encode_indices.size());
+    raw_data.reserve(encode_indices.size());
+    for (size_t index : encode_indices) {
+      auto pAcc = pdfium::MakeRetain<CPDF_StreamAcc>(
+          pdfium::WrapRetain(pending_objects_[index].object->AsStream()));
+      pAcc->LoadAllDataRaw();
+      raw_data.push_back(pAcc->GetSpan());
+      accessors.push_back(std::move(pAcc));
+    }
+    std::vector<DataVector<uint8_t>> encoded_data(encode_indices.size());
+    fxcrt::ParallelFor(encode_indices.size(), encode_thread_count_,
+                       [&raw_data, &encoded_data](size_t i) {
+                         encoded_data[i] =
+                             CPDF_FlateEncoder::Encode(raw_data[i]);
+                       });
+    for (size_t i = 0; i < encode_indices.size(); ++i) {
+      pending_objects_[encode_indices[i]].encoded_data =
+          std::move(encoded_data[i]);
+    }
+  }
+
+  for (PendingObject& pending : pending_objects_) {
+    // Object streams cannot hold streams, or the objects needed to decrypt
+    // them.
+    if (PacksObjects() && !pending.object->IsStream() &&
+        pending.object.Get() != encrypt_dict_.Get() && pending.gennum == 0) {
+      if (!PackObject(pending.objnum, pending.object.Get())) {
+        return false;
+      }
+    } else {
+      object_offsets_[pending.objnum] = archive_->CurrentOffset();
+      if (!WriteIndirectObj(pending.objnum, pending.gennum,
+                            pending.object.Get(),
+                            std::move(pending.encoded_data))) {
+        return false;
+      }
+    }
+    if (pending.delete_after_write) {
+      pending.object.Reset();
+      document_->DeleteIndirectObject(pending.objnum);
+    }
+  }
+  pending_objects_.clear();
+  pending_encode_bytes_ = 0;
+  return true;
+}
+
+bool CPDF_Creator::PacksObjects() const {
+  return objects_per_stream_ > 0 && !is_incremental_;
+}
+
+bool CPDF_Creator::UsesXRefStream() const {
+  if (!is_incremental_) {
+    return PacksObjects();
+  }
+  return parser_->IsXRefStream() || write_changes_;
+}
+
+bool CPDF_Creator::PackObject(uint32_t objnum, const CPDF_Object* pObj) {
+  object_stream_entries_.emplace_back(
+      objnum, static_cast<FX_FILESIZE>(object_stream_data_.tellp()));
+  CPDF_StringArchiveStream archive(&object_stream_data_);
+  // Strings in object streams are only encrypted along with the stream.
+  if (!pObj->WriteTo(&archive, nullptr) || !archive.WriteString("\n")) {
+    return false;
+  }
+  if (object_stream_entries_.size() < objects_per_stream_) {
+    return true;
+  }
+  return WriteObjectStream();
+}
+
+bool CPDF_Creator::WriteObjectStream() {
+  if (object_stream_entries_.empty()) {
+    return true;
+  }
+
+  const uint32_t stream_objnum = next_object_stream_objnum_++;
+  ByteString header;
+  for (size_t i = 0; i < object_stream_entries_.size(); ++i) {
+    const auto& [objnum, offset] = object_stream_entries_[i];
+    header += ByteString::Format("%u %u ", objnum, static_cast<uint32_t>(offset));
+    packed_objects_[objnum] = {stream_objnum, static_cast<uint32_t>(i)};
+  }
+  const ByteString body(object_stream_data_);
+  DataVector<uint8_t> data(header.GetLength() + body.GetLength());
+  fxcrt::Copy(header.unsigned_span(), data);
+  fxcrt::Copy(body.unsigned_span(),
+              pdfium::span(data).subspan(header.GetLength()));
+
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Type", "ObjStm");
+  dict->SetNewFor<CPDF_Number>(
+      "N", fxcrt::CollectionSize<int>(object_stream_entries_));
+  dict->SetNewFor<CPDF_Number>("First",
+                               pdfium::checked_cast<int>(header.GetLength()));
+  auto stream =
+      pdfium::MakeRetain<CPDF_Stream>(std::move(data), std::move(dict));
+
+  object_stream_entries_.clear();
+  object_stream_data_.str("");
+  object_offsets_[stream_objnum] = archive_->CurrentOffset();
+  return WriteIndirectObj(stream_objnum, 0, stream.Get());
+}
+
 bool CPDF_Creator::WriteOldIndirectObject(uint32_t objnum) {
   if (parser_->IsObjectFree(objnum)) {
     return true;
   }
 
-  object_offsets_[objnum] = archive_->CurrentOffset();
-
   bool bExistInMap = !!document_->GetIndirectObject(objnum);
   RetainPtr<CPDF_Object> pObj = document_->GetOrParseIndirectObject(objnum);
   if (!pObj) {
-    object_offsets_.erase(objnum);
     return true;
   }
-  if (!WriteIndirectObj(pObj->GetObjNum(), pObj.Get())) {
-    return false;
-  }
-  if (!bExistInMap) {
-    document_->DeleteIndirectObject(objnum);
-  }
-  return true;
+  return AddPendingObject(objnum, 0, std::move(pObj), !bExistInMap);
 }
 
 bool CPDF_Creator::WriteOldObjs() {
@@ -191,6 +373,9 @@ bool CPDF_Creator::WriteOldObjs() {
     }
     last_object_number_written = objnum;
   }
+  if (!FlushPendingObjects()) {
+    return false;
+  }
   // If there are no new objects to write, then adjust `last_obj_num_` if
   // needed to reflect the actual last object number.
   if (new_obj_num_array_.empty()) {
@@ -207,15 +392,22 @@ bool CPDF_Creator::WriteNewObjs() {
       continue;
     }
 
-    object_offsets_[objnum] = archive_->CurrentOffset();
-    if (!WriteIndirectObj(pObj->GetObjNum(), pObj.Get())) {
+    // Changed objects replace the original ones, so keep their generation.
+    const uint32_t gennum = write_changes_ ? pObj->GetGenNum() : 0;
+    if (!AddPendingObject(objnum, gennum, std::move(pObj),
+                          /*delete_after_write=*/false)) {
       return false;
     }
   }
-  return true;
+  return FlushPendingObjects();
 }
 
 void CPDF_Creator::InitNewObjNumOffsets() {
+  if (write_changes_) {
+    InitChangedObjNums();
+    return;
+  }
+
   for (const auto& pair : *document_) {
     const uint32_t objnum = pair.first;
     if (is_incremental_ ||
@@ -233,11 +425,30 @@ void CPDF_Creator::InitNewObjNumOffsets() {
   }
 }
 
+void CPDF_Creator::InitChangedObjNums() {
+  // The document records every object that was added, edited or deleted, so
+  // nothing else needs to be looked at.
+  const CPDF_ModifiedObjects* modified_objects =
+      document_->GetModifiedObjects();
+  std::set<uint32_t> objnums = modified_objects->modified();
+  objnums.insert(modified_objects->deleted().begin(),
+                 modified_objects->deleted().end());
+  for (uint32_t objnum : objnums) {
+    if (document_->GetIndirectObject(objnum)) {
+      new_obj_num_array_.push_back(objnum);
+    } else if (parser_->IsValidObjectNumber(objnum) &&
+               !parser_->IsObjectFree(objnum)) {
+      deleted_obj_nums_.push_back(objnum);
+    }
+  }
+}
+
 CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage1() {
   DCHECK(stage_ > Stage::kInvalid || stage_ < Stage::kInitWriteObjs20);
   if (stage_ == Stage::kInit0) {
     if (!parser_ || (security_changed_ && is_original_)) {
       is_incremental_ = false;
+      write_changes_ = false;
     }
 
     stage_ = Stage::kWriteHeader10;
@@ -255,6 +466,10 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage1() {
         version = parser_->GetFileVersion();
       }
 
+      if (PacksObjects()) {
+        version = std::max(version, 15);
+      }
+
       if (!archive_->WriteDWord(version % 10) ||
           !archive_->WriteString("\r\n%\xA1\xB3\xC5\xD7\r\n")) {
         return Stage::kInvalid;
@@ -312,6 +527,13 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage2() {
     if (!WriteNewObjs()) {
       return Stage::kInvalid;
     }
+    if (PacksObjects()) {
+      if (!WriteObjectStream()) {
+        return Stage::kInvalid;
+      }
+      // Object streams are numbered after all the other objects.
+      last_obj_num_ = std::max(last_obj_num_, next_object_stream_objnum_ - 1);
+    }
 
     stage_ = Stage::kWriteEncryptDict27;
   }
@@ -319,7 +541,7 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage2() {
     if (encrypt_dict_ && encrypt_dict_->IsInline()) {
       last_obj_num_ += 1;
       FX_FILESIZE saveOffset = archive_->CurrentOffset();
-      if (!WriteIndirectObj(last_obj_num_, encrypt_dict_.Get())) {
+      if (!WriteIndirectObj(last_obj_num_, 0, encrypt_dict_.Get())) {
         return Stage::kInvalid;
       }
 
@@ -340,7 +562,7 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage3() {
   uint32_t dwLastObjNum = last_obj_num_;
   if (stage_ == Stage::kInitWriteXRefs80) {
     xref_start_ = archive_->CurrentOffset();
-    if (!is_incremental_ || !parser_->IsXRefStream()) {
+    if (!UsesXRefStream()) {
       if (!is_incremental_ || parser_->GetLastXRefOffset() == 0) {
         ByteString str;
         str = pdfium::Contains(object_offsets_, 1)
@@ -445,19 +667,110 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage3() {
   return stage_;
 }
 
+bool CPDF_Creator::WriteXRefStream(uint32_t xref_objnum) {
+  // Entries are a type and two fields. Those are an offset and a generation
+  // number for objects written directly, and an object stream number and an
+  // index for packed ones. The stream itself is at the largest offset, so
+  // size the second field for it.
+  size_t offset_width = 4;
+  while (offset_width < sizeof(FX_FILESIZE) &&
+         (static_cast<uint64_t>(xref_start_) >> (8 * offset_width)) != 0) {
+    ++offset_width;
+  }
+
+  // Covers the objects written so far, and the stream itself.
+  std::map<uint32_t, FX_FILESIZE> offsets = object_offsets_;
+  offsets[xref_objnum] = xref_start_;
+
+  ByteString index;
+  DataVector<uint8_t> data;
+  if (write_changes_) {
+    std::set<uint32_t> objnums(deleted_obj_nums_.begin(),
+                               deleted_obj_nums_.end());
+    for (const auto& it : offsets) {
+      objnums.insert(it.first);
+    }
+    for (auto it = objnums.begin(); it != objnums.end();) {
+      const uint32_t first_objnum = *it;
+      uint32_t count = 0;
+      for (; it != objnums.end() && *it == first_objnum + count;
+           ++it, ++count) {
+        auto offset_it = offsets.find(*it);
+        if (offset_it == offsets.end()) {
+          // Deleted objects become free. Their number can be used again with
+          // the next generation.
+          const uint16_t gennum = parser_->GetObjectGenNum(*it);
+          AppendXRefField(0, 1, &data);
+          AppendXRefField(0, offset_width, &data);
+          AppendXRefField(gennum < 0xFFFF ? gennum + 1 : gennum, 2, &data);
+          continue;
+        }
+        RetainPtr<const CPDF_Object> obj = document_->GetIndirectObject(*it);
+        AppendXRefField(1, 1, &data);
+        AppendXRefField(static_cast<uint64_t>(offset_it->second), offset_width,
+                        &data);
+        AppendXRefField(obj ? obj->GetGenNum() : 0, 2, &data);
+      }
+      if (!index.IsEmpty()) {
+        index += " ";
+      }
+      index += ByteString::Format("%u %u", first_objnum, count);
+    }
+  } else {
+    // A full save lists every object number, with free entries for the ones
+    // that were not written.
+    for (uint32_t objnum = 0; objnum <= xref_objnum; ++objnum) {
+      auto packed_it = packed_objects_.find(objnum);
+      auto offset_it = offsets.find(objnum);
+      if (packed_it != packed_objects_.end()) {
+        AppendXRefField(2, 1, &data);
+        AppendXRefField(packed_it->second.first, offset_width, &data);
+        AppendXRefField(packed_it->second.second, 2, &data);
+      } else if (offset_it != offsets.end()) {
+        AppendXRefField(1, 1, &data);
+        AppendXRefField(static_cast<uint64_t>(offset_it->second), offset_width,
+                        &data);
+        AppendXRefField(0, 2, &data);
+      } else {
+        AppendXRefField(0, 1, &data);
+        AppendXRefField(0, offset_width, &data);
+        AppendXRefField(objnum == 0 ? 0xFFFF : 0, 2, &data);
+      }
+    }
+    index = ByteString::Format("0 %u", xref_objnum + 1);
+  }
+
+  // Cross-reference streams are never encrypted.
+  return archive_->WriteString("/W[1 ") &&
+         archive_->WriteDWord(static_cast<uint32_t>(offset_width)) &&
+         archive_->WriteString(" 2]/Index[") &&
+         archive_->WriteString(index.AsStringView()) &&
+         archive_->WriteString("]/Length ") &&
+         archive_->WriteDWord(fxcrt::CollectionSize<uint32_t>(data)) &&
+         archive_->WriteString(">>stream\r\n") && archive_->WriteBlock(data) &&
+         archive_->WriteString("\r\nendstream\r\nendobj");
+}
+
 CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
   DCHECK(stage_ >= Stage::kWriteTrailerAndFinish90);
 
-  bool bXRefStream = is_incremental_ && parser_->IsXRefStream();
+  const bool bXRefStream = UsesXRefStream();
+  // Full saves number it after the object streams.
+  const uint32_t xref_objnum =
+      is_incremental_ ? document_->GetLastObjNum() + 1 : last_obj_num_ + 1;
   if (!bXRefStream) {
     if (!archive_->WriteString("trailer\r\n<<")) {
       return Stage::kInvalid;
     }
   } else {
-    if (!archive_->WriteDWord(document_->GetLastObjNum() + 1) ||
+    if (!archive_->WriteDWord(xref_objnum) ||
         !archive_->WriteString(" 0 obj <<")) {
       return Stage::kInvalid;
     }
+    if ((write_changes_ || PacksObjects()) &&
+        !archive_->WriteString("/Type/XRef")) {
+      return Stage::kInvalid;
+    }
   }
 
   if (parser_) {
@@ -500,7 +813,8 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
 
     uint32_t dwObjNum = encrypt_dict_->GetObjNum();
     if (dwObjNum == 0) {
-      dwObjNum = document_->GetLastObjNum() + 1;
+      // Written last, in kWriteEncryptDict27.
+      dwObjNum = last_obj_num_;
     }
     if (!archive_->WriteString(" ") || !archive_->WriteDWord(dwObjNum) ||
         !archive_->WriteString(" 0 R ")) {
@@ -530,6 +844,10 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
     if (!archive_->WriteString(">>")) {
       return Stage::kInvalid;
     }
+  } else if (write_changes_ || PacksObjects()) {
+    if (!WriteXRefStream(xref_objnum)) {
+      return Stage::kInvalid;
+    }
   } else {
     if (!archive_->WriteString("/W[0 4 1]/Index[")) {
       return Stage::kInvalid;
@@ -595,13 +913,17 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
 }
 
 bool CPDF_Creator::Create(uint32_t flags) {
-  is_incremental_ = !!(flags & FPDFCREATE_INCREMENTAL);
+  write_changes_ = !!(flags & FPDFCREATE_INCREMENTAL_CHANGES);
+  is_incremental_ = !!(flags & FPDFCREATE_INCREMENTAL) || write_changes_;
   is_original_ = !(flags & FPDFCREATE_NO_ORIGINAL);
 
   stage_ = Stage::kInit0;
   last_obj_num_ = document_->GetLastObjNum();
   object_offsets_.clear();
   new_obj_num_array_.clear();
+  deleted_obj_nums_.clear();
+  packed_objects_.clear();
+  next_object_stream_objnum_ = last_obj_num_ + 1;
 
   InitID();
   return Continue();
@@ -683,6 +1005,12 @@ bool CPDF_Creator::Continue() {
   return stage_ > Stage::kInvalid;
 }
 
+void CPDF_Creator::EnableObjectStreams(uint32_t objects_per_stream) {
+  // Indices in object streams get 2 bytes in the cross-reference stream.
+  CHECK_LE(objects_per_stream, 0xFFFFu);
+  objects_per_stream_ = objects_per_stream;
+}
+
 bool CPDF_Creator::SetFileVersion(int32_t fileVersion) {
   if (fileVersion < 10 || fileVersion > 17) {
     return false;
@@ -7,11 +7,17 @@
 #ifndef CORE_FPDFAPI_EDIT_CPDF_CREATOR_H_
 #define CORE_FPDFAPI_EDIT_CPDF_CREATOR_H_
 
+#include <stddef.h>
+
 #include <map>
 #include <memory>
+#include <sstream>
+#include <utility>
 #include <vector>
 
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/fx_string_wrappers.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
@@ -25,6 +31,8 @@ class CPDF_Parser;
 
 #define FPDFCREATE_INCREMENTAL 1
 #define FPDFCREATE_NO_ORIGINAL 2
+// Incremental, and also writes the objects the document recorded as modified.
+#define FPDFCREATE_INCREMENTAL_CHANGES 4
 
 class CPDF_Creator {
  public:
@@ -36,6 +44,18 @@ class CPDF_Creator {
   bool Create(uint32_t flags);
   bool SetFileVersion(int32_t fileVersion);
 
+  // Packs up to `objects_per_stream` objects other than streams into each
+  // object stream, and writes a cross-reference stream instead of a table.
+  // Only applies to saves that are not incremental, which then need at least
+  // PDF 1.5. `objects_per_stream` must be at most 65535.
+  void EnableObjectStreams(uint32_t objects_per_stream);
+
+  // Defaults to the number of hardware threads. With 1, every object is
+  // written as soon as it is visited.
+  void SetEncodeThreadCountForTesting(size_t count) {
+    encode_thread_count_ = count;
+  }
+
  private:
   enum class Stage {
     kInvalid = -1,
@@ -54,10 +74,34 @@ class CPDF_Creator {
     kComplete100 = 100,
   };
 
+  // An object that has been visited but not yet written, so that the streams
+  // of several of them can be compressed at once.
+  struct PendingObject {
+    PendingObject(uint32_t objnum,
+                  uint32_t gennum,
+                  RetainPtr<const CPDF_Object> object,
+                  bool delete_after_write);
+    PendingObject(PendingObject&&) noexcept;
+    PendingObject& operator=(PendingObject&&) noexcept;
+    ~PendingObject();
+
+    uint32_t objnum;
+    uint32_t gennum;
+    RetainPtr<const CPDF_Object> object;
+    // Whether to remove `object` from the document once it is written.
+    bool delete_after_write;
+    // The compressed data of `object`, if it is a stream compressed ahead of
+    // writing.
+    DataVector<uint8_t> encoded_data;
+  };
+
   bool Continue();
   void Clear();
 
   void InitNewObjNumOffsets();
+  // For FPDFCREATE_INCREMENTAL_CHANGES, fills `new_obj_num_array_` and
+  // `deleted_obj_nums_` from the objects the document recorded as modified.
+  void InitChangedObjNums();
   void InitID();
 
   CPDF_Creator::Stage WriteDoc_Stage1();
@@ -68,7 +112,27 @@ class CPDF_Creator {
   bool WriteOldIndirectObject(uint32_t objnum);
   bool WriteOldObjs();
   bool WriteNewObjs();
-  bool WriteIndirectObj(uint32_t objnum, const CPDF_Object* pObj);
+  // `encoded_data`, if not empty, is the data of the stream `pObj` already
+  // compressed by CPDF_FlateEncoder::Encode().
+  bool WriteIndirectObj(uint32_t objnum,
+                        uint32_t gennum,
+                        const CPDF_Object* pObj,
+                        DataVector<uint8_t> encoded_data = {});
+  // Queues an object for writing. Objects are written in the order they are
+  // added, but compressing their streams happens on several threads first.
+  bool AddPendingObject(uint32_t objnum,
+                        uint32_t gennum,
+                        RetainPtr<const CPDF_Object> pObj,
+                        bool delete_after_write);
+  bool FlushPendingObjects();
+  // Whether objects go into object streams, where possible.
+  bool PacksObjects() const;
+  bool UsesXRefStream() const;
+  // Adds `pObj` to the object stream being filled, and writes that out once
+  // it is full.
+  bool PackObject(uint32_t objnum, const CPDF_Object* pObj);
+  bool WriteObjectStream();
+  bool WriteXRefStream(uint32_t xref_objnum);
 
   CPDF_CryptoHandler* GetCryptoHandler();
 
@@ -85,11 +149,28 @@ class CPDF_Creator {
   FX_FILESIZE xref_start_ = 0;
   std::map<uint32_t, FX_FILESIZE> object_offsets_;
   std::vector<uint32_t> new_obj_num_array_;  // Sorted, ascending.
+  // Original objects deleted from the document, written as free entries.
+  std::vector<uint32_t> deleted_obj_nums_;  // Sorted, ascending.
+  std::vector<PendingObject> pending_objects_;
+  // Raw size of the streams in `pending_objects_` that are to be compressed.
+  size_t pending_encode_bytes_ = 0;
+  size_t encode_thread_count_;
+  // 0 unless EnableObjectStreams() was called.
+  uint32_t objects_per_stream_ = 0;
+  uint32_t next_object_stream_objnum_ = 0;
+  // The objects in the object stream being filled, as object numbers and
+  // offsets into `object_stream_data_`.
+  std::vector<std::pair<uint32_t, FX_FILESIZE>> object_stream_entries_;
+  fxcrt::ostringstream object_stream_data_;
+  // Object number to the object stream it was packed into, and its index there.
+  std::map<uint32_t, std::pair<uint32_t, uint32_t>> packed_objects_;
   RetainPtr<CPDF_Array> id_array_;
   int32_t file_version_ = 0;
   bool security_changed_ = false;
   bool is_incremental_ = false;
   bool is_original_ = false;
+  // Set for FPDFCREATE_INCREMENTAL_CHANGES.
+  bool write_changes_ = false;
 };
 
 #endif  // CORE_FPDFAPI_EDIT_CPDF_CREATOR_H_
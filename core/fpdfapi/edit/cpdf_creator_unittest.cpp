@@ -0,0 +1,65 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/edit/cpdf_creator.h"
+
+#include <string>
+
+#include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_test_document.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/string_write_stream.h"
+
+using testing::HasSubstr;
+
+namespace {
+
+std::string SaveWithThreads(CPDF_Document* doc, size_t thread_count) {
+  auto stream = pdfium::MakeRetain<StringWriteStream>();
+  CPDF_Creator creator(doc, stream);
+  creator.SetEncodeThreadCountForTesting(thread_count);
+  EXPECT_TRUE(creator.Create(0));
+
+  // The second part of the trailer /ID is different for every save.
+  std::string saved = stream->ToString();
+  return saved.substr(0, saved.find("trailer"));
+}
+
+}  // namespace
+
+using CPDFCreatorTest = TestWithPageModule;
+
+TEST_F(CPDFCreatorTest, ParallelEncodingMatchesSerial) {
+  CPDF_TestDocument doc;
+  doc.CreateNewDoc();
+
+  // Enough streams for several batches, with a few that do not get
+  // compressed in between.
+  for (int i = 0; i < 600; ++i) {
+    ByteString content = ByteString::Format("BT /F1 %d Tf (", i);
+    for (int j = 0; j < i % 37; ++j) {
+      content += ByteString::Format("text %d ", j * i);
+    }
+    content += ") Tj ET";
+    auto stream = doc.NewIndirect<CPDF_Stream>(content.unsigned_span());
+    if (i % 50 == 0) {
+      stream->GetMutableDict()->SetNewFor<CPDF_Name>("Type", "Metadata");
+      stream->GetMutableDict()->SetNewFor<CPDF_Name>("Subtype", "XML");
+    } else if (i % 70 == 0) {
+      stream->GetMutableDict()->SetNewFor<CPDF_Name>("Filter",
+                                                     "ASCIIHexDecode");
+    }
+  }
+
+  const std::string serial = SaveWithThreads(&doc, 1);
+  EXPECT_THAT(serial, HasSubstr("FlateDecode"));
+  EXPECT_THAT(serial, HasSubstr("BT /F1 50 Tf"));
+  EXPECT_EQ(serial, SaveWithThreads(&doc, 4));
+}
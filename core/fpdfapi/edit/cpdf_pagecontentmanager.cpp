@@ -161,14 +161,13 @@ void CPDF_PageContentManager::UpdateStream(size_t stream_index,
     return;
   }
 
-  RetainPtr<CPDF_Reference> stream_reference =
-      ToReference(contents_array->GetMutableObjectAt(stream_index));
-  if (!stream_reference) {
+  if (!ToReference(contents_array->GetObjectAt(stream_index))) {
     return;
   }
 
   auto new_stream = document_->NewIndirect<CPDF_Stream>(buf);
-  stream_reference->SetRef(document_, new_stream->GetObjNum());
+  contents_array->SetNewAt<CPDF_Reference>(stream_index, document_,
+                                           new_stream->GetObjNum());
 }
 
 void CPDF_PageContentManager::ScheduleRemoveStreamByIndex(size_t stream_index) {
@@ -23,6 +23,9 @@ namespace {
 
 CPDF_FontGlobals* g_FontGlobals = nullptr;
 
+// Set on threads with their own font globals. Overrides `g_FontGlobals`.
+thread_local CPDF_FontGlobals* g_ThreadFontGlobals = nullptr;
+
 RetainPtr<const CPDF_CMap> LoadPredefinedCMap(ByteStringView name) {
   if (!name.IsEmpty() && name[0] == '/') {
     name = name.Last(name.GetLength() - 1);
@@ -45,8 +48,24 @@ void CPDF_FontGlobals::Destroy() {
   g_FontGlobals = nullptr;
 }
 
+// static
+void CPDF_FontGlobals::CreateForThread() {
+  DCHECK(!g_ThreadFontGlobals);
+  g_ThreadFontGlobals = new CPDF_FontGlobals();
+}
+
+// static
+void CPDF_FontGlobals::DestroyForThread() {
+  DCHECK(g_ThreadFontGlobals);
+  delete g_ThreadFontGlobals;
+  g_ThreadFontGlobals = nullptr;
+}
+
 // static
 CPDF_FontGlobals* CPDF_FontGlobals::GetInstance() {
+  if (g_ThreadFontGlobals) {
+    return g_ThreadFontGlobals;
+  }
   DCHECK(g_FontGlobals);
   return g_FontGlobals;
 }
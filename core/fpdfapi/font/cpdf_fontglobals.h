@@ -27,6 +27,9 @@ class CPDF_FontGlobals {
   // Per-process singleton which must be managed by callers.
   static void Create();
   static void Destroy();
+  // Per-thread instance that GetInstance() returns instead, if created.
+  static void CreateForThread();
+  static void DestroyForThread();
   static CPDF_FontGlobals* GetInstance();
 
   // Caller must load the maps before using font globals.
@@ -452,6 +452,10 @@ class StockColorSpaces {
 
 StockColorSpaces* g_stock_colorspaces = nullptr;
 
+// Set on threads with their own stock color spaces, whose reference counts
+// cannot be shared between threads. Overrides `g_stock_colorspaces`.
+thread_local StockColorSpaces* g_thread_stock_colorspaces = nullptr;
+
 }  // namespace
 
 PatternValue::PatternValue() = default;
@@ -476,8 +480,23 @@ void CPDF_ColorSpace::DestroyGlobals() {
   g_stock_colorspaces = nullptr;
 }
 
+// static
+void CPDF_ColorSpace::InitializeGlobalsForThread() {
+  CHECK(!g_thread_stock_colorspaces);
+  g_thread_stock_colorspaces = new StockColorSpaces();
+}
+
+// static
+void CPDF_ColorSpace::DestroyGlobalsForThread() {
+  delete g_thread_stock_colorspaces;
+  g_thread_stock_colorspaces = nullptr;
+}
+
 // static
 RetainPtr<CPDF_ColorSpace> CPDF_ColorSpace::GetStockCS(Family family) {
+  if (g_thread_stock_colorspaces) {
+    return g_thread_stock_colorspaces->GetStockCS(family);
+  }
   return g_stock_colorspaces->GetStockCS(family);
 }
 
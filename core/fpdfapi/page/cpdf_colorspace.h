@@ -70,6 +70,10 @@ class CPDF_ColorSpace : public Retainable, public Observable {
 
   static void InitializeGlobals();
   static void DestroyGlobals();
+  // Stock color spaces that GetStockCS() returns instead on the calling
+  // thread.
+  static void InitializeGlobalsForThread();
+  static void DestroyGlobalsForThread();
 
   // `family` must be one of the following:
   // - `kDeviceGray`
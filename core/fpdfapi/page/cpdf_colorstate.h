@@ -53,6 +53,11 @@ class CPDF_ColorState {
 
   bool HasRef() const { return !!ref_; }
 
+  // True if both refer to the same data, which implies equal values.
+  bool SharesDataWith(const CPDF_ColorState& that) const {
+    return ref_ == that.ref_;
+  }
+
  private:
   class ColorData final : public Retainable {
    public:
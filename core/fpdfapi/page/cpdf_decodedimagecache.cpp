@@ -0,0 +1,197 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_decodedimagecache.h"
+
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/containers/contains.h"
+#include "core/fxge/dib/cfx_dibbase.h"
+
+namespace {
+
+CPDF_DecodedImageCache* g_DecodedImageCache = nullptr;
+
+// Set on threads with their own cache. Overrides `g_DecodedImageCache`.
+thread_local CPDF_DecodedImageCache* g_ThreadDecodedImageCache = nullptr;
+
+bool IsLargeEnough(const CPDF_DecodedImageCache::Image& image,
+                   const CFX_Size& max_size_required) {
+  if (!image.downsampled) {
+    return true;
+  }
+  if (max_size_required.width == 0 && max_size_required.height == 0) {
+    return false;
+  }
+  return image.bitmap->GetWidth() >= max_size_required.width &&
+         image.bitmap->GetHeight() >= max_size_required.height;
+}
+
+}  // namespace
+
+CPDF_DecodedImageCache::Key::Key(
+    const CPDF_Document* document,
+    RetainPtr<const CPDF_Stream> stream,
+    RetainPtr<const CPDF_Object> color_space)
+    : document(document),
+      stream(std::move(stream)),
+      color_space(std::move(color_space)) {}
+
+CPDF_DecodedImageCache::Key::Key(const Key& that) = default;
+
+CPDF_DecodedImageCache::Key::~Key() = default;
+
+bool CPDF_DecodedImageCache::Key::operator<(const Key& that) const {
+  return std::tie(document, stream, color_space) <
+         std::tie(that.document, that.stream, that.color_space);
+}
+
+CPDF_DecodedImageCache::Image::Image() = default;
+
+CPDF_DecodedImageCache::Image::Image(const Image& that) = default;
+
+CPDF_DecodedImageCache::Image::~Image() = default;
+
+CPDF_DecodedImageCache::Entry::Entry(const Key& key,
+                                     const Image& image,
+                                     size_t bytes)
+    : key(key), image(image), bytes(bytes) {}
+
+CPDF_DecodedImageCache::Entry::~Entry() = default;
+
+// static
+void CPDF_DecodedImageCache::Create() {
+  DCHECK(!g_DecodedImageCache);
+  g_DecodedImageCache = new CPDF_DecodedImageCache();
+}
+
+// static
+void CPDF_DecodedImageCache::Destroy() {
+  DCHECK(g_DecodedImageCache);
+  delete g_DecodedImageCache;
+  g_DecodedImageCache = nullptr;
+}
+
+// static
+void CPDF_DecodedImageCache::CreateForThread() {
+  DCHECK(!g_ThreadDecodedImageCache);
+  g_ThreadDecodedImageCache = new CPDF_DecodedImageCache();
+}
+
+// static
+void CPDF_DecodedImageCache::DestroyForThread() {
+  DCHECK(g_ThreadDecodedImageCache);
+  delete g_ThreadDecodedImageCache;
+  g_ThreadDecodedImageCache = nullptr;
+}
+
+// static
+CPDF_DecodedImageCache* CPDF_DecodedImageCache::GetInstance() {
+  if (g_ThreadDecodedImageCache) {
+    return g_ThreadDecodedImageCache;
+  }
+  DCHECK(g_DecodedImageCache);
+  return g_DecodedImageCache;
+}
+
+CPDF_DecodedImageCache::CPDF_DecodedImageCache() = default;
+
+CPDF_DecodedImageCache::~CPDF_DecodedImageCache() = default;
+
+const CPDF_DecodedImageCache::Image* CPDF_DecodedImageCache::Get(
+    const Key& key,
+    const CFX_Size& max_size_required,
+    const CFX_FloatRect& needed_rect) {
+  auto it = index_.find(key);
+  if (it == index_.end() ||
+      !IsLargeEnough(it->second->image, max_size_required) ||
+      !it->second->image.decoded_rect.Contains(needed_rect)) {
+    ++miss_count_;
+    return nullptr;
+  }
+  ++hit_count_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return &it->second->image;
+}
+
+bool CPDF_DecodedImageCache::Contains(const Key& key) const {
+  return pdfium::Contains(index_, key);
+}
+
+void CPDF_DecodedImageCache::Add(const Key& key, const Image& image) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    Remove(it);
+  }
+  size_t bytes = image.bitmap->GetEstimatedImageMemoryBurden();
+  if (image.mask) {
+    bytes += image.mask->GetEstimatedImageMemoryBurden();
+  }
+  lru_.emplace_front(key, image, bytes);
+  index_.emplace(key, lru_.begin());
+  total_bytes_ += bytes;
+  Shrink(max_bytes_);
+}
+
+void CPDF_DecodedImageCache::Remove(const CPDF_Document* document,
+                                    const CPDF_Stream* stream) {
+  auto it = index_.lower_bound(
+      Key(document, pdfium::WrapRetain(stream), nullptr));
+  while (it != index_.end() && it->first.document.get() == document &&
+         it->first.stream == stream) {
+    Remove(it++);
+  }
+}
+
+void CPDF_DecodedImageCache::ClearDocument(const CPDF_Document* document) {
+  auto it = index_.lower_bound(Key(document, nullptr, nullptr));
+  while (it != index_.end() && it->first.document.get() == document) {
+    Remove(it++);
+  }
+}
+
+void CPDF_DecodedImageCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  Shrink(max_bytes_);
+}
+
+void CPDF_DecodedImageCache::Shrink(size_t max_bytes) {
+  while (total_bytes_ > max_bytes) {
+    Remove(index_.find(lru_.back().key));
+  }
+}
+
+void CPDF_DecodedImageCache::ShrinkKeys(const std::set<Key>& keys,
+                                        size_t max_bytes) {
+  size_t bytes = 0;
+  for (const Key& key : keys) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      bytes += it->second->bytes;
+    }
+  }
+  auto it = lru_.end();
+  while (bytes > max_bytes && it != lru_.begin()) {
+    --it;
+    if (!pdfium::Contains(keys, it->key)) {
+      continue;
+    }
+    bytes -= it->bytes;
+    auto next = std::next(it);
+    Remove(index_.find(it->key));
+    it = next;
+  }
+}
+
+void CPDF_DecodedImageCache::Remove(EntryMap::iterator it) {
+  DCHECK(total_bytes_ >= it->second->bytes);
+  total_bytes_ -= it->second->bytes;
+  lru_.erase(it->second);
+  index_.erase(it);
+}
@@ -0,0 +1,143 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_DECODEDIMAGECACHE_H_
+#define CORE_FPDFAPI_PAGE_CPDF_DECODEDIMAGECACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <set>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CFX_DIBBase;
+class CPDF_Document;
+class CPDF_Object;
+class CPDF_Stream;
+
+// Keeps decoded images for all pages of all documents, so that an image drawn
+// on several pages, or drawn again after its page was closed, is not decoded
+// again. When adding an image goes over a limit on the memory the images take,
+// the least recently used images are dropped. All images of a document are
+// dropped when the document goes away. Nothing is kept until callers raise the
+// limit.
+class CPDF_DecodedImageCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 0;
+
+  // Identifies a decoded image stream. When the image names a color space
+  // that is looked up in the resources of the page or form drawing it,
+  // `color_space` is the object the name resolves to there. Otherwise it is
+  // nullptr, so the same image drawn from different pages has the same key.
+  struct Key {
+    Key(const CPDF_Document* document,
+        RetainPtr<const CPDF_Stream> stream,
+        RetainPtr<const CPDF_Object> color_space);
+    Key(const Key& that);
+    ~Key();
+
+    bool operator<(const Key& that) const;
+
+    UnownedPtr<const CPDF_Document> document;
+    RetainPtr<const CPDF_Stream> stream;
+    RetainPtr<const CPDF_Object> color_space;
+  };
+
+  struct Image {
+    Image();
+    Image(const Image& that);
+    ~Image();
+
+    RetainPtr<CFX_DIBBase> bitmap;
+    RetainPtr<CFX_DIBBase> mask;
+    uint32_t matte_color = 0;
+
+    // True if `bitmap` was decoded at less than the full size of the image, to
+    // fit a maximum size.
+    bool downsampled = false;
+
+    // The part of the image's unit square that was decoded. Lines outside of
+    // it are blank.
+    CFX_FloatRect decoded_rect{0, 0, 1, 1};
+  };
+
+  // Per-process singleton which must be managed by callers.
+  static void Create();
+  static void Destroy();
+  // Per-thread instance that GetInstance() returns instead, if created.
+  static void CreateForThread();
+  static void DestroyForThread();
+  static CPDF_DecodedImageCache* GetInstance();
+
+  // Returns the image for `key` and marks it as most recently used, or returns
+  // nullptr if there is none, if it was decoded smaller than
+  // `max_size_required`, or if it does not cover `needed_rect` of its unit
+  // square. A zero `max_size_required` asks for the full size. Counts as a hit
+  // or a miss.
+  const Image* Get(const Key& key,
+                   const CFX_Size& max_size_required,
+                   const CFX_FloatRect& needed_rect);
+
+  // Returns whether there is an image for `key`, whether or not it is usable.
+  // Does not count as a hit or a miss.
+  bool Contains(const Key& key) const;
+
+  // Adds `image` for `key`, replacing any existing entry.
+  void Add(const Key& key, const Image& image);
+
+  // Drops the images of `stream` in `document`.
+  void Remove(const CPDF_Document* document, const CPDF_Stream* stream);
+
+  // Drops the images of `document`.
+  void ClearDocument(const CPDF_Document* document);
+
+  // Drops images as needed to stay within `max_bytes`.
+  void SetMaxBytes(size_t max_bytes);
+  size_t max_bytes() const { return max_bytes_; }
+
+  // Drops least recently used images until the total is within `max_bytes`,
+  // without changing the limit.
+  void Shrink(size_t max_bytes);
+
+  // Drops least recently used images among those of `keys` until they take no
+  // more than `max_bytes` together. Other images are kept.
+  void ShrinkKeys(const std::set<Key>& keys, size_t max_bytes);
+
+  size_t size() const { return lru_.size(); }
+  size_t total_bytes() const { return total_bytes_; }
+  uint64_t hit_count() const { return hit_count_; }
+  uint64_t miss_count() const { return miss_count_; }
+
+ private:
+  struct Entry {
+    Entry(const Key& key, const Image& image, size_t bytes);
+    ~Entry();
+
+    Key key;
+    Image image;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+  using EntryMap = std::map<Key, EntryList::iterator>;
+
+  CPDF_DecodedImageCache();
+  ~CPDF_DecodedImageCache();
+
+  void Remove(EntryMap::iterator it);
+
+  // Most recently used first.
+  EntryList lru_;
+  EntryMap index_;
+  size_t max_bytes_ = kDefaultMaxBytes;
+  size_t total_bytes_ = 0;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_DECODEDIMAGECACHE_H_
@@ -0,0 +1,219 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_decodedimagecache.h"
+
+#include <memory>
+#include <utility>
+
+#include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_test_document.h"
+#include "core/fxcrt/check.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using Image = CPDF_DecodedImageCache::Image;
+using Key = CPDF_DecodedImageCache::Key;
+
+// Each image takes 100 * 100 * 4 bytes.
+constexpr size_t kImageBytes = 40000;
+
+// Room for all the images of any test.
+constexpr size_t kMaxBytes = 100 * kImageBytes;
+
+constexpr CFX_FloatRect kFullRect(0, 0, 1, 1);
+
+Image MakeImage(int size) {
+  Image image;
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  CHECK(bitmap->Create(size, size, FXDIB_Format::kBgra));
+  image.bitmap = std::move(bitmap);
+  return image;
+}
+
+RetainPtr<CPDF_Stream> MakeStream() {
+  return pdfium::MakeRetain<CPDF_Stream>(
+      pdfium::MakeRetain<CPDF_Dictionary>());
+}
+
+class CPDFDecodedImageCacheTest : public TestWithPageModule {
+ public:
+  void SetUp() override {
+    TestWithPageModule::SetUp();
+    cache_ = CPDF_DecodedImageCache::GetInstance();
+    cache_->SetMaxBytes(kMaxBytes);
+  }
+
+  CPDF_DecodedImageCache* cache() { return cache_; }
+
+ private:
+  CPDF_DecodedImageCache* cache_ = nullptr;
+};
+
+}  // namespace
+
+TEST_F(CPDFDecodedImageCacheTest, GetAndAdd) {
+  CPDF_TestDocument doc;
+  auto stream1 = MakeStream();
+  auto stream2 = MakeStream();
+  const Key key1(&doc, stream1, nullptr);
+  const Key key2(&doc, stream2, nullptr);
+  const Key key2_with_cs(&doc, stream2,
+                         pdfium::MakeRetain<CPDF_Name>(nullptr, "CS"));
+
+  EXPECT_FALSE(cache()->Get(key1, {0, 0}, kFullRect));
+  cache()->Add(key1, MakeImage(100));
+  cache()->Add(key2, MakeImage(100));
+  EXPECT_EQ(2u, cache()->size());
+  EXPECT_EQ(2 * kImageBytes, cache()->total_bytes());
+
+  const Image* image = cache()->Get(key1, {0, 0}, kFullRect);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(100, image->bitmap->GetWidth());
+  EXPECT_TRUE(cache()->Get(key2, {0, 0}, kFullRect));
+  EXPECT_FALSE(cache()->Get(key2_with_cs, {0, 0}, kFullRect));
+  EXPECT_EQ(2u, cache()->hit_count());
+  EXPECT_EQ(2u, cache()->miss_count());
+
+  // Adding again replaces the image.
+  cache()->Add(key1, MakeImage(50));
+  EXPECT_EQ(2u, cache()->size());
+  image = cache()->Get(key1, {0, 0}, kFullRect);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(50, image->bitmap->GetWidth());
+}
+
+TEST_F(CPDFDecodedImageCacheTest, Downsampled) {
+  CPDF_TestDocument doc;
+  const Key key(&doc, MakeStream(), nullptr);
+
+  Image image = MakeImage(100);
+  image.downsampled = true;
+  cache()->Add(key, image);
+  EXPECT_TRUE(cache()->Get(key, {50, 50}, kFullRect));
+  EXPECT_TRUE(cache()->Get(key, {100, 100}, kFullRect));
+  EXPECT_FALSE(cache()->Get(key, {100, 200}, kFullRect));
+  EXPECT_FALSE(cache()->Get(key, {0, 0}, kFullRect));
+
+  // A full size image works for any size.
+  cache()->Add(key, MakeImage(100));
+  EXPECT_TRUE(cache()->Get(key, {100, 200}, kFullRect));
+  EXPECT_TRUE(cache()->Get(key, {0, 0}, kFullRect));
+}
+
+TEST_F(CPDFDecodedImageCacheTest, DecodedRect) {
+  CPDF_TestDocument doc;
+  const Key key(&doc, MakeStream(), nullptr);
+  EXPECT_FALSE(cache()->Contains(key));
+
+  Image image = MakeImage(100);
+  image.decoded_rect = CFX_FloatRect(0, 0.5f, 1, 1);
+  cache()->Add(key, image);
+  EXPECT_TRUE(cache()->Contains(key));
+  EXPECT_TRUE(cache()->Get(key, {0, 0}, CFX_FloatRect(0, 0.5f, 1, 1)));
+  EXPECT_TRUE(cache()->Get(key, {0, 0}, CFX_FloatRect(0.25f, 0.75f, 0.5f, 1)));
+  EXPECT_FALSE(cache()->Get(key, {0, 0}, CFX_FloatRect(0, 0.25f, 1, 1)));
+  EXPECT_FALSE(cache()->Get(key, {0, 0}, kFullRect));
+
+  // A fully decoded image works for any part.
+  cache()->Add(key, MakeImage(100));
+  EXPECT_TRUE(cache()->Get(key, {0, 0}, CFX_FloatRect(0, 0.25f, 1, 1)));
+  EXPECT_TRUE(cache()->Get(key, {0, 0}, kFullRect));
+}
+
+TEST_F(CPDFDecodedImageCacheTest, MaxBytes) {
+  CPDF_TestDocument doc;
+  auto stream1 = MakeStream();
+  auto stream2 = MakeStream();
+  auto stream3 = MakeStream();
+  const Key key1(&doc, stream1, nullptr);
+  const Key key2(&doc, stream2, nullptr);
+  const Key key3(&doc, stream3, nullptr);
+
+  cache()->SetMaxBytes(2 * kImageBytes);
+  cache()->Add(key1, MakeImage(100));
+  cache()->Add(key2, MakeImage(100));
+  EXPECT_TRUE(cache()->Get(key1, {0, 0}, kFullRect));
+
+  // `key2` is the least recently used.
+  cache()->Add(key3, MakeImage(100));
+  EXPECT_EQ(2u, cache()->size());
+  EXPECT_TRUE(cache()->Get(key1, {0, 0}, kFullRect));
+  EXPECT_FALSE(cache()->Get(key2, {0, 0}, kFullRect));
+  EXPECT_TRUE(cache()->Get(key3, {0, 0}, kFullRect));
+
+  cache()->Shrink(kImageBytes);
+  EXPECT_EQ(1u, cache()->size());
+  EXPECT_TRUE(cache()->Get(key3, {0, 0}, kFullRect));
+  EXPECT_EQ(2 * kImageBytes, cache()->max_bytes());
+
+  // An image that does not fit is not kept.
+  cache()->SetMaxBytes(kImageBytes - 1);
+  EXPECT_EQ(0u, cache()->size());
+  cache()->Add(key1, MakeImage(100));
+  EXPECT_EQ(0u, cache()->size());
+  EXPECT_EQ(0u, cache()->total_bytes());
+}
+
+TEST_F(CPDFDecodedImageCacheTest, ShrinkKeys) {
+  CPDF_TestDocument doc;
+  auto stream1 = MakeStream();
+  auto stream2 = MakeStream();
+  auto stream3 = MakeStream();
+  const Key key1(&doc, stream1, nullptr);
+  const Key key2(&doc, stream2, nullptr);
+  const Key key3(&doc, stream3, nullptr);
+  cache()->Add(key1, MakeImage(100));
+  cache()->Add(key2, MakeImage(100));
+  cache()->Add(key3, MakeImage(100));
+
+  // Only the least recently used of `key2` and `key3` goes, even though `key1`
+  // is older.
+  cache()->ShrinkKeys({key2, key3}, kImageBytes);
+  EXPECT_EQ(2u, cache()->size());
+  EXPECT_TRUE(cache()->Get(key1, {0, 0}, kFullRect));
+  EXPECT_FALSE(cache()->Get(key2, {0, 0}, kFullRect));
+  EXPECT_TRUE(cache()->Get(key3, {0, 0}, kFullRect));
+
+  cache()->ShrinkKeys({key1, key2, key3}, 0);
+  EXPECT_EQ(0u, cache()->size());
+  EXPECT_EQ(0u, cache()->total_bytes());
+}
+
+TEST_F(CPDFDecodedImageCacheTest, Remove) {
+  auto doc1 = std::make_unique<CPDF_TestDocument>();
+  auto doc2 = std::make_unique<CPDF_TestDocument>();
+  auto stream1 = MakeStream();
+  auto stream2 = MakeStream();
+  {
+    const Key key1(doc1.get(), stream1, nullptr);
+    const Key key1_with_cs(doc1.get(), stream1,
+                           pdfium::MakeRetain<CPDF_Name>(nullptr, "CS"));
+    const Key key2(doc1.get(), stream2, nullptr);
+    const Key key3(doc2.get(), stream1, nullptr);
+    cache()->Add(key1, MakeImage(100));
+    cache()->Add(key1_with_cs, MakeImage(100));
+    cache()->Add(key2, MakeImage(100));
+    cache()->Add(key3, MakeImage(100));
+    EXPECT_EQ(4u, cache()->size());
+
+    cache()->Remove(doc1.get(), stream1.Get());
+    EXPECT_EQ(2u, cache()->size());
+    EXPECT_EQ(2 * kImageBytes, cache()->total_bytes());
+    EXPECT_TRUE(cache()->Get(key2, {0, 0}, kFullRect));
+    EXPECT_TRUE(cache()->Get(key3, {0, 0}, kFullRect));
+  }
+
+  // Destroying a document drops its images.
+  doc2.reset();
+  EXPECT_EQ(1u, cache()->size());
+  doc1.reset();
+  EXPECT_EQ(0u, cache()->size());
+  EXPECT_EQ(0u, cache()->total_bytes());
+}
@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/page/cpdf_dib.h"
 
+#include <math.h>
 #include <stdint.h>
 
 #include <algorithm>
@@ -39,6 +40,7 @@
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/span_util.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxcrt/zip.h"
@@ -52,6 +54,29 @@ bool IsValidDimension(int value) {
   return value > 0 && value <= kMaxImageDimension;
 }
 
+// Rounds up, like the decoders do.
+int ReducedSize(int size, uint8_t resolution_levels_to_skip) {
+  return ((size - 1) >> resolution_levels_to_skip) + 1;
+}
+
+// Extra lines to decode around the needed part of an image, for resampling
+// that looks at neighboring lines.
+constexpr int kNeededLineMargin = 2;
+
+// Returns the first line of an image `height` lines high that is drawn within
+// `rect` of its unit square. Line 0 is at the top of the unit square.
+int GetFirstNeededLine(const CFX_FloatRect& rect, int height) {
+  int line = pdfium::saturated_cast<int>(floorf((1.0f - rect.top) * height));
+  return std::clamp(line - kNeededLineMargin, 0, height);
+}
+
+// Returns one past the last line of an image `height` lines high that is drawn
+// within `rect` of its unit square.
+int GetNeededLinesEnd(const CFX_FloatRect& rect, int height) {
+  int line = pdfium::saturated_cast<int>(ceilf((1.0f - rect.bottom) * height));
+  return std::clamp(line + kNeededLineMargin, 0, height);
+}
+
 unsigned int GetBits8(pdfium::span<const uint8_t> pData,
                       uint64_t bitpos,
                       size_t nbits) {
@@ -307,11 +332,13 @@ CPDF_DIB::LoadState CPDF_DIB::StartLoadDIBBase(
     bool bStdCS,
     CPDF_ColorSpace::Family GroupFamily,
     bool bLoadMask,
-    const CFX_Size& max_size_required) {
+    const CFX_Size& max_size_required,
+    const CFX_FloatRect& needed_rect) {
   std_cs_ = bStdCS;
   has_mask_ = bHasMask;
   group_family_ = GroupFamily;
   load_mask_ = bLoadMask;
+  decoded_rect_ = needed_rect;
 
   if (!stream_->IsInline()) {
     pFormResources = nullptr;
@@ -333,6 +360,10 @@ CPDF_DIB::LoadState CPDF_DIB::StartLoadDIBBase(
     return LoadState::kFail;
   }
 
+  // Only convert the lines that get drawn. Decoders stop after the last one.
+  first_needed_line_ = GetFirstNeededLine(needed_rect, GetHeight());
+  needed_lines_end_ = GetNeededLinesEnd(needed_rect, GetHeight());
+
   if (!ContinueToLoadMask()) {
     return LoadState::kFail;
   }
@@ -590,6 +621,7 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
 
   pdfium::span<const uint8_t> src_span = stream_acc_->GetSpan();
   RetainPtr<const CPDF_Dictionary> pParams = stream_acc_->GetImageParam();
+  uint8_t resolution_levels_skipped = 0;
   if (decoder == "CCITTFaxDecode") {
     decoder_ = CreateFaxDecoder(src_span, GetWidth(), GetHeight(), pParams);
   } else if (decoder == "FlateDecode") {
@@ -599,7 +631,9 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
     decoder_ = BasicModule::CreateRunLengthDecoder(
         src_span, GetWidth(), GetHeight(), components_, bpc_);
   } else if (decoder == "DCTDecode") {
-    if (!CreateDCTDecoder(src_span, pParams)) {
+    resolution_levels_skipped = std::min(
+        resolution_levels_to_skip, JpegModule::kMaxResolutionLevelsToSkip);
+    if (!CreateDCTDecoder(src_span, pParams, resolution_levels_skipped)) {
       return LoadState::kFail;
     }
   }
@@ -607,6 +641,27 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
     return LoadState::kFail;
   }
 
+  if ((decoder == "FlateDecode" || decoder == "RunLengthDecode") &&
+      resolution_levels_to_skip > 1 && !image_mask_ &&
+      bpc_ * components_ % 8 == 0) {
+    // These decoders can only produce full size lines, so skip lines and
+    // pixels instead, which still saves unpacking, converting and caching
+    // them. Skipping drops pixels that the stretcher would have averaged in,
+    // so keep twice the size needed for it to average. Bilevel and other
+    // packed data is not skipped, as thin lines would drop out.
+    resolution_levels_skipped = resolution_levels_to_skip - 1;
+    decoder_ = BasicModule::CreateReducedDecoder(std::move(decoder_),
+                                                 resolution_levels_skipped);
+    if (!decoder_) {
+      return LoadState::kFail;
+    }
+  }
+  if (resolution_levels_skipped > 0) {
+    SetWidth(ReducedSize(GetWidth(), resolution_levels_skipped));
+    SetHeight(ReducedSize(GetHeight(), resolution_levels_skipped));
+    downsampled_ = true;
+  }
+
   const std::optional<uint32_t> requested_pitch =
       fxge::CalculatePitch8(bpc_, components_, GetWidth());
   if (!requested_pitch.has_value()) {
@@ -624,10 +679,12 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
 }
 
 bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
-                                const CPDF_Dictionary* pParams) {
+                                const CPDF_Dictionary* pParams,
+                                uint8_t resolution_levels_to_skip) {
   decoder_ = JpegModule::CreateDecoder(
       src_span, GetWidth(), GetHeight(), components_,
-      !pParams || pParams->GetIntegerFor("ColorTransform", 1));
+      !pParams || pParams->GetIntegerFor("ColorTransform", 1),
+      resolution_levels_to_skip);
   if (decoder_) {
     return true;
   }
@@ -650,7 +707,8 @@ bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
   if (components_ == static_cast<uint32_t>(info.num_components)) {
     bpc_ = info.bits_per_components;
     decoder_ = JpegModule::CreateDecoder(src_span, GetWidth(), GetHeight(),
-                                         components_, info.color_transform);
+                                         components_, info.color_transform,
+                                         resolution_levels_to_skip);
     return true;
   }
 
@@ -700,7 +758,8 @@ bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
 
   bpc_ = info.bits_per_components;
   decoder_ = JpegModule::CreateDecoder(src_span, GetWidth(), GetHeight(),
-                                       components_, info.color_transform);
+                                       components_, info.color_transform,
+                                       resolution_levels_to_skip);
   return true;
 }
 
@@ -715,13 +774,29 @@ RetainPtr<CFX_DIBitmap> CPDF_DIB::LoadJpxBitmap(
   }
 
   SetWidth(GetWidth() >> resolution_levels_to_skip);
-  SetHeight(GetHeight() >> resolution_levels_to_skip);
+  const int full_height = GetHeight();
+  SetHeight(full_height >> resolution_levels_to_skip);
+  downsampled_ = resolution_levels_to_skip > 0;
+
+  // Stop decoding after the last line that gets drawn. The lines below it are
+  // left blank.
+  const int64_t needed_lines_end =
+      static_cast<int64_t>(GetNeededLinesEnd(decoded_rect_, GetHeight()))
+      << resolution_levels_to_skip;
+  const bool decode_partially = needed_lines_end < full_height;
+  if (decode_partially) {
+    decoder->SetDecodeHeight(static_cast<uint32_t>(needed_lines_end));
+  }
 
   if (!decoder->StartDecode()) {
     return nullptr;
   }
 
   CJPX_Decoder::JpxImageInfo image_info = decoder->GetInfo();
+  if (decode_partially) {
+    image_info.height =
+        std::max(image_info.height, static_cast<uint32_t>(GetHeight()));
+  }
   if (static_cast<int>(image_info.width) < GetWidth() ||
       static_cast<int>(image_info.height) < GetHeight()) {
     return nullptr;
@@ -976,7 +1051,8 @@ CPDF_DIB::LoadState CPDF_DIB::StartLoadMaskDIB(
   mask_ = pdfium::MakeRetain<CPDF_DIB>(document_, std::move(mask_stream));
   LoadState ret =
       mask_->StartLoadDIBBase(false, nullptr, nullptr, true,
-                              CPDF_ColorSpace::Family::kUnknown, false, {0, 0});
+                              CPDF_ColorSpace::Family::kUnknown, false, {0, 0},
+                              decoded_rect_);
   if (ret == LoadState::kContinue) {
     if (status_ == LoadState::kFail) {
       status_ = LoadState::kContinue;
@@ -1242,7 +1318,9 @@ pdfium::span<const uint8_t> CPDF_DIB::GetScanline(int line) const {
   DataVector<uint8_t> temp_buffer;
   pdfium::span<const uint8_t> pSrcLine;
 
-  if (cached_bitmap_ && src_pitch_value <= cached_bitmap_->GetPitch()) {
+  if (!IsNeededLine(line)) {
+    // Leave `pSrcLine` empty to return a blank line.
+  } else if (cached_bitmap_ && src_pitch_value <= cached_bitmap_->GetPitch()) {
     if (line >= cached_bitmap_->GetHeight()) {
       line = cached_bitmap_->GetHeight() - 1;
     }
@@ -1375,7 +1453,12 @@ pdfium::span<const uint8_t> CPDF_DIB::GetScanline(int line) const {
 }
 
 bool CPDF_DIB::SkipToScanline(int line, PauseIndicatorIface* pPause) const {
-  return decoder_ && decoder_->SkipToScanline(line, pPause);
+  return decoder_ && IsNeededLine(line) &&
+         decoder_->SkipToScanline(line, pPause);
+}
+
+bool CPDF_DIB::IsNeededLine(int line) const {
+  return line >= first_needed_line_ && line < needed_lines_end_;
 }
 
 size_t CPDF_DIB::GetEstimatedImageMemoryBurden() const {
@@ -9,11 +9,13 @@
 
 #include <stdint.h>
 
+#include <limits>
 #include <memory>
 #include <vector>
 
 #include "core/fpdfapi/page/cpdf_colorspace.h"
 #include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
@@ -53,6 +55,14 @@ class CPDF_DIB final : public CFX_DIBBase {
   uint32_t GetMatteColor() const { return matte_color_; }
   bool IsJBigImage() const;
 
+  // Whether the image was decoded at less than its full size, because of the
+  // `max_size_required` passed to StartLoadDIBBase().
+  bool IsDownsampled() const { return downsampled_; }
+
+  // The part of the image's unit square that was decoded, as passed to
+  // StartLoadDIBBase(). Lines outside of it are blank.
+  const CFX_FloatRect& GetDecodedRect() const { return decoded_rect_; }
+
   bool Load();
   LoadState StartLoadDIBBase(bool bHasMask,
                              const CPDF_Dictionary* pFormResources,
@@ -60,7 +70,8 @@ class CPDF_DIB final : public CFX_DIBBase {
                              bool bStdCS,
                              CPDF_ColorSpace::Family GroupFamily,
                              bool bLoadMask,
-                             const CFX_Size& max_size_required);
+                             const CFX_Size& max_size_required,
+                             const CFX_FloatRect& needed_rect);
   LoadState ContinueLoadDIBBase(PauseIndicatorIface* pPause);
   RetainPtr<CPDF_DIB> DetachMask();
 
@@ -91,7 +102,8 @@ class CPDF_DIB final : public CFX_DIBBase {
   void LoadPalette();
   LoadState CreateDecoder(uint8_t resolution_levels_to_skip);
   bool CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
-                        const CPDF_Dictionary* pParams);
+                        const CPDF_Dictionary* pParams,
+                        uint8_t resolution_levels_to_skip);
   void TranslateScanline24bpp(pdfium::span<uint8_t> dest_scan,
                               pdfium::span<const uint8_t> src_scan) const;
   bool TranslateScanline24bppDefaultDecode(
@@ -101,6 +113,7 @@ class CPDF_DIB final : public CFX_DIBBase {
   bool TransMask() const;
   void SetMaskProperties();
 
+  bool IsNeededLine(int line) const;
   uint32_t Get1BitSetValue() const;
   uint32_t Get1BitResetValue() const;
 
@@ -123,6 +136,10 @@ class CPDF_DIB final : public CFX_DIBBase {
   bool color_key_ = false;
   bool has_mask_ = false;
   bool std_cs_ = false;
+  bool downsampled_ = false;
+  CFX_FloatRect decoded_rect_{0, 0, 1, 1};
+  int first_needed_line_ = 0;
+  int needed_lines_end_ = std::numeric_limits<int>::max();
   std::vector<DIB_COMP_DATA> comp_data_;
   mutable DataVector<uint8_t> line_buf_;
   mutable DataVector<uint8_t> mask_buf_;
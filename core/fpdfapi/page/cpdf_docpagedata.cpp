@@ -17,11 +17,13 @@
 #include "constants/font_encodings.h"
 #include "core/fpdfapi/font/cpdf_fontglobals.h"
 #include "core/fpdfapi/font/cpdf_type1font.h"
+#include "core/fpdfapi/page/cpdf_decodedimagecache.h"
 #include "core/fpdfapi/page/cpdf_form.h"
 #include "core/fpdfapi/page/cpdf_iccprofile.h"
 #include "core/fpdfapi/page/cpdf_image.h"
 #include "core/fpdfapi/page/cpdf_pattern.h"
 #include "core/fpdfapi/page/cpdf_shadingpattern.h"
+#include "core/fpdfapi/page/cpdf_sharedform.h"
 #include "core/fpdfapi/page/cpdf_tilingpattern.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
@@ -185,6 +187,11 @@ CPDF_DocPageData::~CPDF_DocPageData() {
   for (auto& it : font_map_) {
     it.second->WillBeDestroyed();
   }
+  for (auto& it : shared_form_map_) {
+    for (auto& form : it.second) {
+      form->WillBeDestroyed();
+    }
+  }
 }
 
 CPDF_DocPageData::HashIccProfileKey::HashIccProfileKey(
@@ -209,6 +216,10 @@ void CPDF_DocPageData::ClearStockFont() {
   CPDF_FontGlobals::GetInstance()->Clear(GetDocument());
 }
 
+void CPDF_DocPageData::ClearDecodedImages() {
+  CPDF_DecodedImageCache::GetInstance()->ClearDocument(GetDocument());
+}
+
 RetainPtr<CPDF_Font> CPDF_DocPageData::GetFont(
     RetainPtr<CPDF_Dictionary> pFontDict) {
   if (!pFontDict) {
@@ -522,6 +533,44 @@ void CPDF_DocPageData::MaybePurgeFontFileStreamAcc(
   }
 }
 
+RetainPtr<CPDF_SharedForm> CPDF_DocPageData::GetSharedForm(
+    RetainPtr<CPDF_Dictionary> page_resources,
+    RetainPtr<CPDF_Stream> form_stream,
+    RetainPtr<CPDF_Dictionary> parent_resources,
+    const CPDF_AllStates& states,
+    CPDF_Form::RecursionState* recursion_state) {
+  auto it = shared_form_map_.find(form_stream);
+  if (it != shared_form_map_.end()) {
+    for (const auto& form : it->second) {
+      if (form->Matches(page_resources.Get(), parent_resources.Get(),
+                        states)) {
+        return pdfium::WrapRetain(form.Get());
+      }
+    }
+  }
+
+  auto form = pdfium::MakeRetain<CPDF_SharedForm>(
+      GetDocument(), std::move(page_resources), std::move(form_stream),
+      std::move(parent_resources), states, recursion_state);
+  form->SetPageData(this);
+  // Parsing may have added to `shared_form_map_`, so look up the entry again.
+  shared_form_map_[form->form()->GetStream()].emplace_back(form.Get());
+  return form;
+}
+
+void CPDF_DocPageData::MaybePurgeSharedForm(const CPDF_SharedForm* form) {
+  auto it = shared_form_map_.find(form->form()->GetStream());
+  if (it == shared_form_map_.end()) {
+    return;
+  }
+  std::erase_if(it->second, [form](const ObservedPtr<CPDF_SharedForm>& entry) {
+    return !entry || entry.Get() == form;
+  });
+  if (it->second.empty()) {
+    shared_form_map_.erase(it);
+  }
+}
+
 std::unique_ptr<CPDF_Font::FormIface> CPDF_DocPageData::CreateForm(
     CPDF_Document* pDocument,
     RetainPtr<CPDF_Dictionary> pPageResources,
@@ -10,23 +10,28 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fpdfapi/page/cpdf_form.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_codepage_forward.h"
 #include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 
 class CFX_Font;
+class CPDF_AllStates;
 class CPDF_Dictionary;
 class CPDF_FontEncoding;
 class CPDF_IccProfile;
 class CPDF_Image;
 class CPDF_Object;
 class CPDF_Pattern;
+class CPDF_SharedForm;
 class CPDF_Stream;
 class CPDF_StreamAcc;
 
@@ -40,6 +45,7 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
 
   // CPDF_Document::PageDataIface:
   void ClearStockFont() override;
+  void ClearDecodedImages() override;
   RetainPtr<CPDF_StreamAcc> GetFontFileStreamAcc(
       RetainPtr<const CPDF_Stream> pFontStream) override;
   void MaybePurgeFontFileStreamAcc(
@@ -87,6 +93,23 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
   RetainPtr<CPDF_IccProfile> GetIccProfile(
       RetainPtr<const CPDF_Stream> pProfileStream);
 
+  // Returns `form_stream` parsed as drawn with these resources and inherited
+  // `states`. Reuses the parsed form of an earlier use that matches, see
+  // CPDF_SharedForm::Matches(), for as long as one of them is still alive.
+  RetainPtr<CPDF_SharedForm> GetSharedForm(
+      RetainPtr<CPDF_Dictionary> page_resources,
+      RetainPtr<CPDF_Stream> form_stream,
+      RetainPtr<CPDF_Dictionary> parent_resources,
+      const CPDF_AllStates& states,
+      CPDF_Form::RecursionState* recursion_state);
+  // Forgets `form`, which is being destroyed, and its stream once no other
+  // form parsed from it is left.
+  void MaybePurgeSharedForm(const CPDF_SharedForm* form);
+
+  size_t GetSharedFormStreamCountForTesting() const {
+    return shared_form_map_.size();
+  }
+
  private:
   struct HashIccProfileKey {
     HashIccProfileKey(DataVector<uint8_t> digest, uint32_t components);
@@ -131,6 +154,9 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
   std::map<RetainPtr<const CPDF_Object>, RetainPtr<CPDF_Pattern>> pattern_map_;
   std::map<uint32_t, RetainPtr<CPDF_Image>> image_map_;
   std::map<RetainPtr<const CPDF_Dictionary>, RetainPtr<CPDF_Font>> font_map_;
+  std::map<RetainPtr<const CPDF_Stream>,
+           std::vector<ObservedPtr<CPDF_SharedForm>>>
+      shared_form_map_;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
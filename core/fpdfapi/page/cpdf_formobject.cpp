@@ -9,10 +9,18 @@
 #include <utility>
 
 #include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_sharedform.h"
 
 CPDF_FormObject::CPDF_FormObject(int32_t content_stream,
                                  std::unique_ptr<CPDF_Form> pForm,
                                  const CFX_Matrix& matrix)
+    : CPDF_FormObject(content_stream,
+                      pdfium::MakeRetain<CPDF_SharedForm>(std::move(pForm)),
+                      matrix) {}
+
+CPDF_FormObject::CPDF_FormObject(int32_t content_stream,
+                                 RetainPtr<CPDF_SharedForm> pForm,
+                                 const CFX_Matrix& matrix)
     : CPDF_PageObject(content_stream),
       form_(std::move(pForm)),
       form_matrix_(matrix) {}
@@ -37,12 +45,24 @@ const CPDF_FormObject* CPDF_FormObject::AsForm() const {
   return this;
 }
 
+const CPDF_Form* CPDF_FormObject::form() const {
+  return form_->form();
+}
+
+CPDF_Form* CPDF_FormObject::mutable_form() {
+  if (!form_->HasOneRef()) {
+    form_ = form_->ParsePrivateCopy();
+  }
+  form_->StopSharing();
+  return form_->mutable_form();
+}
+
 CPDF_PageObject::Type CPDF_FormObject::GetType() const {
   return Type::kForm;
 }
 
 void CPDF_FormObject::CalcBoundingBox() {
-  SetRect(form_matrix_.TransformRect(form_->CalcBoundingBox()));
+  SetRect(form_matrix_.TransformRect(form()->CalcBoundingBox()));
 }
 
 void CPDF_FormObject::SetFormMatrix(const CFX_Matrix& matrix) {
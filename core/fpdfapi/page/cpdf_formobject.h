@@ -11,14 +11,19 @@
 
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
 
 class CPDF_Form;
+class CPDF_SharedForm;
 
 class CPDF_FormObject final : public CPDF_PageObject {
  public:
   CPDF_FormObject(int32_t content_stream,
                   std::unique_ptr<CPDF_Form> pForm,
                   const CFX_Matrix& matrix);
+  CPDF_FormObject(int32_t content_stream,
+                  RetainPtr<CPDF_SharedForm> pForm,
+                  const CFX_Matrix& matrix);
   ~CPDF_FormObject() override;
 
   // CPDF_PageObject:
@@ -29,12 +34,15 @@ class CPDF_FormObject final : public CPDF_PageObject {
   const CPDF_FormObject* AsForm() const override;
 
   void CalcBoundingBox();
-  const CPDF_Form* form() const { return form_.get(); }
+  const CPDF_Form* form() const;
+  // The form may be shared with other CPDF_FormObjects drawing the same
+  // stream. Use this to get one that can be changed.
+  CPDF_Form* mutable_form();
   const CFX_Matrix& form_matrix() const { return form_matrix_; }
   void SetFormMatrix(const CFX_Matrix& matrix);
 
  private:
-  std::unique_ptr<CPDF_Form> const form_;
+  RetainPtr<CPDF_SharedForm> form_;
   CFX_Matrix form_matrix_;
 };
 
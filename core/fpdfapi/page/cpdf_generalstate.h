@@ -30,6 +30,11 @@ class CPDF_GeneralState {
   void Emplace() { ref_.Emplace(); }
   bool HasRef() const { return !!ref_; }
 
+  // True if both refer to the same data, which implies equal values.
+  bool SharesDataWith(const CPDF_GeneralState& that) const {
+    return ref_ == that.ref_;
+  }
+
   void SetRenderIntent(const ByteString& ri);
 
   ByteString GetBlendMode() const;
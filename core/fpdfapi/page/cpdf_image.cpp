@@ -362,11 +362,13 @@ bool CPDF_Image::StartLoadDIBBase(const CPDF_Dictionary* pFormResource,
                                   bool bStdCS,
                                   CPDF_ColorSpace::Family GroupFamily,
                                   bool bLoadMask,
-                                  const CFX_Size& max_size_required) {
+                                  const CFX_Size& max_size_required,
+                                  const CFX_FloatRect& needed_rect) {
   RetainPtr<CPDF_DIB> source = CreateNewDIB();
   CPDF_DIB::LoadState ret =
       source->StartLoadDIBBase(true, pFormResource, pPageResource, bStdCS,
-                               GroupFamily, bLoadMask, max_size_required);
+                               GroupFamily, bLoadMask, max_size_required,
+                               needed_rect);
   if (ret == CPDF_DIB::LoadState::kFail) {
     dibbase_.Reset();
     return false;
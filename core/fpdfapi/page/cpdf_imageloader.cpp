@@ -27,18 +27,19 @@ bool CPDF_ImageLoader::Start(const CPDF_ImageObject* pImage,
                              bool bStdCS,
                              CPDF_ColorSpace::Family eFamily,
                              bool bLoadMask,
-                             const CFX_Size& max_size_required) {
+                             const CFX_Size& max_size_required,
+                             const CFX_FloatRect& needed_rect) {
   cache_ = pPageImageCache;
   image_object_ = pImage;
   bool should_continue;
   if (cache_) {
     should_continue = cache_->StartGetCachedBitmap(
         image_object_->GetImage(), pFormResource, pPageResource, bStdCS,
-        eFamily, bLoadMask, max_size_required);
+        eFamily, bLoadMask, max_size_required, needed_rect);
   } else {
     should_continue = image_object_->GetImage()->StartLoadDIBBase(
         pFormResource, pPageResource, bStdCS, eFamily, bLoadMask,
-        max_size_required);
+        max_size_required, needed_rect);
   }
   if (!should_continue) {
     Finish();
@@ -30,7 +30,8 @@ class CPDF_ImageLoader {
              bool bStdCS,
              CPDF_ColorSpace::Family eFamily,
              bool bLoadMask,
-             const CFX_Size& max_size_required);
+             const CFX_Size& max_size_required,
+             const CFX_FloatRect& needed_rect);
   bool Continue(PauseIndicatorIface* pPause);
 
   RetainPtr<CFX_DIBBase> TranslateImage(
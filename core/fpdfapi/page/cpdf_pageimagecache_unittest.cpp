@@ -58,7 +58,8 @@ TEST(CPDFPageImageCache, RenderBug1924) {
     // Render with small scale.
     bool should_continue = page_image_cache->StartGetCachedBitmap(
         image->GetImage(), nullptr, page->GetMutablePageResources(), true,
-        CPDF_ColorSpace::Family::kICCBased, false, {50, 50});
+        CPDF_ColorSpace::Family::kICCBased, false, {50, 50},
+        CFX_FloatRect(0, 0, 1, 1));
     while (should_continue) {
       should_continue = page_image_cache->Continue(nullptr);
     }
@@ -68,7 +69,8 @@ TEST(CPDFPageImageCache, RenderBug1924) {
     // And render with large scale.
     should_continue = page_image_cache->StartGetCachedBitmap(
         image->GetImage(), nullptr, page->GetMutablePageResources(), true,
-        CPDF_ColorSpace::Family::kICCBased, false, {100, 100});
+        CPDF_ColorSpace::Family::kICCBased, false, {100, 100},
+        CFX_FloatRect(0, 0, 1, 1));
     while (should_continue) {
       should_continue = page_image_cache->Continue(nullptr);
     }
@@ -8,6 +8,7 @@
 
 #include "core/fpdfapi/font/cpdf_fontglobals.h"
 #include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fpdfapi/page/cpdf_decodedimagecache.h"
 #include "core/fpdfapi/page/cpdf_streamcontentparser.h"
 
 namespace pdfium {
@@ -17,12 +18,27 @@ void InitializePageModule() {
   CPDF_FontGlobals::Create();
   CPDF_FontGlobals::GetInstance()->LoadEmbeddedMaps();
   CPDF_StreamContentParser::InitializeGlobals();
+  CPDF_DecodedImageCache::Create();
 }
 
 void DestroyPageModule() {
+  CPDF_DecodedImageCache::Destroy();
   CPDF_StreamContentParser::DestroyGlobals();
   CPDF_FontGlobals::Destroy();
   CPDF_ColorSpace::DestroyGlobals();
 }
 
+void InitializePageModuleForThread() {
+  CPDF_ColorSpace::InitializeGlobalsForThread();
+  CPDF_FontGlobals::CreateForThread();
+  CPDF_FontGlobals::GetInstance()->LoadEmbeddedMaps();
+  CPDF_DecodedImageCache::CreateForThread();
+}
+
+void DestroyPageModuleForThread() {
+  CPDF_DecodedImageCache::DestroyForThread();
+  CPDF_FontGlobals::DestroyForThread();
+  CPDF_ColorSpace::DestroyGlobalsForThread();
+}
+
 }  // namespace pdfium
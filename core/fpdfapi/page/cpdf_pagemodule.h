@@ -15,6 +15,12 @@ void InitializePageModule();
 // Tears down the page module.
 void DestroyPageModule();
 
+// Gives the calling thread its own copy of the page module state that is not
+// safe to share between threads.
+void InitializePageModuleForThread();
+
+void DestroyPageModuleForThread();
+
 }  // namespace pdfium
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEMODULE_H_
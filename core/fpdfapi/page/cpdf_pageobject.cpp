@@ -8,6 +8,7 @@
 
 #include <utility>
 
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fxcrt/fx_coordinates.h"
 
 CPDF_PageObject::CPDF_PageObject(int32_t content_stream)
@@ -86,7 +87,7 @@ void CPDF_PageObject::SetDefaultStates() {
 
 void CPDF_PageObject::CopyData(const CPDF_PageObject* pSrc) {
   graphic_states_ = pSrc->graphic_states_;
-  rect_ = pSrc->rect_;
+  SetRect(pSrc->rect_);
   dirty_ = true;
 }
 
@@ -101,6 +102,13 @@ void CPDF_PageObject::SetIsActive(bool value) {
   }
 }
 
+void CPDF_PageObject::SetRect(const CFX_FloatRect& rect) {
+  rect_ = rect;
+  if (holder_) {
+    holder_->OnPageObjectRectChanged();
+  }
+}
+
 void CPDF_PageObject::TransformClipPath(const CFX_Matrix& matrix) {
   CPDF_ClipPath& clip_path = mutable_clip_path();
   if (!clip_path.HasRef()) {
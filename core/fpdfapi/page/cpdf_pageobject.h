@@ -14,9 +14,11 @@
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_FormObject;
 class CPDF_ImageObject;
+class CPDF_PageObjectHolder;
 class CPDF_PathObject;
 class CPDF_ShadingObject;
 class CPDF_TextObject;
@@ -69,7 +71,7 @@ class CPDF_PageObject {
 
   void SetOriginalRect(const CFX_FloatRect& rect) { original_rect_ = rect; }
   const CFX_FloatRect& GetOriginalRect() const { return original_rect_; }
-  void SetRect(const CFX_FloatRect& rect) { rect_ = rect; }
+  void SetRect(const CFX_FloatRect& rect);
   const CFX_FloatRect& GetRect() const { return rect_; }
   FX_RECT GetBBox() const;
   FX_RECT GetTransformedBBox(const CFX_Matrix& matrix) const;
@@ -138,11 +140,15 @@ class CPDF_PageObject {
 
   const CFX_Matrix& original_matrix() const { return original_matrix_; }
 
+  // Set by the holder that this object is in, which SetRect() notifies.
+  void SetHolder(CPDF_PageObjectHolder* holder) { holder_ = holder; }
+
  protected:
   void CopyData(const CPDF_PageObject* pSrcObject);
   void InitializeOriginalMatrix(const CFX_Matrix& matrix);
 
  private:
+  UnownedPtr<CPDF_PageObjectHolder> holder_;
   CPDF_GraphicStates graphic_states_;
   CFX_FloatRect rect_;
   CFX_FloatRect original_rect_;
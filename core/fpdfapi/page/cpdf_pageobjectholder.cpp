@@ -13,6 +13,7 @@
 #include "core/fpdfapi/page/cpdf_allstates.h"
 #include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/check.h"
@@ -21,6 +22,13 @@
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/stl_util.h"
 
+namespace {
+
+// Below this, checking the rects of all the page objects is cheap enough.
+constexpr size_t kMinPageObjectsForIndex = 256;
+
+}  // namespace
+
 bool GraphicsData::operator<(const GraphicsData& other) const {
   if (!FXSYS_SafeEQ(fillAlpha, other.fillAlpha)) {
     return FXSYS_SafeLT(fillAlpha, other.fillAlpha);
@@ -186,7 +194,9 @@ CPDF_PageObject* CPDF_PageObjectHolder::GetPageObjectByIndex(
 void CPDF_PageObjectHolder::AppendPageObject(
     std::unique_ptr<CPDF_PageObject> pPageObj) {
   CHECK(pPageObj);
+  pPageObj->SetHolder(this);
   page_object_list_.push_back(std::move(pPageObj));
+  page_object_index_.reset();
 }
 
 std::unique_ptr<CPDF_PageObject> CPDF_PageObjectHolder::RemovePageObject(
@@ -199,6 +209,8 @@ std::unique_ptr<CPDF_PageObject> CPDF_PageObjectHolder::RemovePageObject(
 
   std::unique_ptr<CPDF_PageObject> result = std::move(*it);
   page_object_list_.erase(it);
+  page_object_index_.reset();
+  result->SetHolder(nullptr);
 
   int32_t content_stream = pPageObj->GetContentStream();
   if (content_stream >= 0) {
@@ -214,5 +226,32 @@ bool CPDF_PageObjectHolder::ErasePageObjectAtIndex(size_t index) {
   }
 
   page_object_list_.erase(page_object_list_.begin() + index);
+  page_object_index_.reset();
   return true;
 }
+
+std::optional<std::vector<size_t>>
+CPDF_PageObjectHolder::GetPageObjectIndicesInRect(
+    const CFX_FloatRect& rect) const {
+  if (page_object_list_.size() < kMinPageObjectsForIndex ||
+      parse_state_ != ParseState::kParsed) {
+    return std::nullopt;
+  }
+
+  if (!page_object_index_) {
+    std::vector<CFX_FloatRect> rects;
+    rects.reserve(page_object_list_.size());
+    for (const auto& page_object : page_object_list_) {
+      rects.push_back(page_object->GetRect());
+    }
+    page_object_index_ = std::make_unique<CPDF_PageObjectIndex>(rects);
+  }
+  if (page_object_index_->Covers(rect)) {
+    return std::nullopt;
+  }
+  return page_object_index_->Query(rect);
+}
+
+void CPDF_PageObjectHolder::OnPageObjectRectChanged() {
+  page_object_index_.reset();
+}
@@ -29,6 +29,7 @@
 class CPDF_ContentParser;
 class CPDF_Document;
 class CPDF_PageObject;
+class CPDF_PageObjectIndex;
 class PauseIndicatorIface;
 
 // These structs are used to keep track of resources that have already been
@@ -103,6 +104,16 @@ class CPDF_PageObjectHolder {
   std::unique_ptr<CPDF_PageObject> RemovePageObject(CPDF_PageObject* pPageObj);
   bool ErasePageObjectAtIndex(size_t index);
 
+  // Returns the indices, in ascending order, of the page objects whose rects
+  // may intersect `rect`, using a spatial index that is built on first use.
+  // Returns std::nullopt when that would not save checking every object, e.g.
+  // for few objects, while parsing, or when `rect` covers all of them.
+  std::optional<std::vector<size_t>> GetPageObjectIndicesInRect(
+      const CFX_FloatRect& rect) const;
+
+  // Called by the page objects in this holder when their rects change.
+  void OnPageObjectRectChanged();
+
   iterator begin() { return page_object_list_.begin(); }
   const_iterator begin() const { return page_object_list_.begin(); }
 
@@ -160,6 +171,10 @@ class CPDF_PageObjectHolder {
   std::unique_ptr<CPDF_ContentParser> parser_;
   std::deque<std::unique_ptr<CPDF_PageObject>> page_object_list_;
 
+  // Built lazily from the rects in `page_object_list_`, and reset whenever the
+  // list or one of the rects changes.
+  mutable std::unique_ptr<CPDF_PageObjectIndex> page_object_index_;
+
   CTMMap all_ctms_;
 
   // The indexes of Content streams that are dirty and need to be regenerated.
@@ -0,0 +1,168 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "core/fxcrt/check_op.h"
+
+namespace {
+
+// Aim for about this many objects per cell.
+constexpr size_t kObjectsPerCell = 4;
+
+// Limits the grid size, and so its memory use, for huge pages.
+constexpr size_t kMaxCellsPerSide = 256;
+
+// Objects that span more cells than this are kept out of the grid, so that a
+// few huge objects do not blow up its size.
+constexpr size_t kMaxCellsPerObject = 64;
+
+bool IsValidRect(const CFX_FloatRect& rect) {
+  return isfinite(rect.left) && isfinite(rect.right) && isfinite(rect.bottom) &&
+         isfinite(rect.top) && rect.left <= rect.right &&
+         rect.bottom <= rect.top;
+}
+
+}  // namespace
+
+CPDF_PageObjectIndex::CPDF_PageObjectIndex(
+    pdfium::span<const CFX_FloatRect> rects)
+    : object_count_(rects.size()) {
+  CHECK_LE(object_count_, std::numeric_limits<uint32_t>::max());
+
+  size_t valid_count = 0;
+  for (const CFX_FloatRect& rect : rects) {
+    if (!IsValidRect(rect)) {
+      continue;
+    }
+    if (valid_count) {
+      bounds_.Union(rect);
+    } else {
+      bounds_ = rect;
+    }
+    ++valid_count;
+  }
+  if (!valid_count) {
+    large_objects_.resize(rects.size());
+    std::iota(large_objects_.begin(), large_objects_.end(), 0u);
+    return;
+  }
+
+  const size_t side = std::clamp<size_t>(
+      static_cast<size_t>(ceil(sqrt(valid_count / kObjectsPerCell))), 1,
+      kMaxCellsPerSide);
+  cols_ = side;
+  rows_ = side;
+  if (bounds_.Width() > 0) {
+    cols_per_unit_ = cols_ / bounds_.Width();
+  }
+  if (bounds_.Height() > 0) {
+    rows_per_unit_ = rows_ / bounds_.Height();
+  }
+
+  // Count the objects in each cell first, so that `cell_objects_` can be
+  // filled in one pass without per-cell vectors.
+  std::vector<uint32_t> counts(cols_ * rows_ + 1);
+  std::vector<bool> in_grid(rects.size());
+  for (size_t i = 0; i < rects.size(); ++i) {
+    if (!IsValidRect(rects[i])) {
+      continue;
+    }
+    const CellRange range = GetCellRange(rects[i]);
+    const size_t cells = (range.last_col - range.first_col + 1) *
+                         (range.last_row - range.first_row + 1);
+    if (cells > kMaxCellsPerObject) {
+      continue;
+    }
+    in_grid[i] = true;
+    for (size_t row = range.first_row; row <= range.last_row; ++row) {
+      for (size_t col = range.first_col; col <= range.last_col; ++col) {
+        ++counts[row * cols_ + col + 1];
+      }
+    }
+  }
+  std::partial_sum(counts.begin(), counts.end(), counts.begin());
+  cell_objects_.resize(counts.back());
+  cell_starts_ = counts;
+
+  for (size_t i = 0; i < rects.size(); ++i) {
+    if (!in_grid[i]) {
+      large_objects_.push_back(static_cast<uint32_t>(i));
+      continue;
+    }
+    const CellRange range = GetCellRange(rects[i]);
+    for (size_t row = range.first_row; row <= range.last_row; ++row) {
+      for (size_t col = range.first_col; col <= range.last_col; ++col) {
+        cell_objects_[counts[row * cols_ + col]++] = static_cast<uint32_t>(i);
+      }
+    }
+  }
+}
+
+CPDF_PageObjectIndex::~CPDF_PageObjectIndex() = default;
+
+bool CPDF_PageObjectIndex::Covers(const CFX_FloatRect& rect) const {
+  if (!cols_ || !IsValidRect(rect)) {
+    return true;
+  }
+  return rect.left <= bounds_.left && rect.right >= bounds_.right &&
+         rect.bottom <= bounds_.bottom && rect.top >= bounds_.top;
+}
+
+std::vector<size_t> CPDF_PageObjectIndex::Query(
+    const CFX_FloatRect& rect) const {
+  std::vector<size_t> result;
+  if (!cols_ || !IsValidRect(rect)) {
+    // Callers compare the rects of the objects with `rect`, and every object
+    // passes those comparisons when `rect` has NaNs in it.
+    result.resize(object_count_);
+    std::iota(result.begin(), result.end(), 0u);
+    return result;
+  }
+
+  if (rect.left <= bounds_.right && rect.right >= bounds_.left &&
+      rect.bottom <= bounds_.top && rect.top >= bounds_.bottom) {
+    const CellRange range = GetCellRange(rect);
+    for (size_t row = range.first_row; row <= range.last_row; ++row) {
+      const size_t first = row * cols_ + range.first_col;
+      const size_t last = row * cols_ + range.last_col;
+      result.insert(result.end(), cell_objects_.begin() + cell_starts_[first],
+                    cell_objects_.begin() + cell_starts_[last + 1]);
+    }
+  }
+  result.insert(result.end(), large_objects_.begin(), large_objects_.end());
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+CPDF_PageObjectIndex::CellRange CPDF_PageObjectIndex::GetCellRange(
+    const CFX_FloatRect& rect) const {
+  return {GetCol(rect.left), GetCol(rect.right), GetRow(rect.bottom),
+          GetRow(rect.top)};
+}
+
+// GetCol() and GetRow() never decrease as their argument increases, so rects
+// that intersect map to cell ranges that overlap.
+size_t CPDF_PageObjectIndex::GetCol(float x) const {
+  const float col = (x - bounds_.left) * cols_per_unit_;
+  if (!(col > 0)) {
+    return 0;
+  }
+  return col >= cols_ ? cols_ - 1 : static_cast<size_t>(col);
+}
+
+size_t CPDF_PageObjectIndex::GetRow(float y) const {
+  const float row = (y - bounds_.bottom) * rows_per_unit_;
+  if (!(row > 0)) {
+    return 0;
+  }
+  return row >= rows_ ? rows_ - 1 : static_cast<size_t>(row);
+}
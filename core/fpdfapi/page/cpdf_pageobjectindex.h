@@ -0,0 +1,64 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+#define CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/span.h"
+
+// Uniform grid over the bounding boxes of a list of page objects, used to find
+// the objects that may be visible in a small part of a dense page without
+// checking all of them.
+class CPDF_PageObjectIndex {
+ public:
+  // `rects` are the bounding boxes of the page objects, in paint order.
+  explicit CPDF_PageObjectIndex(pdfium::span<const CFX_FloatRect> rects);
+  ~CPDF_PageObjectIndex();
+
+  // Returns true if `rect` covers the grid, so that querying it would return
+  // every object.
+  bool Covers(const CFX_FloatRect& rect) const;
+
+  // Returns the indices, in ascending order, of the rects passed to the
+  // constructor that may intersect `rect`. This includes every rect that
+  // intersects it, where rects that only touch also count, but may also
+  // include some that do not.
+  std::vector<size_t> Query(const CFX_FloatRect& rect) const;
+
+ private:
+  struct CellRange {
+    size_t first_col;
+    size_t last_col;
+    size_t first_row;
+    size_t last_row;
+  };
+
+  CellRange GetCellRange(const CFX_FloatRect& rect) const;
+  size_t GetCol(float x) const;
+  size_t GetRow(float y) const;
+
+  const size_t object_count_;
+  CFX_FloatRect bounds_;
+  size_t cols_ = 0;
+  size_t rows_ = 0;
+  float cols_per_unit_ = 0;
+  float rows_per_unit_ = 0;
+
+  // Objects whose rects span too many cells, or are not valid, and are
+  // returned by every query.
+  std::vector<uint32_t> large_objects_;
+
+  // The objects in cell `i` are `cell_objects_[cell_starts_[i]]` up to, but not
+  // including, `cell_objects_[cell_starts_[i + 1]]`, in ascending order.
+  std::vector<uint32_t> cell_starts_;
+  std::vector<uint32_t> cell_objects_;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
@@ -0,0 +1,143 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// The check that the renderers make before drawing an object.
+bool MayBeVisible(const CFX_FloatRect& object, const CFX_FloatRect& clip) {
+  return !(object.left > clip.right || object.right < clip.left ||
+           object.bottom > clip.top || object.top < clip.bottom);
+}
+
+// Returns values in [0, `limit`) from a fixed sequence.
+class Sequence {
+ public:
+  float Next(float limit) {
+    state_ = state_ * 1103515245 + 12345;
+    return (state_ >> 8) % 10000 * limit / 10000;
+  }
+
+ private:
+  uint32_t state_ = 1;
+};
+
+void ExpectQueryFindsVisible(const CPDF_PageObjectIndex& index,
+                             const std::vector<CFX_FloatRect>& rects,
+                             const CFX_FloatRect& clip) {
+  std::vector<size_t> result = index.Query(clip);
+  EXPECT_TRUE(std::ranges::is_sorted(result));
+  EXPECT_EQ(std::ranges::adjacent_find(result), result.end());
+  for (size_t i = 0; i < rects.size(); ++i) {
+    if (MayBeVisible(rects[i], clip)) {
+      EXPECT_TRUE(std::ranges::binary_search(result, i)) << i;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(CPDFPageObjectIndexTest, Empty) {
+  CPDF_PageObjectIndex index({});
+  EXPECT_TRUE(index.Query(CFX_FloatRect(0, 0, 100, 100)).empty());
+}
+
+TEST(CPDFPageObjectIndexTest, SmallObjects) {
+  Sequence sequence;
+  std::vector<CFX_FloatRect> rects;
+  for (int i = 0; i < 5000; ++i) {
+    const float left = sequence.Next(1000);
+    const float bottom = sequence.Next(1000);
+    rects.emplace_back(left, bottom, left + sequence.Next(10),
+                       bottom + sequence.Next(10));
+  }
+  CPDF_PageObjectIndex index(rects);
+
+  for (int i = 0; i < 200; ++i) {
+    const float left = sequence.Next(1100) - 50;
+    const float bottom = sequence.Next(1100) - 50;
+    const float size = sequence.Next(100);
+    const CFX_FloatRect clip(left, bottom, left + size, bottom + size);
+    ExpectQueryFindsVisible(index, rects, clip);
+    EXPECT_FALSE(index.Covers(clip));
+  }
+
+  // A small clip only gets a small part of the objects.
+  EXPECT_LT(index.Query(CFX_FloatRect(500, 500, 510, 510)).size(), 100u);
+}
+
+TEST(CPDFPageObjectIndexTest, TouchingEdges) {
+  std::vector<CFX_FloatRect> rects;
+  for (int y = 0; y < 40; ++y) {
+    for (int x = 0; x < 40; ++x) {
+      rects.emplace_back(x * 10, y * 10, x * 10 + 10, y * 10 + 10);
+    }
+  }
+  CPDF_PageObjectIndex index(rects);
+
+  // Clips that only touch objects at their edges and corners still find them.
+  ExpectQueryFindsVisible(index, rects, CFX_FloatRect(100, 100, 100, 100));
+  ExpectQueryFindsVisible(index, rects, CFX_FloatRect(250, 0, 250, 400));
+  ExpectQueryFindsVisible(index, rects, CFX_FloatRect(400, 400, 500, 500));
+  ExpectQueryFindsVisible(index, rects, CFX_FloatRect(-10, -10, 0, 0));
+
+  EXPECT_TRUE(index.Query(CFX_FloatRect(401, 401, 500, 500)).empty());
+  EXPECT_TRUE(index.Query(CFX_FloatRect(-10, -10, -1, -1)).empty());
+}
+
+TEST(CPDFPageObjectIndexTest, LargeAndInvalidObjects) {
+  const float kNan = std::numeric_limits<float>::quiet_NaN();
+  const float kInf = std::numeric_limits<float>::infinity();
+  std::vector<CFX_FloatRect> rects;
+  for (int i = 0; i < 1000; ++i) {
+    rects.emplace_back(i % 100, i / 10, i % 100 + 1, i / 10 + 1);
+  }
+  rects.emplace_back(0, 0, 100, 100);
+  rects.emplace_back(kNan, 0, 1, 1);
+  rects.emplace_back(0, 0, kInf, 1);
+  rects.emplace_back(50, 50, 40, 60);
+  CPDF_PageObjectIndex index(rects);
+
+  // The objects that cover the whole page, or that have bad rects, are always
+  // returned.
+  std::vector<size_t> result = index.Query(CFX_FloatRect(-20, -20, -10, -10));
+  EXPECT_EQ((std::vector<size_t>{1000, 1001, 1002, 1003}), result);
+  ExpectQueryFindsVisible(index, rects, CFX_FloatRect(45, 45, 46, 46));
+}
+
+TEST(CPDFPageObjectIndexTest, InvalidClip) {
+  const float kNan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<CFX_FloatRect> rects;
+  for (int i = 0; i < 100; ++i) {
+    rects.emplace_back(i, i, i + 1, i + 1);
+  }
+  CPDF_PageObjectIndex index(rects);
+
+  // Every object passes the renderers' checks against a NaN clip.
+  const CFX_FloatRect clip(kNan, 0, 10, 10);
+  EXPECT_TRUE(index.Covers(clip));
+  EXPECT_EQ(100u, index.Query(clip).size());
+}
+
+TEST(CPDFPageObjectIndexTest, Covers) {
+  std::vector<CFX_FloatRect> rects;
+  for (int i = 0; i < 100; ++i) {
+    rects.emplace_back(i, i, i + 1, i + 1);
+  }
+  CPDF_PageObjectIndex index(rects);
+
+  EXPECT_TRUE(index.Covers(CFX_FloatRect(0, 0, 100, 100)));
+  EXPECT_TRUE(index.Covers(CFX_FloatRect(-1, -1, 200, 200)));
+  EXPECT_FALSE(index.Covers(CFX_FloatRect(0, 0, 99, 100)));
+  EXPECT_FALSE(index.Covers(CFX_FloatRect(10, 10, 20, 20)));
+}
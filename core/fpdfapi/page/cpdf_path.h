@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "core/fxcrt/shared_copy_on_write.h"
+#include "core/fxcrt/span.h"
 #include "core/fxge/cfx_path.h"
 
 class CPDF_Path {
@@ -38,6 +39,9 @@ class CPDF_Path {
   void AppendPoint(const CFX_PointF& point, CFX_Path::Point::Type type);
   void AppendPointAndClose(const CFX_PointF& point, CFX_Path::Point::Type type);
 
+  // Appends `points` with a single allocation.
+  void AppendPoints(pdfium::span<const CFX_Path::Point> points);
+
   // TODO(tsepez): Remove when all access thru this class.
   const CFX_Path* GetObject() const { return ref_.GetObject(); }
 
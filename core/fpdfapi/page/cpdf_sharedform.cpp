@@ -0,0 +1,58 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_sharedform.h"
+
+#include <utility>
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/check.h"
+
+CPDF_SharedForm::CPDF_SharedForm(std::unique_ptr<CPDF_Form> form)
+    : form_(std::move(form)), shareable_(false) {}
+
+CPDF_SharedForm::CPDF_SharedForm(CPDF_Document* document,
+                                 RetainPtr<CPDF_Dictionary> page_resources,
+                                 RetainPtr<CPDF_Stream> form_stream,
+                                 RetainPtr<CPDF_Dictionary> parent_resources,
+                                 const CPDF_AllStates& states,
+                                 CPDF_Form::RecursionState* recursion_state)
+    : form_stream_(form_stream),
+      parent_resources_(parent_resources),
+      states_(states),
+      form_(std::make_unique<CPDF_Form>(document,
+                                        std::move(page_resources),
+                                        std::move(form_stream),
+                                        parent_resources.Get())),
+      shareable_(true) {
+  form_->ParseContent(&states_, nullptr, recursion_state);
+}
+
+CPDF_SharedForm::~CPDF_SharedForm() {
+  if (page_data_) {
+    page_data_->MaybePurgeSharedForm(this);
+  }
+}
+
+bool CPDF_SharedForm::Matches(const CPDF_Dictionary* page_resources,
+                              const CPDF_Dictionary* parent_resources,
+                              const CPDF_AllStates& states) const {
+  return shareable_ && form_->GetPageResources() == page_resources &&
+         parent_resources_ == parent_resources &&
+         states_.general_state().SharesDataWith(states.general_state()) &&
+         states_.graph_state().SharesDataWith(states.graph_state()) &&
+         states_.color_state().SharesDataWith(states.color_state()) &&
+         states_.text_state().HasSameValues(states.text_state());
+}
+
+RetainPtr<CPDF_SharedForm> CPDF_SharedForm::ParsePrivateCopy() const {
+  DCHECK(form_stream_);
+  auto copy = pdfium::MakeRetain<CPDF_SharedForm>(
+      form_->GetDocument(), form_->GetMutablePageResources(), form_stream_,
+      parent_resources_, states_, nullptr);
+  copy->StopSharing();
+  return copy;
+}
@@ -0,0 +1,74 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_SHAREDFORM_H_
+#define CORE_FPDFAPI_PAGE_CPDF_SHAREDFORM_H_
+
+#include <memory>
+
+#include "core/fpdfapi/page/cpdf_allstates.h"
+#include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fxcrt/observed_ptr.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CPDF_Dictionary;
+class CPDF_DocPageData;
+class CPDF_Document;
+class CPDF_Stream;
+
+// A parsed form XObject that the CPDF_FormObjects drawing it hold. When the
+// same stream is drawn again in the same context, the parsed page objects are
+// shared instead of parsing the stream again. Only the form matrix and the
+// states of each CPDF_FormObject differ between uses.
+class CPDF_SharedForm final : public Retainable, public Observable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Returns whether parsing the same stream with these resources and
+  // inherited states gives the page objects in form().
+  bool Matches(const CPDF_Dictionary* page_resources,
+               const CPDF_Dictionary* parent_resources,
+               const CPDF_AllStates& states) const;
+
+  // Returns a copy that is parsed again, for changing its page objects without
+  // affecting the other uses.
+  RetainPtr<CPDF_SharedForm> ParsePrivateCopy() const;
+
+  // Stops Matches() from returning true, once the page objects may change.
+  void StopSharing() { shareable_ = false; }
+
+  // Makes this form tell `page_data`, which shares it, when it is destroyed.
+  void SetPageData(CPDF_DocPageData* page_data) { page_data_ = page_data; }
+  // Called by the CPDF_DocPageData sharing this form before it goes away.
+  void WillBeDestroyed() { page_data_ = nullptr; }
+
+  const CPDF_Form* form() const { return form_.get(); }
+  CPDF_Form* mutable_form() { return form_.get(); }
+
+ private:
+  // Wraps a form that is not shared.
+  explicit CPDF_SharedForm(std::unique_ptr<CPDF_Form> form);
+
+  // Parses `form_stream` as drawn from a content stream with
+  // `parent_resources` and the current `states`.
+  CPDF_SharedForm(CPDF_Document* document,
+                  RetainPtr<CPDF_Dictionary> page_resources,
+                  RetainPtr<CPDF_Stream> form_stream,
+                  RetainPtr<CPDF_Dictionary> parent_resources,
+                  const CPDF_AllStates& states,
+                  CPDF_Form::RecursionState* recursion_state);
+  ~CPDF_SharedForm() override;
+
+  RetainPtr<CPDF_Stream> const form_stream_;
+  RetainPtr<CPDF_Dictionary> const parent_resources_;
+  // Holding these also keeps the state data from being changed in place, so
+  // that Matches() can compare it by identity.
+  const CPDF_AllStates states_;
+  std::unique_ptr<CPDF_Form> const form_;
+  UnownedPtr<CPDF_DocPageData> page_data_;
+  bool shareable_;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_SHAREDFORM_H_
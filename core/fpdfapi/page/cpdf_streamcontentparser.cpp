@@ -26,6 +26,7 @@
 #include "core/fpdfapi/page/cpdf_pathobject.h"
 #include "core/fpdfapi/page/cpdf_shadingobject.h"
 #include "core/fpdfapi/page/cpdf_shadingpattern.h"
+#include "core/fpdfapi/page/cpdf_sharedform.h"
 #include "core/fpdfapi/page/cpdf_streamparser.h"
 #include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
@@ -814,9 +815,19 @@ void CPDF_StreamContentParser::AddForm(RetainPtr<CPDF_Stream> pStream,
   status.mutable_graph_state() = cur_states_->graph_state();
   status.mutable_color_state() = cur_states_->color_state();
   status.mutable_text_state() = cur_states_->text_state();
-  auto form = std::make_unique<CPDF_Form>(document_, page_resources_,
-                                          std::move(pStream), resources_.Get());
-  form->ParseContent(&status, nullptr, recursion_state_);
+  RetainPtr<CPDF_SharedForm> form;
+  if (recursion_state_->parsed_set.size() == 1) {
+    // Drawn from a top-level content stream, where parsing does not depend on
+    // which forms are being parsed, so it can be shared with other uses.
+    form = CPDF_DocPageData::FromDocument(document_)->GetSharedForm(
+        page_resources_, std::move(pStream), resources_, status,
+        recursion_state_);
+  } else {
+    form = pdfium::MakeRetain<CPDF_SharedForm>(
+        document_, page_resources_, std::move(pStream), resources_, status,
+        recursion_state_);
+    form->StopSharing();
+  }
 
   CFX_Matrix matrix =
       cur_states_->current_transformation_matrix() * mt_content_to_user_;
@@ -1562,8 +1573,9 @@ void CPDF_StreamContentParser::AddPathPointAndClose(
 void CPDF_StreamContentParser::AddPathObject(
     CFX_FillRenderOptions::FillType fill_type,
     RenderType render_type) {
-  std::vector<CFX_Path::Point> path_points;
-  path_points.swap(path_points_);
+  // Build the path in `path_points_` and clear it afterwards, rather than
+  // swapping it out, so that its capacity is reused by the next path.
+  std::vector<CFX_Path::Point>& path_points = path_points_;
   CFX_FillRenderOptions::FillType path_clip_type = path_clip_type_;
   path_clip_type_ = CFX_FillRenderOptions::FillType::kNoFill;
 
@@ -1573,6 +1585,7 @@ void CPDF_StreamContentParser::AddPathObject(
 
   if (path_points.size() == 1) {
     if (path_clip_type != CFX_FillRenderOptions::FillType::kNoFill) {
+      path_points.clear();
       CPDF_Path path;
       path.AppendRect(0, 0, 0, 0);
       cur_states_->mutable_clip_path().AppendPathWithAutoMerge(
@@ -1584,6 +1597,7 @@ void CPDF_StreamContentParser::AddPathObject(
     if (point.type_ != CFX_Path::Point::Type::kMove || !point.close_figure_ ||
         cur_states_->graph_state().GetLineCap() !=
             CFX_GraphStateData::LineCap::kRound) {
+      path_points.clear();
       return;
     }
 
@@ -1601,13 +1615,8 @@ void CPDF_StreamContentParser::AddPathObject(
   }
 
   CPDF_Path path;
-  for (const auto& point : path_points) {
-    if (point.close_figure_) {
-      path.AppendPointAndClose(point.point_, point.type_);
-    } else {
-      path.AppendPoint(point.point_, point.type_);
-    }
-  }
+  path.AppendPoints(path_points);
+  path_points.clear();
 
   CFX_Matrix matrix =
       cur_states_->current_transformation_matrix() * mt_content_to_user_;
@@ -3,6 +3,10 @@
 // found in the LICENSE file.
 
 #include "core/fpdfapi/page/cpdf_streamparser.h"
+
+#include <vector>
+
+#include "core/fxcrt/bytestring.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -49,3 +53,27 @@ TEST(CPDFStreamParserTest, ReadHexString) {
     EXPECT_EQ(1u, parser.GetPos());
   }
 }
+
+TEST(CPDFStreamParserTest, ParseElements) {
+  static constexpr char kContent[] =
+      "q 1 0 0 1 12.5 -3 cm/F1 12 Tf %comment\r\n"
+      "BT(text)Tj ET /AVeryLongNameThatDoesNotFitInOneBlock true\n";
+  CPDF_StreamParser parser(ByteStringView(kContent).unsigned_span());
+  std::vector<ByteString> words;
+  CPDF_StreamParser::ElementType type;
+  while ((type = parser.ParseNextElement()) !=
+         CPDF_StreamParser::ElementType::kEndOfData) {
+    if (type == CPDF_StreamParser::ElementType::kOther) {
+      words.push_back("<other>");
+    } else {
+      words.push_back(ByteString(parser.GetWord()));
+    }
+    if (type == CPDF_StreamParser::ElementType::kNumber) {
+      words.back() += "#";
+    }
+  }
+  EXPECT_THAT(words,
+              ElementsAre("q", "1#", "0#", "0#", "1#", "12.5#", "-3#", "cm",
+                          "/F1", "12#", "Tf", "BT", "<other>", "Tj", "ET",
+                          "/AVeryLongNameThatDoesNotFitInOneBlock", "<other>"));
+}
@@ -31,6 +31,10 @@ CPDF_TextObject::Item::Item(const Item& that) = default;
 
 CPDF_TextObject::Item::~Item() = default;
 
+CPDF_TextObject::CharPosCache::CharPosCache() = default;
+
+CPDF_TextObject::CharPosCache::~CharPosCache() = default;
+
 CPDF_TextObject::CPDF_TextObject(int32_t content_stream)
     : CPDF_PageObject(content_stream) {}
 
@@ -213,6 +217,7 @@ void CPDF_TextObject::SetSegments(pdfium::span<const ByteString> strings,
   CHECK(nSegs);
   char_codes_.clear();
   char_pos_.clear();
+  char_pos_cache_ = CharPosCache();
   RetainPtr<CPDF_Font> pFont = GetFont();
   size_t nChars = nSegs - 1;
   for (const auto& str : strings) {
@@ -290,6 +295,7 @@ float CPDF_TextObject::CalcPositionDataInternal(
   const CPDF_CIDFont* pCIDFont = pFont->AsCIDFont();
   const bool bVertWriting = IsVertWritingCIDFont(pCIDFont);
   const float fontsize = GetFontSize();
+  char_pos_cache_ = CharPosCache();
 
   for (size_t i = 0; i < char_codes_.size(); ++i) {
     const uint32_t charcode = char_codes_[i];
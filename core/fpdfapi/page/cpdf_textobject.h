@@ -18,6 +18,7 @@
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
+#include "core/fxge/text_char_pos.h"
 
 class CPDF_TextObject final : public CPDF_PageObject {
  public:
@@ -30,6 +31,18 @@ class CPDF_TextObject final : public CPDF_PageObject {
     CFX_PointF origin_;
   };
 
+  // Glyph positions of the text, resolved by the renderer and kept here across
+  // renders. Only valid for `font` and `font_size`. Cleared when the text or
+  // its positions change.
+  struct CharPosCache {
+    CharPosCache();
+    ~CharPosCache();
+
+    RetainPtr<CPDF_Font> font;
+    float font_size = 0.0f;
+    std::vector<TextCharPos> char_pos_list;
+  };
+
   explicit CPDF_TextObject(int32_t content_stream);
   CPDF_TextObject();
   ~CPDF_TextObject() override;
@@ -76,12 +89,15 @@ class CPDF_TextObject final : public CPDF_PageObject {
 
   CFX_PointF CalcPositionData(float horz_scale);
 
+  CharPosCache& char_pos_cache() { return char_pos_cache_; }
+
  private:
   float CalcPositionDataInternal(const RetainPtr<CPDF_Font>& pFont);
 
   CFX_PointF pos_;
   std::vector<uint32_t> char_codes_;
   std::vector<float> char_pos_;
+  CharPosCache char_pos_cache_;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_TEXTOBJECT_H_
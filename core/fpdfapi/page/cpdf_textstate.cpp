@@ -25,6 +25,23 @@ void CPDF_TextState::Emplace() {
   ref_.Emplace();
 }
 
+bool CPDF_TextState::HasSameValues(const CPDF_TextState& that) const {
+  if (ref_ == that.ref_) {
+    return true;
+  }
+  const TextData* data = ref_.GetObject();
+  const TextData* that_data = that.ref_.GetObject();
+  if (!data || !that_data) {
+    return false;
+  }
+  return data->font_ == that_data->font_ &&
+         data->font_size_ == that_data->font_size_ &&
+         data->char_space_ == that_data->char_space_ &&
+         data->word_space_ == that_data->word_space_ &&
+         data->text_rendering_mode_ == that_data->text_rendering_mode_ &&
+         data->matrix_ == that_data->matrix_ && data->ctm_ == that_data->ctm_;
+}
+
 RetainPtr<CPDF_Font> CPDF_TextState::GetFont() const {
   return ref_.GetObject()->font_;
 }
@@ -40,6 +40,10 @@ class CPDF_TextState {
 
   void Emplace();
 
+  // Compares by value. The text matrix is copied on every change of the CTM,
+  // so text states are often equal without sharing data.
+  bool HasSameValues(const CPDF_TextState& that) const;
+
   RetainPtr<CPDF_Font> GetFont() const;
   void SetFont(RetainPtr<CPDF_Font> pFont);
 
@@ -47,6 +47,13 @@ RetainPtr<CPDF_Object> CPDF_Array::Clone() const {
   return CloneObjectNonCyclic(false);
 }
 
+void CPDF_Array::SetModificationOwner(const CPDF_ModificationOwner& owner) {
+  owner_ = owner;
+  for (auto& it : objects_) {
+    it->SetModificationOwner(owner);
+  }
+}
+
 RetainPtr<CPDF_Object> CPDF_Array::CloneNonCyclic(
     bool bDirect,
     std::set<const CPDF_Object*>* pVisited) const {
@@ -205,13 +212,17 @@ RetainPtr<const CPDF_String> CPDF_Array::GetStringAt(size_t index) const {
 
 void CPDF_Array::Clear() {
   CHECK(!IsLocked());
-  objects_.clear();
+  if (!objects_.empty()) {
+    objects_.clear();
+    owner_.MarkModified();
+  }
 }
 
 void CPDF_Array::RemoveAt(size_t index) {
   CHECK(!IsLocked());
   if (index < objects_.size()) {
     objects_.erase(objects_.begin() + index);
+    owner_.MarkModified();
   }
 }
 
@@ -228,6 +239,7 @@ void CPDF_Array::ConvertToIndirectObjectAt(size_t index,
 
   pHolder->AddIndirectObject(objects_[index]);
   objects_[index] = objects_[index]->MakeReference(pHolder);
+  owner_.MarkModified();
 }
 
 void CPDF_Array::SetAt(size_t index, RetainPtr<CPDF_Object> object) {
@@ -252,6 +264,7 @@ CPDF_Object* CPDF_Array::SetAtInternal(size_t index,
     return nullptr;
   }
 
+  owner_.MarkModifiedByChild(pObj.Get());
   CPDF_Object* pRet = pObj.Get();
   objects_[index] = std::move(pObj);
   return pRet;
@@ -267,6 +280,7 @@ CPDF_Object* CPDF_Array::InsertAtInternal(size_t index,
     return nullptr;
   }
 
+  owner_.MarkModifiedByChild(pObj.Get());
   CPDF_Object* pRet = pObj.Get();
   objects_.insert(objects_.begin() + index, std::move(pObj));
   return pRet;
@@ -277,6 +291,7 @@ CPDF_Object* CPDF_Array::AppendInternal(RetainPtr<CPDF_Object> pObj) {
   CHECK(pObj);
   CHECK(pObj->IsInline());
   CHECK(!pObj->IsStream());
+  owner_.MarkModifiedByChild(pObj.Get());
   CPDF_Object* pRet = pObj.Get();
   objects_.push_back(std::move(pObj));
   return pRet;
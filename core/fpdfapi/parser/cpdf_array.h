@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/fx_coordinates.h"
@@ -36,6 +37,7 @@ class CPDF_Array final : public CPDF_Object {
   CPDF_Array* AsMutableArray() override;
   bool WriteTo(IFX_ArchiveStream* archive,
                const CPDF_Encryptor* encryptor) const override;
+  void SetModificationOwner(const CPDF_ModificationOwner& owner) override;
 
   bool IsEmpty() const { return objects_.empty(); }
   size_t size() const { return objects_.size(); }
@@ -170,6 +172,7 @@ class CPDF_Array final : public CPDF_Object {
   std::vector<RetainPtr<CPDF_Object>> objects_;
   WeakPtr<ByteStringPool> pool_;
   mutable uint32_t lock_count_ = 0;
+  CPDF_ModificationOwner owner_;
 };
 
 class CPDF_ArrayLocker {
@@ -11,6 +11,9 @@
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/containers/contains.h"
 
+static_assert(PagedIndexMap<CPDF_CrossRefTable::ObjectInfo>::kMaxPagedKey >=
+              CPDF_Parser::kMaxObjectNumber);
+
 // static
 std::unique_ptr<CPDF_CrossRefTable> CPDF_CrossRefTable::MergeUp(
     std::unique_ptr<CPDF_CrossRefTable> current,
@@ -94,8 +97,7 @@ void CPDF_CrossRefTable::SetTrailer(RetainPtr<CPDF_Dictionary> trailer,
 
 const CPDF_CrossRefTable::ObjectInfo* CPDF_CrossRefTable::GetObjectInfo(
     uint32_t obj_num) const {
-  const auto it = objects_info_.find(obj_num);
-  return it != objects_info_.end() ? &it->second : nullptr;
+  return objects_info_.find(obj_num);
 }
 
 void CPDF_CrossRefTable::Update(
@@ -110,7 +112,7 @@ void CPDF_CrossRefTable::SetObjectMapSize(uint32_t size) {
     return;
   }
 
-  objects_info_.erase(objects_info_.lower_bound(size), objects_info_.end());
+  objects_info_.erase_from(size);
 
   if (!pdfium::Contains(objects_info_, size - 1)) {
     objects_info_[size - 1].pos = 0;
@@ -118,7 +120,7 @@ void CPDF_CrossRefTable::SetObjectMapSize(uint32_t size) {
 }
 
 void CPDF_CrossRefTable::UpdateInfo(
-    std::map<uint32_t, ObjectInfo> new_objects_info) {
+    PagedIndexMap<ObjectInfo> new_objects_info) {
   if (new_objects_info.empty()) {
     return;
   }
@@ -128,28 +130,14 @@ void CPDF_CrossRefTable::UpdateInfo(
     return;
   }
 
-  auto cur_it = objects_info_.begin();
-  auto new_it = new_objects_info.begin();
-  while (cur_it != objects_info_.end() && new_it != new_objects_info.end()) {
-    if (cur_it->first == new_it->first) {
-      if (new_it->second.type == ObjectType::kNormal &&
-          cur_it->second.type == ObjectType::kNormal &&
-          cur_it->second.is_object_stream_flag) {
-        new_it->second.is_object_stream_flag = true;
-      }
-      ++cur_it;
-      ++new_it;
-    } else if (cur_it->first < new_it->first) {
-      new_objects_info.insert(new_it, *cur_it);
-      ++cur_it;
-    } else {
-      new_it = new_objects_info.lower_bound(cur_it->first);
-    }
-  }
-  for (; cur_it != objects_info_.end(); ++cur_it) {
-    new_objects_info.insert(new_objects_info.end(), *cur_it);
+  for (const auto& [obj_num, new_info] : new_objects_info) {
+    ObjectInfo& info = objects_info_[obj_num];
+    const bool is_object_stream = new_info.type == ObjectType::kNormal &&
+                                  info.type == ObjectType::kNormal &&
+                                  info.is_object_stream_flag;
+    info = new_info;
+    info.is_object_stream_flag |= is_object_stream;
   }
-  objects_info_ = std::move(new_objects_info);
 }
 
 void CPDF_CrossRefTable::UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer) {
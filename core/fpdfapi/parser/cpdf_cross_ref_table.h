@@ -7,10 +7,10 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
 
 #include "core/fxcrt/fx_types.h"
+#include "core/fxcrt/paged_index_map.h"
 #include "core/fxcrt/retain_ptr.h"
 
 class CPDF_Dictionary;
@@ -67,7 +67,7 @@ class CPDF_CrossRefTable {
 
   const ObjectInfo* GetObjectInfo(uint32_t obj_num) const;
 
-  const std::map<uint32_t, ObjectInfo>& objects_info() const {
+  const PagedIndexMap<ObjectInfo>& objects_info() const {
     return objects_info_;
   }
 
@@ -77,7 +77,7 @@ class CPDF_CrossRefTable {
   void SetObjectMapSize(uint32_t size);
 
  private:
-  void UpdateInfo(std::map<uint32_t, ObjectInfo> new_objects_info);
+  void UpdateInfo(PagedIndexMap<ObjectInfo> new_objects_info);
   void UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer);
 
   RetainPtr<CPDF_Dictionary> trailer_;
@@ -85,7 +85,7 @@ class CPDF_CrossRefTable {
   // inline, it has no object number. Store the stream's object number, or 0 if
   // there is none.
   uint32_t trailer_object_number_ = 0;
-  std::map<uint32_t, ObjectInfo> objects_info_;
+  PagedIndexMap<ObjectInfo> objects_info_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_cross_ref_avail.h"
@@ -54,19 +55,69 @@ RetainPtr<CPDF_Object> GetResourceObject(RetainPtr<CPDF_Dictionary> pDict) {
   return nullptr;
 }
 
-class HintsScope {
+// Collects the segments requested during one availability check, and reports
+// them to the embedder as a sorted batch when the check is done. Segments that
+// overlap or are close together are merged, so the embedder can satisfy the
+// batch with as few range requests as possible.
+class HintsScope final : public CPDF_DataAvail::DownloadHints {
  public:
   HintsScope(RetainPtr<CPDF_ReadValidator> validator,
-             CPDF_DataAvail::DownloadHints* hints)
-      : validator_(std::move(validator)) {
+             CPDF_DataAvail::DownloadHints* hints,
+             CPDF_DataAvail::HintStats* stats)
+      : validator_(std::move(validator)), hints_(hints), stats_(stats) {
     DCHECK(validator_);
-    validator_->SetDownloadHints(hints);
+    validator_->SetDownloadHints(hints_ ? this : nullptr);
   }
 
-  ~HintsScope() { validator_->SetDownloadHints(nullptr); }
+  ~HintsScope() override {
+    validator_->SetDownloadHints(nullptr);
+    Flush();
+  }
+
+  // CPDF_DataAvail::DownloadHints:
+  void AddSegment(FX_FILESIZE offset, size_t size) override {
+    FX_SAFE_FILESIZE end = offset;
+    end += size;
+    if (end.IsValid()) {
+      segments_.emplace_back(offset, end.ValueOrDie());
+    }
+  }
 
  private:
+  // Segments further apart than this are reported separately. Fetching a small
+  // gap is cheaper than another round trip.
+  static constexpr FX_FILESIZE kMaxMergeGap = 4096;
+
+  void Flush() {
+    if (segments_.empty()) {
+      return;
+    }
+
+    std::sort(segments_.begin(), segments_.end());
+    size_t merged_count = 0;
+    for (const auto& segment : segments_) {
+      if (merged_count > 0 &&
+          segment.first <= segments_[merged_count - 1].second + kMaxMergeGap) {
+        segments_[merged_count - 1].second =
+            std::max(segments_[merged_count - 1].second, segment.second);
+        continue;
+      }
+      segments_[merged_count++] = segment;
+    }
+    segments_.resize(merged_count);
+
+    for (const auto& segment : segments_) {
+      hints_->AddSegment(segment.first,
+                         static_cast<size_t>(segment.second - segment.first));
+    }
+    ++stats_->batches;
+    stats_->segments += merged_count;
+  }
+
   RetainPtr<CPDF_ReadValidator> validator_;
+  UnownedPtr<CPDF_DataAvail::DownloadHints> const hints_;
+  UnownedPtr<CPDF_DataAvail::HintStats> const stats_;
+  std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> segments_;
 };
 
 }  // namespace
@@ -104,7 +155,7 @@ CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::IsDocAvail(
 
   DCHECK(seen_page_obj_list_.empty());
   AutoRestorer<std::set<uint32_t>> seen_objects_restorer(&seen_page_obj_list_);
-  const HintsScope hints_scope(GetValidator(), pHints);
+  HintsScope hints_scope(GetValidator(), pHints, &hint_stats_);
   while (!doc_avail_) {
     if (!CheckDocStatus()) {
       return kDataNotAvailable;
@@ -859,7 +910,7 @@ CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::IsPageAvail(
     return kDataAvailable;
   }
 
-  const HintsScope hints_scope(GetValidator(), pHints);
+  HintsScope hints_scope(GetValidator(), pHints, &hint_stats_);
   if (linearized_) {
     if (dwPage == linearized_->GetFirstPageNo()) {
       RetainPtr<const CPDF_Dictionary> pPageDict =
@@ -1028,7 +1079,7 @@ RetainPtr<const CPDF_Dictionary> CPDF_DataAvail::GetPageDictionary(
 
 CPDF_DataAvail::DocFormStatus CPDF_DataAvail::IsFormAvail(
     DownloadHints* pHints) {
-  const HintsScope hints_scope(GetValidator(), pHints);
+  HintsScope hints_scope(GetValidator(), pHints, &hint_stats_);
   return CheckAcroForm();
 }
 
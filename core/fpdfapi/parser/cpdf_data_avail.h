@@ -70,6 +70,15 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
     virtual void AddSegment(FX_FILESIZE offset, size_t size) = 0;
   };
 
+  // Counts the download hints given to the embedder.
+  struct HintStats {
+    // Number of availability checks that asked for more data. The embedder
+    // makes one round trip for each.
+    uint32_t batches = 0;
+    // Number of segments requested, after merging nearby ones.
+    uint32_t segments = 0;
+  };
+
   CPDF_DataAvail(FileAvail* pFileAvail,
                  RetainPtr<IFX_SeekableReadStream> pFileRead);
   ~CPDF_DataAvail() override;
@@ -84,6 +93,7 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
   int GetPageCount() const;
   RetainPtr<const CPDF_Dictionary> GetPageDictionary(int index) const;
   RetainPtr<CPDF_ReadValidator> GetValidator() const;
+  const HintStats& hint_stats() const { return hint_stats_; }
 
   std::pair<CPDF_Parser::Error, std::unique_ptr<CPDF_Document>> ParseDocument(
       std::unique_ptr<CPDF_Document::RenderDataIface> pRenderData,
@@ -196,6 +206,7 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
            std::unique_ptr<CPDF_PageObjectAvail>,
            std::less<>>
       pages_resources_avail_;
+  HintStats hint_stats_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_DATA_AVAIL_H_
@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
+#include <algorithm>
 #include <set>
 #include <utility>
 
@@ -22,6 +23,37 @@
 #include "core/fxcrt/containers/contains.h"
 #include "core/fxcrt/fx_stream.h"
 
+namespace {
+
+// Keys stored in a dictionary are usually interned, so lookups with a key from
+// the same pool can skip comparing the characters.
+bool IsSameKey(const ByteString& lhs, const ByteString& rhs) {
+  return lhs.c_str() == rhs.c_str() || lhs == rhs;
+}
+
+bool IsSameKey(const ByteString& lhs, ByteStringView rhs) {
+  return lhs == rhs;
+}
+
+// Returns the first entry in `map` whose key is not less than `key`.
+template <typename Map, typename Key>
+auto LowerBound(Map& map, const Key& key) {
+  return std::lower_bound(
+      map.begin(), map.end(), key,
+      [](const CPDF_Dictionary::Entry& entry, const Key& key) {
+        return entry.first < key;
+      });
+}
+
+// Returns the entry for `key` in `map`, or `map.end()` if there is none.
+template <typename Map, typename Key>
+auto Find(Map& map, const Key& key) {
+  auto it = LowerBound(map, key);
+  return it != map.end() && IsSameKey(it->first, key) ? it : map.end();
+}
+
+}  // namespace
+
 CPDF_Dictionary::CPDF_Dictionary()
     : CPDF_Dictionary(WeakPtr<ByteStringPool>()) {}
 
@@ -51,6 +83,13 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::Clone() const {
   return CloneObjectNonCyclic(false);
 }
 
+void CPDF_Dictionary::SetModificationOwner(const CPDF_ModificationOwner& owner) {
+  owner_ = owner;
+  for (auto& it : map_) {
+    it.second->SetModificationOwner(owner);
+  }
+}
+
 RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
     bool bDirect,
     std::set<const CPDF_Object*>* pVisited) const {
@@ -62,7 +101,8 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
       std::set<const CPDF_Object*> visited(*pVisited);
       auto obj = it.second->CloneNonCyclic(bDirect, &visited);
       if (obj) {
-        pCopy->map_.insert(std::make_pair(it.first, std::move(obj)));
+        // `map_` is sorted, so this appends.
+        pCopy->map_.emplace_back(it.first, std::move(obj));
       }
     }
   }
@@ -71,7 +111,7 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
 
 const CPDF_Object* CPDF_Dictionary::GetObjectForInternal(
     const ByteString& key) const {
-  auto it = map_.find(key);
+  auto it = Find(map_, key);
   return it != map_.end() ? it->second.Get() : nullptr;
 }
 
@@ -260,7 +300,7 @@ CFX_Matrix CPDF_Dictionary::GetMatrixFor(const ByteString& key) const {
 }
 
 bool CPDF_Dictionary::KeyExist(ByteStringView key) const {
-  return pdfium::Contains(map_, key);
+  return Find(map_, key) != map_.end();
 }
 
 std::vector<ByteString> CPDF_Dictionary::GetKeys() const {
@@ -280,37 +320,77 @@ void CPDF_Dictionary::SetFor(const ByteString& key,
 CPDF_Object* CPDF_Dictionary::SetForInternal(const ByteString& key,
                                              RetainPtr<CPDF_Object> pObj) {
   CHECK(!IsLocked());
+  auto it = LowerBound(map_, key);
+  const bool exists = it != map_.end() && IsSameKey(it->first, key);
   if (!pObj) {
-    map_.erase(key);
+    if (exists) {
+      map_.erase(it);
+      owner_.MarkModified();
+    }
     return nullptr;
   }
   CHECK(pObj->IsInline());
   CHECK(!pObj->IsStream());
+  owner_.MarkModifiedByChild(pObj.Get());
   CPDF_Object* pRet = pObj.Get();
-  map_[MaybeIntern(key)] = std::move(pObj);
+  if (exists) {
+    it->second = std::move(pObj);
+  } else {
+    map_.emplace(it, MaybeIntern(key), std::move(pObj));
+  }
   return pRet;
 }
 
+void CPDF_Dictionary::SetEntries(std::vector<Entry> entries) {
+  CHECK(!IsLocked());
+  CHECK(map_.empty());
+  for (auto& entry : entries) {
+    CHECK(entry.second);
+    CHECK(entry.second->IsInline());
+    CHECK(!entry.second->IsStream());
+    entry.first = MaybeIntern(entry.first);
+  }
+  // Where a key repeats, the last entry wins, as it would with SetFor().
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry& lhs, const Entry& rhs) {
+                     return lhs.first < rhs.first;
+                   });
+  map_.reserve(entries.size());
+  for (auto& entry : entries) {
+    if (!map_.empty() && IsSameKey(map_.back().first, entry.first)) {
+      map_.back().second = std::move(entry.second);
+    } else {
+      map_.push_back(std::move(entry));
+    }
+  }
+  if (owner_.IsSet()) {
+    owner_.MarkModified();
+    SetModificationOwner(owner_);
+  }
+}
+
 void CPDF_Dictionary::ConvertToIndirectObjectFor(
     const ByteString& key,
     CPDF_IndirectObjectHolder* pHolder) {
   CHECK(!IsLocked());
-  auto it = map_.find(key);
+  auto it = Find(map_, key);
   if (it == map_.end() || it->second->IsReference()) {
     return;
   }
 
   pHolder->AddIndirectObject(it->second);
   it->second = it->second->MakeReference(pHolder);
+  owner_.MarkModified();
 }
 
 RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
   CHECK(!IsLocked());
   RetainPtr<CPDF_Object> result;
-  auto it = map_.find(key);
+  auto it = Find(map_, key);
   if (it != map_.end()) {
     result = std::move(it->second);
     map_.erase(it);
+    owner_.MarkModified();
   }
   return result;
 }
@@ -318,18 +398,19 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
 void CPDF_Dictionary::ReplaceKey(const ByteString& oldkey,
                                  const ByteString& newkey) {
   CHECK(!IsLocked());
-  auto old_it = map_.find(oldkey);
+  auto old_it = Find(map_, oldkey);
   if (old_it == map_.end()) {
     return;
   }
 
-  auto new_it = map_.find(newkey);
+  auto new_it = Find(map_, newkey);
   if (new_it == old_it) {
     return;
   }
 
-  map_[MaybeIntern(newkey)] = std::move(old_it->second);
+  RetainPtr<CPDF_Object> object = std::move(old_it->second);
   map_.erase(old_it);
+  SetForInternal(newkey, std::move(object));
 }
 
 void CPDF_Dictionary::SetRectFor(const ByteString& key,
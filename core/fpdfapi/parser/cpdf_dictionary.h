@@ -7,13 +7,12 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 
-#include <functional>
-#include <map>
 #include <set>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/fx_coordinates.h"
@@ -21,6 +20,7 @@
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/string_pool_template.h"
 #include "core/fxcrt/weak_ptr.h"
+#include "third_party/abseil-cpp/absl/container/inlined_vector.h"
 
 class CPDF_IndirectObjectHolder;
 
@@ -28,7 +28,10 @@ class CPDF_IndirectObjectHolder;
 // will return nullptr to indicate non-existent keys.
 class CPDF_Dictionary final : public CPDF_Object {
  public:
-  using DictMap = std::map<ByteString, RetainPtr<CPDF_Object>, std::less<>>;
+  using Entry = std::pair<ByteString, RetainPtr<CPDF_Object>>;
+  // Entries sorted by key. Most dictionaries only have a few keys, so they are
+  // stored inline in a flat array instead of in separately allocated nodes.
+  using DictMap = absl::InlinedVector<Entry, 4>;
   using const_iterator = DictMap::const_iterator;
 
   CONSTRUCT_VIA_MAKE_RETAIN;
@@ -39,6 +42,7 @@ class CPDF_Dictionary final : public CPDF_Object {
   CPDF_Dictionary* AsMutableDictionary() override;
   bool WriteTo(IFX_ArchiveStream* archive,
                const CPDF_Encryptor* encryptor) const override;
+  void SetModificationOwner(const CPDF_ModificationOwner& owner) override;
 
   bool IsLocked() const { return !!lock_count_; }
 
@@ -83,7 +87,7 @@ class CPDF_Dictionary final : public CPDF_Object {
   std::vector<ByteString> GetKeys() const;
 
   // Creates a new object owned by the dictionary and returns an unowned
-  // pointer to it. Invalidates iterators for the element with the key |key|.
+  // pointer to it. Invalidates iterators.
   // Prefer using these templates over calls to SetFor(), since by creating
   // a new object with no previous references, they ensure cycles can not be
   // introduced.
@@ -104,12 +108,16 @@ class CPDF_Dictionary final : public CPDF_Object {
   }
 
   // If `object` is null, then `key` is erased from the map. Otherwise, takes
-  // ownership of `object` and stores in in the map. Invalidates iterators for
-  // the element with the key `key`.
+  // ownership of `object` and stores in in the map. Invalidates iterators.
   void SetFor(const ByteString& key, RetainPtr<CPDF_Object> object);
   // A stream must be indirect and added as a `CPDF_Reference` instead.
   void SetFor(const ByteString& key, RetainPtr<CPDF_Stream> stream) = delete;
 
+  // Same as calling SetFor() for each of `entries` in order on an empty
+  // dictionary, but without the cost of keeping the entries sorted after each
+  // one. For use when the dictionary is first filled in.
+  void SetEntries(std::vector<Entry> entries);
+
   // Convenience functions to convert native objects to array form.
   void SetRectFor(const ByteString& key, const CFX_FloatRect& rect);
   void SetMatrixFor(const ByteString& key, const CFX_Matrix& matrix);
@@ -117,10 +125,10 @@ class CPDF_Dictionary final : public CPDF_Object {
   void ConvertToIndirectObjectFor(const ByteString& key,
                                   CPDF_IndirectObjectHolder* pHolder);
 
-  // Invalidates iterators for the element with the key |key|.
+  // Invalidates iterators.
   RetainPtr<CPDF_Object> RemoveFor(ByteStringView key);
 
-  // Invalidates iterators for the element with the key |oldkey|.
+  // Invalidates iterators.
   void ReplaceKey(const ByteString& oldkey, const ByteString& newkey);
 
   WeakPtr<ByteStringPool> GetByteStringPool() const { return pool_; }
@@ -152,6 +160,7 @@ class CPDF_Dictionary final : public CPDF_Object {
   mutable uint32_t lock_count_ = 0;
   WeakPtr<ByteStringPool> pool_;
   DictMap map_;
+  CPDF_ModificationOwner owner_;
 };
 
 class CPDF_DictionaryLocker {
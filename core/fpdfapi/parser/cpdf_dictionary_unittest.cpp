@@ -5,8 +5,10 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -35,3 +37,44 @@ TEST(DictionaryTest, Iterators) {
   ++it;
   EXPECT_EQ(it, locked_dict.end());
 }
+
+TEST(DictionaryTest, SetEntries) {
+  std::vector<CPDF_Dictionary::Entry> entries;
+  entries.emplace_back("Type", pdfium::MakeRetain<CPDF_Name>(nullptr, "Page"));
+  entries.emplace_back("Count", pdfium::MakeRetain<CPDF_Number>(1));
+  entries.emplace_back("Annots", pdfium::MakeRetain<CPDF_Array>());
+  entries.emplace_back("Count", pdfium::MakeRetain<CPDF_Number>(2));
+
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetEntries(std::move(entries));
+  EXPECT_EQ(3u, dict->size());
+  EXPECT_EQ("Page", dict->GetNameFor("Type"));
+  EXPECT_EQ(2, dict->GetIntegerFor("Count"));
+  EXPECT_TRUE(dict->GetArrayFor("Annots"));
+
+  CPDF_DictionaryLocker locked_dict(dict);
+  auto it = locked_dict.begin();
+  EXPECT_EQ(it->first, ByteString("Annots"));
+  ++it;
+  EXPECT_EQ(it->first, ByteString("Count"));
+  ++it;
+  EXPECT_EQ(it->first, ByteString("Type"));
+  ++it;
+  EXPECT_EQ(it, locked_dict.end());
+}
+
+TEST(DictionaryTest, KeepsKeysSorted) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  for (const char* key : {"e", "b", "g", "a", "f", "c", "d"}) {
+    dict->SetNewFor<CPDF_Number>(key, 1);
+  }
+  dict->RemoveFor("c");
+  dict->ReplaceKey("e", "h");
+  dict->SetNewFor<CPDF_Number>("b", 2);
+  EXPECT_FALSE(dict->KeyExist("c"));
+  EXPECT_FALSE(dict->KeyExist("e"));
+  EXPECT_EQ(2, dict->GetIntegerFor("b"));
+
+  std::vector<ByteString> expected_keys = {"a", "b", "d", "f", "g", "h"};
+  EXPECT_EQ(expected_keys, dict->GetKeys());
+}
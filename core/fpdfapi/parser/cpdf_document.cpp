@@ -176,7 +176,7 @@ CPDF_Document::CPDF_Document(std::unique_ptr<RenderDataIface> pRenderData,
                              std::unique_ptr<PageDataIface> pPageData)
     : doc_render_(std::move(pRenderData)),
       doc_page_(std::move(pPageData)),
-      stock_font_clearer_(doc_page_.get()) {
+      global_data_clearer_(doc_page_.get()) {
   doc_render_->SetDocument(this);
   doc_page_->SetDocument(this);
 }
@@ -755,12 +755,13 @@ void CPDF_Document::ResizePageListForTesting(size_t size) {
   page_list_.resize(size);
 }
 
-CPDF_Document::StockFontClearer::StockFontClearer(
+CPDF_Document::GlobalDataClearer::GlobalDataClearer(
     CPDF_Document::PageDataIface* pPageData)
     : page_data_(pPageData) {}
 
-CPDF_Document::StockFontClearer::~StockFontClearer() {
+CPDF_Document::GlobalDataClearer::~GlobalDataClearer() {
   page_data_->ClearStockFont();
+  page_data_->ClearDecodedImages();
 }
 
 CPDF_Document::PageDataIface::PageDataIface() = default;
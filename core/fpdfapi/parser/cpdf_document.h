@@ -51,6 +51,7 @@ class CPDF_Document : public Observable,
     virtual ~PageDataIface();
 
     virtual void ClearStockFont() = 0;
+    virtual void ClearDecodedImages() = 0;
     virtual RetainPtr<CPDF_StreamAcc> GetFontFileStreamAcc(
         RetainPtr<const CPDF_Stream> pFontStream) = 0;
     virtual void MaybePurgeFontFileStreamAcc(
@@ -169,12 +170,14 @@ class CPDF_Document : public Observable,
   void ResizePageListForTesting(size_t size);
 
  private:
-  class StockFontClearer {
+  // Drops the document's entries from per-thread caches when the document
+  // goes away.
+  class GlobalDataClearer {
    public:
     FX_STACK_ALLOCATED();
 
-    explicit StockFontClearer(CPDF_Document::PageDataIface* pPageData);
-    ~StockFontClearer();
+    explicit GlobalDataClearer(CPDF_Document::PageDataIface* pPageData);
+    ~GlobalDataClearer();
 
    private:
     UnownedPtr<CPDF_Document::PageDataIface> const page_data_;
@@ -229,7 +232,7 @@ class CPDF_Document : public Observable,
   std::vector<uint32_t> page_list_;  // Page number to page's dict objnum.
 
   // Must be second to last.
-  StockFontClearer stock_font_clearer_;
+  GlobalDataClearer global_data_clearer_;
 
   // Must be last. Destroy the extension before any non-extension teardown.
   std::unique_ptr<Extension> extension_;
@@ -17,14 +17,17 @@ class CPDF_CryptoHandler;
 
 class CPDF_Encryptor {
  public:
-  CPDF_Encryptor(const CPDF_CryptoHandler* pHandler, int objnum);
+  CPDF_Encryptor(const CPDF_CryptoHandler* pHandler,
+                 uint32_t objnum,
+                 uint32_t gennum);
   ~CPDF_Encryptor();
 
   DataVector<uint8_t> Encrypt(pdfium::span<const uint8_t> src_data) const;
 
  private:
   UnownedPtr<const CPDF_CryptoHandler> const handler_;
-  const int obj_num_;
+  const uint32_t obj_num_;
+  const uint32_t gen_num_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_ENCRYPTOR_H_
@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/parser/cpdf_flateencoder.h"
 
+#include <utility>
 #include <variant>
 
 #include "constants/stream_dict_common.h"
@@ -19,6 +20,12 @@
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 
+// static
+DataVector<uint8_t> CPDF_FlateEncoder::Encode(
+    pdfium::span<const uint8_t> src_span) {
+  return FlateModule::Encode(src_span);
+}
+
 CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
                                      bool bFlateEncode)
     : acc_(pdfium::MakeRetain<CPDF_StreamAcc>(pStream)) {
@@ -42,7 +49,20 @@ CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
     return;
   }
 
-  data_ = FlateModule::Encode(acc_->GetSpan());
+  SetEncodedData(pStream.Get(), Encode(acc_->GetSpan()));
+}
+
+CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
+                                     DataVector<uint8_t> encoded_data) {
+  DCHECK(!pStream->HasFilter());
+  SetEncodedData(pStream.Get(), std::move(encoded_data));
+}
+
+CPDF_FlateEncoder::~CPDF_FlateEncoder() = default;
+
+void CPDF_FlateEncoder::SetEncodedData(const CPDF_Stream* pStream,
+                                       DataVector<uint8_t> encoded_data) {
+  data_ = std::move(encoded_data);
   CHECK(!GetSpan().empty());
   cloned_dict_ = ToDictionary(pStream->GetDict()->Clone());
   cloned_dict_->SetNewFor<CPDF_Number>(
@@ -52,8 +72,6 @@ CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
   DCHECK(!dict_);
 }
 
-CPDF_FlateEncoder::~CPDF_FlateEncoder() = default;
-
 void CPDF_FlateEncoder::UpdateLength(size_t size) {
   if (static_cast<size_t>(GetDict()->GetIntegerFor("Length")) == size) {
     return;
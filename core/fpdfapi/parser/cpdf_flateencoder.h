@@ -23,7 +23,14 @@ class IFX_ArchiveStream;
 
 class CPDF_FlateEncoder {
  public:
+  // Compresses `src_span` the way the constructor does. Only touches
+  // `src_span`, so it is safe to call from any thread.
+  static DataVector<uint8_t> Encode(pdfium::span<const uint8_t> src_span);
+
   CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream, bool bFlateEncode);
+  // For an unfiltered `pStream` whose data was already compressed by Encode().
+  CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
+                    DataVector<uint8_t> encoded_data);
   ~CPDF_FlateEncoder();
 
   void UpdateLength(size_t size);
@@ -37,10 +44,13 @@ class CPDF_FlateEncoder {
     return std::holds_alternative<DataVector<uint8_t>>(data_);
   }
 
+  void SetEncodedData(const CPDF_Stream* pStream,
+                      DataVector<uint8_t> encoded_data);
+
   // Returns |cloned_dict_| if it is valid. Otherwise returns |dict_|.
   const CPDF_Dictionary* GetDict() const;
 
-  // Must outlive `data_`.
+  // Must outlive `data_`. Null when the data was compressed ahead of time.
   RetainPtr<CPDF_StreamAcc> const acc_;
 
   std::variant<pdfium::raw_span<const uint8_t>, DataVector<uint8_t>> data_;
@@ -463,10 +463,10 @@ CPDF_DataAvail::DocAvailStatus CPDF_HintTables::CheckPage(uint32_t index) {
     return CPDF_DataAvail::kDataError;
   }
 
-  if (!validator_->CheckDataRangeAndRequestIfUnavailable(
-          page_infos_[index].page_offset(), dwLength)) {
-    return CPDF_DataAvail::kDataNotAvailable;
-  }
+  // Request the page and all of its shared objects before returning, so that
+  // the embedder gets every missing range in one batch of hints.
+  bool available = validator_->CheckDataRangeAndRequestIfUnavailable(
+      page_infos_[index].page_offset(), dwLength);
 
   // Download data of shared objects in the page.
   for (const uint32_t dwIndex : page_infos_[index].Identifiers()) {
@@ -482,9 +482,12 @@ CPDF_DataAvail::DocAvailStatus CPDF_HintTables::CheckPage(uint32_t index) {
 
     if (!validator_->CheckDataRangeAndRequestIfUnavailable(
             shared_group_info.offset_, shared_group_info.length_)) {
-      return CPDF_DataAvail::kDataNotAvailable;
+      available = false;
     }
   }
+  if (!available) {
+    return CPDF_DataAvail::kDataNotAvailable;
+  }
   return CPDF_DataAvail::kDataAvailable;
 }
 
@@ -13,6 +13,7 @@
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/containers/contains.h"
 
 namespace {
 
@@ -23,7 +24,8 @@ const CPDF_Object* FilterInvalidObjNum(const CPDF_Object* obj) {
 }  // namespace
 
 CPDF_IndirectObjectHolder::CPDF_IndirectObjectHolder()
-    : byte_string_pool_(std::make_unique<ByteStringPool>()) {}
+    : byte_string_pool_(std::make_unique<ByteStringPool>()),
+      modified_objects_(pdfium::MakeRetain<CPDF_ModifiedObjects>()) {}
 
 CPDF_IndirectObjectHolder::~CPDF_IndirectObjectHolder() {
   byte_string_pool_.DeleteObject();  // Make weak.
@@ -42,12 +44,8 @@ RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::GetMutableIndirectObject(
 
 const CPDF_Object* CPDF_IndirectObjectHolder::GetIndirectObjectInternal(
     uint32_t objnum) const {
-  auto it = indirect_objs_.find(objnum);
-  if (it == indirect_objs_.end()) {
-    return nullptr;
-  }
-
-  return FilterInvalidObjNum(it->second.Get());
+  const RetainPtr<CPDF_Object>* obj = indirect_objs_.find(objnum);
+  return obj ? FilterInvalidObjNum(obj->Get()) : nullptr;
 }
 
 RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::GetOrParseIndirectObject(
@@ -62,22 +60,22 @@ CPDF_Object* CPDF_IndirectObjectHolder::GetOrParseIndirectObjectInternal(
   }
 
   // Add item anyway to prevent recursively parsing of same object.
-  auto insert_result = indirect_objs_.insert(std::make_pair(objnum, nullptr));
-  if (!insert_result.second) {
-    return const_cast<CPDF_Object*>(
-        FilterInvalidObjNum(insert_result.first->second.Get()));
+  auto [obj_holder, inserted] = indirect_objs_.try_emplace(objnum, nullptr);
+  if (!inserted) {
+    return const_cast<CPDF_Object*>(FilterInvalidObjNum(obj_holder->Get()));
   }
   RetainPtr<CPDF_Object> pNewObj = ParseIndirectObject(objnum);
   if (!pNewObj) {
-    indirect_objs_.erase(insert_result.first);
+    indirect_objs_.erase(objnum);
     return nullptr;
   }
 
   pNewObj->SetObjNum(objnum);
+  TrackModifications(pNewObj.Get(), objnum);
   last_obj_num_ = std::max(last_obj_num_, objnum);
 
   CPDF_Object* result = pNewObj.Get();
-  insert_result.first->second = std::move(pNewObj);
+  *obj_holder = std::move(pNewObj);
   return result;
 }
 
@@ -90,6 +88,8 @@ uint32_t CPDF_IndirectObjectHolder::AddIndirectObject(
     RetainPtr<CPDF_Object> pObj) {
   CHECK(!pObj->GetObjNum());
   pObj->SetObjNum(++last_obj_num_);
+  TrackModifications(pObj.Get(), last_obj_num_);
+  modified_objects_->MarkModified(last_obj_num_);
   indirect_objs_[last_obj_num_] = std::move(pObj);
   return last_obj_num_;
 }
@@ -109,16 +109,29 @@ bool CPDF_IndirectObjectHolder::ReplaceIndirectObjectIfHigherGeneration(
   }
 
   pObj->SetObjNum(objnum);
+  TrackModifications(pObj.Get(), objnum);
+  // Objects loaded later are not edits, but replacing a deleted object is.
+  if (pdfium::Contains(modified_objects_->deleted(), objnum)) {
+    modified_objects_->MarkModified(objnum);
+  }
   obj_holder = std::move(pObj);
   last_obj_num_ = std::max(last_obj_num_, objnum);
   return true;
 }
 
 void CPDF_IndirectObjectHolder::DeleteIndirectObject(uint32_t objnum) {
-  auto it = indirect_objs_.find(objnum);
-  if (it == indirect_objs_.end() || !FilterInvalidObjNum(it->second.Get())) {
+  const RetainPtr<CPDF_Object>* obj = indirect_objs_.find(objnum);
+  if (!obj || !FilterInvalidObjNum(obj->Get())) {
     return;
   }
 
-  indirect_objs_.erase(it);
+  indirect_objs_.erase(objnum);
+  modified_objects_->MarkDeleted(objnum);
+}
+
+void CPDF_IndirectObjectHolder::TrackModifications(CPDF_Object* obj,
+                                                   uint32_t objnum) {
+  CPDF_ModificationOwner owner;
+  owner.Set(modified_objects_, objnum);
+  obj->SetModificationOwner(owner);
 }
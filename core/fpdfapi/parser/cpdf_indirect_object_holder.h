@@ -9,19 +9,19 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <type_traits>
 #include <utility>
 
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fxcrt/paged_index_map.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/string_pool_template.h"
 #include "core/fxcrt/weak_ptr.h"
 
 class CPDF_IndirectObjectHolder {
  public:
-  using const_iterator =
-      std::map<uint32_t, RetainPtr<CPDF_Object>>::const_iterator;
+  using const_iterator = PagedIndexMap<RetainPtr<CPDF_Object>>::const_iterator;
 
   CPDF_IndirectObjectHolder();
   virtual ~CPDF_IndirectObjectHolder();
@@ -69,6 +69,12 @@ class CPDF_IndirectObjectHolder {
     return byte_string_pool_;
   }
 
+  // The objects added, edited or deleted since they were parsed. Objects that
+  // were never parsed cannot have been edited, so they are not listed.
+  const CPDF_ModifiedObjects* GetModifiedObjects() const {
+    return modified_objects_.Get();
+  }
+
   const_iterator begin() const { return indirect_objs_.begin(); }
   const_iterator end() const { return indirect_objs_.end(); }
 
@@ -81,9 +87,13 @@ class CPDF_IndirectObjectHolder {
   const CPDF_Object* GetIndirectObjectInternal(uint32_t objnum) const;
   CPDF_Object* GetOrParseIndirectObjectInternal(uint32_t objnum);
 
+  // Makes edits to `obj` mark `objnum` as modified.
+  void TrackModifications(CPDF_Object* obj, uint32_t objnum);
+
   uint32_t last_obj_num_ = 0;
-  std::map<uint32_t, RetainPtr<CPDF_Object>> indirect_objs_;
+  PagedIndexMap<RetainPtr<CPDF_Object>> indirect_objs_;
   WeakPtr<ByteStringPool> byte_string_pool_;
+  RetainPtr<CPDF_ModifiedObjects> modified_objects_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_INDIRECT_OBJECT_HOLDER_H_
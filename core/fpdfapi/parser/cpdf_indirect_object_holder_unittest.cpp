@@ -6,7 +6,9 @@
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
 #include "core/fpdfapi/parser/cpdf_null.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fxcrt/check.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -90,3 +92,43 @@ TEST(IndirectObjectHolderTest, TemplateNewMethods) {
   EXPECT_TRUE(pDict->IsDictionary());
   EXPECT_TRUE(pArray->IsArray());
 }
+
+TEST(IndirectObjectHolderTest, TrackModifications) {
+  MockIndirectObjectHolder mock_holder;
+  EXPECT_CALL(mock_holder, ParseIndirectObject(::testing::_))
+      .WillRepeatedly(::testing::Invoke(
+          [&mock_holder](uint32_t objnum) -> RetainPtr<CPDF_Object> {
+            auto dict = mock_holder.New<CPDF_Dictionary>();
+            dict->SetNewFor<CPDF_Dictionary>("Inner");
+            return dict;
+          }));
+  const CPDF_ModifiedObjects* modified = mock_holder.GetModifiedObjects();
+
+  // Building objects while they are parsed is not an edit.
+  RetainPtr<CPDF_Dictionary> dict1 =
+      ToDictionary(mock_holder.GetOrParseIndirectObject(1));
+  RetainPtr<CPDF_Dictionary> dict2 =
+      ToDictionary(mock_holder.GetOrParseIndirectObject(2));
+  ASSERT_TRUE(dict1);
+  ASSERT_TRUE(dict2);
+  EXPECT_TRUE(modified->modified().empty());
+
+  // Editing a direct object marks the indirect object that holds it.
+  dict2->GetMutableDictFor("Inner")->SetNewFor<CPDF_Number>("Value", 1);
+  EXPECT_THAT(modified->modified(), ::testing::ElementsAre(2));
+
+  // New objects are modified.
+  auto array = mock_holder.NewIndirect<CPDF_Array>();
+  EXPECT_EQ(3u, array->GetObjNum());
+  EXPECT_THAT(modified->modified(), ::testing::ElementsAre(2, 3));
+
+  mock_holder.DeleteIndirectObject(2);
+  EXPECT_THAT(modified->modified(), ::testing::ElementsAre(3));
+  EXPECT_THAT(modified->deleted(), ::testing::ElementsAre(2));
+
+  // Replacing a deleted object is an edit.
+  EXPECT_TRUE(mock_holder.ReplaceIndirectObjectIfHigherGeneration(
+      2, pdfium::MakeRetain<CPDF_Null>()));
+  EXPECT_THAT(modified->modified(), ::testing::ElementsAre(2, 3));
+  EXPECT_TRUE(modified->deleted().empty());
+}
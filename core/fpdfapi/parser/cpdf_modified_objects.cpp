@@ -0,0 +1,53 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
+
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_object.h"
+
+CPDF_ModifiedObjects::CPDF_ModifiedObjects() = default;
+
+CPDF_ModifiedObjects::~CPDF_ModifiedObjects() = default;
+
+void CPDF_ModifiedObjects::MarkModified(uint32_t objnum) {
+  deleted_.erase(objnum);
+  modified_.insert(objnum);
+}
+
+void CPDF_ModifiedObjects::MarkDeleted(uint32_t objnum) {
+  modified_.erase(objnum);
+  deleted_.insert(objnum);
+}
+
+CPDF_ModificationOwner::CPDF_ModificationOwner() = default;
+
+CPDF_ModificationOwner::CPDF_ModificationOwner(
+    const CPDF_ModificationOwner& that) = default;
+
+CPDF_ModificationOwner::~CPDF_ModificationOwner() = default;
+
+CPDF_ModificationOwner& CPDF_ModificationOwner::operator=(
+    const CPDF_ModificationOwner& that) = default;
+
+void CPDF_ModificationOwner::Set(
+    RetainPtr<CPDF_ModifiedObjects> modified_objects,
+    uint32_t objnum) {
+  modified_objects_ = std::move(modified_objects);
+  objnum_ = objnum;
+}
+
+void CPDF_ModificationOwner::MarkModified() const {
+  if (modified_objects_) {
+    modified_objects_->MarkModified(objnum_);
+  }
+}
+
+void CPDF_ModificationOwner::MarkModifiedByChild(CPDF_Object* child) const {
+  if (modified_objects_) {
+    modified_objects_->MarkModified(objnum_);
+    child->SetModificationOwner(*this);
+  }
+}
@@ -0,0 +1,69 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_MODIFIED_OBJECTS_H_
+#define CORE_FPDFAPI_PARSER_CPDF_MODIFIED_OBJECTS_H_
+
+#include <stdint.h>
+
+#include <set>
+
+#include "core/fxcrt/retain_ptr.h"
+
+class CPDF_Object;
+
+// The indirect objects of a CPDF_IndirectObjectHolder that were added, edited
+// or deleted since they were loaded. Shared with the dictionaries, arrays and
+// streams in the holder, which report their own edits.
+class CPDF_ModifiedObjects final : public Retainable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  void MarkModified(uint32_t objnum);
+  void MarkDeleted(uint32_t objnum);
+
+  // A deleted object is no longer modified, and the other way around.
+  const std::set<uint32_t>& modified() const { return modified_; }
+  const std::set<uint32_t>& deleted() const { return deleted_; }
+
+ private:
+  CPDF_ModifiedObjects();
+  ~CPDF_ModifiedObjects() override;
+
+  std::set<uint32_t> modified_;
+  std::set<uint32_t> deleted_;
+};
+
+// Where a dictionary, array or stream reports its edits: the indirect object
+// that it is, or that it is part of.
+class CPDF_ModificationOwner {
+ public:
+  CPDF_ModificationOwner();
+  CPDF_ModificationOwner(const CPDF_ModificationOwner& that);
+  ~CPDF_ModificationOwner();
+
+  CPDF_ModificationOwner& operator=(const CPDF_ModificationOwner& that);
+
+  void Set(RetainPtr<CPDF_ModifiedObjects> modified_objects, uint32_t objnum);
+  bool IsSet() const { return !!modified_objects_; }
+
+  // Does nothing until Set() is called, so objects do not report the edits
+  // made while they are parsed or built.
+  void MarkModified() const;
+
+  // Same as MarkModified(), for an edit that adds `child`. Also makes `child`
+  // report its own later edits here.
+  void MarkModifiedByChild(CPDF_Object* child) const;
+
+  const RetainPtr<CPDF_ModifiedObjects>& modified_objects() const {
+    return modified_objects_;
+  }
+  uint32_t objnum() const { return objnum_; }
+
+ private:
+  RetainPtr<CPDF_ModifiedObjects> modified_objects_;
+  uint32_t objnum_ = 0;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_MODIFIED_OBJECTS_H_
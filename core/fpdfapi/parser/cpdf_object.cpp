@@ -93,6 +93,8 @@ void CPDF_Object::SetString(const ByteString& str) {
   NOTREACHED();
 }
 
+void CPDF_Object::SetModificationOwner(const CPDF_ModificationOwner& owner) {}
+
 CPDF_Array* CPDF_Object::AsMutableArray() {
   return nullptr;
 }
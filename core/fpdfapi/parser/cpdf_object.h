@@ -20,6 +20,7 @@ class CPDF_Boolean;
 class CPDF_Dictionary;
 class CPDF_Encryptor;
 class CPDF_IndirectObjectHolder;
+class CPDF_ModificationOwner;
 class CPDF_Name;
 class CPDF_Null;
 class CPDF_Number;
@@ -115,6 +116,11 @@ class CPDF_Object : public Retainable {
   virtual RetainPtr<CPDF_Reference> MakeReference(
       CPDF_IndirectObjectHolder* holder) const;
 
+  // Makes later edits to this object, and to the direct objects inside it,
+  // report to `owner`. Only dictionaries, arrays and streams can be edited
+  // after they are built, so other objects ignore this.
+  virtual void SetModificationOwner(const CPDF_ModificationOwner& owner);
+
   RetainPtr<const CPDF_Object> GetDirect() const;    // Wraps virtual method.
   RetainPtr<CPDF_Object> GetMutableDirect();         // Wraps virtual method.
   RetainPtr<const CPDF_Dictionary> GetDict() const;  // Wraps virtual method.
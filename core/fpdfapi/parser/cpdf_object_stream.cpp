@@ -94,6 +94,11 @@ RetainPtr<CPDF_Object> CPDF_ObjectStream::ParseObject(
   return result;
 }
 
+size_t CPDF_ObjectStream::GetMemorySize() const {
+  return sizeof(*this) + stream_acc_->GetSize() +
+         object_info_.capacity() * sizeof(ObjectInfo);
+}
+
 void CPDF_ObjectStream::Init(const CPDF_Stream* stream) {
   stream_acc_->LoadAllDataFiltered();
   data_stream_ =
@@ -5,6 +5,8 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_H_
 #define CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_H_
 
+#include <stddef.h>
+
 #include <memory>
 #include <vector>
 
@@ -43,6 +45,9 @@ class CPDF_ObjectStream {
                                      uint32_t archive_obj_index) const;
   const std::vector<ObjectInfo>& object_info() const { return object_info_; }
 
+  // Returns roughly how much memory the decoded stream takes.
+  size_t GetMemorySize() const;
+
  private:
   explicit CPDF_ObjectStream(RetainPtr<const CPDF_Stream> stream);
 
@@ -0,0 +1,74 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_stream_cache.h"
+
+#include <iterator>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fxcrt/check.h"
+
+CPDF_ObjectStreamCache::Entry::Entry(uint32_t obj_num,
+                                     std::unique_ptr<CPDF_ObjectStream> stream,
+                                     size_t bytes)
+    : obj_num(obj_num), stream(std::move(stream)), bytes(bytes) {}
+
+CPDF_ObjectStreamCache::Entry::~Entry() = default;
+
+CPDF_ObjectStreamCache::CPDF_ObjectStreamCache() = default;
+
+CPDF_ObjectStreamCache::~CPDF_ObjectStreamCache() = default;
+
+std::optional<const CPDF_ObjectStream*> CPDF_ObjectStreamCache::Get(
+    uint32_t obj_num) {
+  auto it = index_.find(obj_num);
+  if (it == index_.end()) {
+    ++miss_count_;
+    return std::nullopt;
+  }
+  ++hit_count_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->stream.get();
+}
+
+const CPDF_ObjectStream* CPDF_ObjectStreamCache::Add(
+    uint32_t obj_num,
+    std::unique_ptr<CPDF_ObjectStream> stream) {
+  auto it = index_.find(obj_num);
+  if (it != index_.end()) {
+    Remove(it->second);
+  }
+  const size_t bytes = stream ? stream->GetMemorySize() : 0;
+  const CPDF_ObjectStream* result = stream.get();
+  lru_.emplace_front(obj_num, std::move(stream), bytes);
+  index_[obj_num] = lru_.begin();
+  total_bytes_ += bytes;
+  Trim(/*keep_count=*/1);
+  return result;
+}
+
+void CPDF_ObjectStreamCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  Trim(/*keep_count=*/0);
+}
+
+void CPDF_ObjectStreamCache::Clear() {
+  lru_.clear();
+  index_.clear();
+  total_bytes_ = 0;
+}
+
+void CPDF_ObjectStreamCache::Trim(size_t keep_count) {
+  while (total_bytes_ > max_bytes_ && lru_.size() > keep_count) {
+    Remove(std::prev(lru_.end()));
+  }
+}
+
+void CPDF_ObjectStreamCache::Remove(EntryList::iterator it) {
+  DCHECK(total_bytes_ >= it->bytes);
+  total_bytes_ -= it->bytes;
+  index_.erase(it->obj_num);
+  lru_.erase(it);
+}
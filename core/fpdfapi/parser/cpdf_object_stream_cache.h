@@ -0,0 +1,80 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_CACHE_H_
+#define CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+
+class CPDF_ObjectStream;
+
+// Keeps decoded object streams, keyed by object number, up to a limit on the
+// memory their decoded data takes. When adding a stream goes over the limit,
+// the least recently used streams are dropped, so they have to be decoded
+// again the next time they are needed.
+class CPDF_ObjectStreamCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 32 * 1024 * 1024;
+
+  CPDF_ObjectStreamCache();
+  ~CPDF_ObjectStreamCache();
+
+  // Returns the entry for `obj_num` and marks it as most recently used, or
+  // returns nullopt if there is none. Counts as a hit or a miss. The entry is
+  // nullptr for a stream that failed to decode.
+  std::optional<const CPDF_ObjectStream*> Get(uint32_t obj_num);
+
+  // Adds `stream` for `obj_num`, replacing any existing entry, and returns it.
+  // `stream` may be nullptr, to remember that it failed to decode.
+  // The returned stream is never dropped by this call, even if it alone goes
+  // over the limit, so it stays valid until the next call to Add().
+  const CPDF_ObjectStream* Add(uint32_t obj_num,
+                               std::unique_ptr<CPDF_ObjectStream> stream);
+
+  // Drops streams as needed to stay within `max_bytes`.
+  void SetMaxBytes(size_t max_bytes);
+  size_t max_bytes() const { return max_bytes_; }
+
+  // Drops all streams. Keeps the counters.
+  void Clear();
+
+  size_t size() const { return lru_.size(); }
+  size_t total_bytes() const { return total_bytes_; }
+  uint64_t hit_count() const { return hit_count_; }
+  uint64_t miss_count() const { return miss_count_; }
+
+ private:
+  struct Entry {
+    Entry(uint32_t obj_num,
+          std::unique_ptr<CPDF_ObjectStream> stream,
+          size_t bytes);
+    ~Entry();
+
+    uint32_t obj_num;
+    std::unique_ptr<CPDF_ObjectStream> stream;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Drops least recently used streams until the total is within `max_bytes_`,
+  // keeping at least `keep_count` streams.
+  void Trim(size_t keep_count);
+  void Remove(EntryList::iterator it);
+
+  // Most recently used first.
+  EntryList lru_;
+  std::map<uint32_t, EntryList::iterator> index_;
+  size_t max_bytes_ = kDefaultMaxBytes;
+  size_t total_bytes_ = 0;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_CACHE_H_
@@ -0,0 +1,98 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_stream_cache.h"
+
+#include <memory>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr char kStreamContent[] = "10 0 11 14 12 21<</Name /Foo>>[1 2 3]4";
+
+std::unique_ptr<CPDF_ObjectStream> CreateObjectStream() {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Type", "ObjStm");
+  dict->SetNewFor<CPDF_Number>("N", 3);
+  dict->SetNewFor<CPDF_Number>("First", 16);
+
+  ByteStringView contents_view(kStreamContent);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(contents_view.begin(), contents_view.end()), dict);
+  return CPDF_ObjectStream::Create(std::move(stream));
+}
+
+}  // namespace
+
+TEST(ObjectStreamCacheTest, HitsAndMisses) {
+  CPDF_ObjectStreamCache cache;
+  EXPECT_FALSE(cache.Get(1).has_value());
+
+  auto stream = CreateObjectStream();
+  const CPDF_ObjectStream* stream_ptr = stream.get();
+  EXPECT_EQ(stream_ptr, cache.Add(1, std::move(stream)));
+  EXPECT_EQ(stream_ptr, cache.Get(1));
+  EXPECT_FALSE(cache.Get(2).has_value());
+
+  // A stream that failed to decode is remembered too.
+  EXPECT_FALSE(cache.Add(2, nullptr));
+  EXPECT_EQ(nullptr, cache.Get(2));
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(2u, cache.hit_count());
+  EXPECT_EQ(2u, cache.miss_count());
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(0u, cache.total_bytes());
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(3u, cache.miss_count());
+}
+
+TEST(ObjectStreamCacheTest, EvictsLeastRecentlyUsed) {
+  CPDF_ObjectStreamCache cache;
+  const size_t stream_bytes = CreateObjectStream()->GetMemorySize();
+  cache.SetMaxBytes(stream_bytes * 2);
+
+  cache.Add(1, CreateObjectStream());
+  cache.Add(2, CreateObjectStream());
+  EXPECT_EQ(stream_bytes * 2, cache.total_bytes());
+
+  // Make 1 the most recently used, so adding 3 drops 2.
+  EXPECT_TRUE(cache.Get(1).has_value());
+  cache.Add(3, CreateObjectStream());
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.Get(1).has_value());
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_TRUE(cache.Get(3).has_value());
+
+  // Lowering the limit drops streams right away.
+  cache.SetMaxBytes(stream_bytes);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_TRUE(cache.Get(3).has_value());
+  EXPECT_FALSE(cache.Get(1).has_value());
+}
+
+TEST(ObjectStreamCacheTest, KeepsNewestStreamOverLimit) {
+  CPDF_ObjectStreamCache cache;
+  cache.SetMaxBytes(0);
+
+  auto stream = CreateObjectStream();
+  const CPDF_ObjectStream* stream_ptr = stream.get();
+  EXPECT_EQ(stream_ptr, cache.Add(1, std::move(stream)));
+  EXPECT_EQ(1u, cache.size());
+
+  cache.Add(2, CreateObjectStream());
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_TRUE(cache.Get(2).has_value());
+}
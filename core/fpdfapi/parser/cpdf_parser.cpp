@@ -9,6 +9,8 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -28,14 +30,18 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/containers/contains.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
+#include "core/fxcrt/fx_parallel.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/notreached.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/scoped_set_insertion.h"
 #include "core/fxcrt/span.h"
 
@@ -160,11 +166,182 @@ class ObjectsHolderStub final : public CPDF_Parser::ParsedObjectsHolder {
   bool TryInit() override { return true; }
 };
 
+// RebuildCrossRef() parses objects on multiple threads ahead of its own scan
+// only for documents at least this big, as starting threads has a cost.
+constexpr FX_FILESIZE kMinParallelRebuildSize = 1024 * 1024;
+
+// The number of threads new parsers may use in RebuildCrossRef(). Shared by
+// all threads, as embedders set it for the whole process.
+std::atomic<size_t> g_default_rebuild_thread_count = 1;
+
+// What RebuildCrossRef() learns from the indirect object starting at `pos`.
+struct RebuildObjectInfo {
+  FX_FILESIZE pos = 0;
+  FX_FILESIZE end_pos = 0;
+  // Only set for cross-reference streams.
+  RetainPtr<CPDF_Dictionary> xref_dict;
+  uint32_t xref_obj_num = 0;
+  // The objects in the object stream, if the object is one.
+  std::vector<uint32_t> compressed_obj_nums;
+};
+
+// Reads file data that outlives it, and lets streams parsed from it refer to
+// that data instead of copying it.
+class ResidentDataStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override { return stream_->GetSize(); }
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override {
+    return stream_->ReadBlockAtOffset(buffer, offset);
+  }
+  pdfium::span<const uint8_t> GetResidentSpan() override { return data_; }
+
+ private:
+  explicit ResidentDataStream(pdfium::span<const uint8_t> data)
+      : data_(data),
+        stream_(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data)) {}
+  ~ResidentDataStream() override = default;
+
+  const pdfium::raw_span<const uint8_t> data_;
+  const RetainPtr<CFX_ReadOnlySpanStream> stream_;
+};
+
+RebuildObjectInfo ParseObjectForRebuild(CPDF_SyntaxParser* syntax,
+                                        FX_FILESIZE pos) {
+  RebuildObjectInfo result;
+  result.pos = pos;
+  syntax->SetPos(pos);
+  RetainPtr<CPDF_Stream> stream = ToStream(syntax->GetIndirectObject(
+      nullptr, CPDF_SyntaxParser::ParseType::kStrict));
+  result.end_pos = syntax->GetPos();
+  if (!stream) {
+    return result;
+  }
+
+  if (stream->GetDict()->GetNameFor("Type") == "XRef") {
+    result.xref_dict = ToDictionary(stream->GetDict()->Clone());
+    result.xref_obj_num = stream->GetObjNum();
+  }
+  const auto object_stream = CPDF_ObjectStream::Create(std::move(stream));
+  if (object_stream) {
+    for (const auto& info : object_stream->object_info()) {
+      result.compressed_obj_nums.push_back(info.obj_num);
+    }
+  }
+  return result;
+}
+
+// Returns the offset of "N G obj" in `data`, given the offset of its "obj"
+// keyword, or nullopt if the keyword is not preceded by two numbers.
+std::optional<size_t> GetObjectHeaderStart(pdfium::span<const uint8_t> data,
+                                           size_t keyword_pos) {
+  size_t pos = keyword_pos;
+  for (int i = 0; i < 2; ++i) {
+    const size_t whitespace_end = pos;
+    while (pos > 0 && PDFCharIsWhitespace(data[pos - 1])) {
+      --pos;
+    }
+    const size_t digits_end = pos;
+    while (pos > 0 && FXSYS_IsDecimalDigit(static_cast<char>(data[pos - 1]))) {
+      --pos;
+    }
+    if (pos == whitespace_end || pos == digits_end) {
+      return std::nullopt;
+    }
+  }
+  if (pos > 0 && !PDFCharIsWhitespace(data[pos - 1]) &&
+      !PDFCharIsDelimiter(data[pos - 1])) {
+    return std::nullopt;
+  }
+  return pos;
+}
+
+// Returns the offsets of what look like object headers whose "obj" keyword
+// starts within `data[begin, end)`, in increasing order.
+std::vector<size_t> FindObjectHeaders(pdfium::span<const uint8_t> data,
+                                      size_t begin,
+                                      size_t end) {
+  static constexpr uint8_t kKeyword[] = {'o', 'b', 'j'};
+  std::vector<size_t> result;
+  auto it = data.begin() + begin;
+  const auto last =
+      data.begin() + std::min(end + std::size(kKeyword) - 1, data.size());
+  while ((it = std::search(it, last, std::begin(kKeyword),
+                           std::end(kKeyword))) != last) {
+    const size_t keyword_pos = static_cast<size_t>(it - data.begin());
+    const size_t keyword_end = keyword_pos + std::size(kKeyword);
+    ++it;
+    if (keyword_end < data.size() &&
+        !PDFCharIsWhitespace(data[keyword_end]) &&
+        !PDFCharIsDelimiter(data[keyword_end])) {
+      continue;
+    }
+    std::optional<size_t> header_start =
+        GetObjectHeaderStart(data, keyword_pos);
+    if (header_start.has_value()) {
+      result.push_back(header_start.value());
+    }
+  }
+  return result;
+}
+
+// Parses the objects whose headers are found in the resident `file_data` on
+// multiple threads, the way RebuildCrossRef() would. Each thread takes one part
+// of the file, and skips the headers inside the objects it has already parsed,
+// as RebuildCrossRef() does. This keeps the work proportional to the file size
+// when strings or streams contain many "obj" keywords. The results are sorted
+// by position. Each thread uses its own stream, validator and syntax parser, as
+// none of them can be shared between threads.
+std::vector<RebuildObjectInfo> ParseObjectsForRebuild(
+    pdfium::span<const uint8_t> file_data,
+    FX_FILESIZE header_offset,
+    uint32_t read_buffer_size,
+    size_t thread_count) {
+  const size_t doc_start = pdfium::checked_cast<size_t>(header_offset);
+  const size_t chunk_size =
+      (file_data.size() - doc_start + thread_count - 1) / thread_count;
+  std::vector<std::vector<RebuildObjectInfo>> chunk_results(thread_count);
+  fxcrt::RunOnThreads(thread_count, [&](size_t index) {
+    const size_t begin =
+        std::min(doc_start + index * chunk_size, file_data.size());
+    const size_t end = std::min(begin + chunk_size, file_data.size());
+    CPDF_SyntaxParser syntax(
+        pdfium::MakeRetain<CPDF_ReadValidator>(
+            pdfium::MakeRetain<ResidentDataStream>(file_data), nullptr),
+        header_offset);
+    syntax.SetReadBufferSize(read_buffer_size);
+    FX_FILESIZE parsed_end = 0;
+    for (size_t header : FindObjectHeaders(file_data, begin, end)) {
+      if (header < doc_start) {
+        continue;
+      }
+      const FX_FILESIZE pos =
+          pdfium::checked_cast<FX_FILESIZE>(header) - header_offset;
+      if (pos < parsed_end) {
+        continue;
+      }
+      RebuildObjectInfo info = ParseObjectForRebuild(&syntax, pos);
+      parsed_end = std::max(parsed_end, info.end_pos);
+      chunk_results[index].push_back(std::move(info));
+    }
+  });
+
+  std::vector<RebuildObjectInfo> results;
+  for (auto& objects : chunk_results) {
+    std::move(objects.begin(), objects.end(), std::back_inserter(results));
+  }
+  return results;
+}
+
 }  // namespace
 
 CPDF_Parser::CPDF_Parser(ParsedObjectsHolder* holder)
     : objects_holder_(holder),
-      cross_ref_table_(std::make_unique<CPDF_CrossRefTable>()) {
+      cross_ref_table_(std::make_unique<CPDF_CrossRefTable>()),
+      rebuild_thread_count_(g_default_rebuild_thread_count) {
   if (!holder) {
     owned_objects_holder_ = std::make_unique<ObjectsHolderStub>();
     objects_holder_ = owned_objects_holder_.get();
@@ -175,10 +352,15 @@ CPDF_Parser::CPDF_Parser() : CPDF_Parser(nullptr) {}
 
 CPDF_Parser::~CPDF_Parser() = default;
 
+// static
+void CPDF_Parser::SetDefaultRebuildThreadCount(size_t count) {
+  g_default_rebuild_thread_count = count;
+}
+
 uint32_t CPDF_Parser::GetLastObjNum() const {
   return cross_ref_table_->objects_info().empty()
              ? 0
-             : cross_ref_table_->objects_info().rbegin()->first;
+             : cross_ref_table_->objects_info().last_key();
 }
 
 bool CPDF_Parser::IsValidObjectNumber(uint32_t objnum) const {
@@ -196,6 +378,11 @@ bool CPDF_Parser::IsObjectFree(uint32_t objnum) const {
   return !info || info->type == ObjectType::kFree;
 }
 
+uint16_t CPDF_Parser::GetObjectGenNum(uint32_t objnum) const {
+  const auto* info = cross_ref_table_->GetObjectInfo(objnum);
+  return info ? info->gennum : 0;
+}
+
 bool CPDF_Parser::InitSyntaxParser(RetainPtr<CPDF_ReadValidator> validator) {
   const std::optional<FX_FILESIZE> header_offset = GetHeaderOffset(validator);
   if (!header_offset.has_value()) {
@@ -465,7 +652,7 @@ bool CPDF_Parser::LoadAllCrossRefTablesAndStreams(FX_FILESIZE xref_offset) {
   }
 
   if (is_xref_stream) {
-    object_stream_map_.clear();
+    object_stream_cache_.Clear();
     xref_stream_ = true;
   }
 
@@ -760,6 +947,22 @@ bool CPDF_Parser::RebuildCrossRef() {
   syntax_->SetReadBufferSize(kBufferSize);
   syntax_->SetPos(0);
 
+  // When the whole file is in memory, parse the objects it appears to contain
+  // on multiple threads first. The scan below still decides which of them
+  // count and in what order, so the result is the same as a serial rebuild.
+  std::vector<RebuildObjectInfo> parsed_objects;
+  if (rebuild_thread_count_ > 1 &&
+      syntax_->GetDocumentSize() >= kMinParallelRebuildSize) {
+    pdfium::span<const uint8_t> file_data =
+        syntax_->GetValidator()->GetResidentSpan();
+    if (!file_data.empty()) {
+      parsed_objects = ParseObjectsForRebuild(
+          file_data, syntax_->GetHeaderOffset(), kBufferSize,
+          rebuild_thread_count_);
+    }
+  }
+  auto next_parsed_object = parsed_objects.begin();
+
   std::vector<std::pair<uint32_t, FX_FILESIZE>> numbers;
   for (CPDF_SyntaxParser::WordResult result = syntax_->GetNextWord();
        !result.word.IsEmpty(); result = syntax_->GetNextWord()) {
@@ -797,30 +1000,34 @@ bool CPDF_Parser::RebuildCrossRef() {
       const uint32_t obj_num = numbers[0].first;
       const uint32_t gen_num = numbers[1].first;
 
-      syntax_->SetPos(obj_pos);
-      RetainPtr<CPDF_Stream> pStream = ToStream(syntax_->GetIndirectObject(
-          nullptr, CPDF_SyntaxParser::ParseType::kStrict));
-
-      if (pStream && pStream->GetDict()->GetNameFor("Type") == "XRef") {
+      // The scan only moves forward, so the objects parsed in advance are
+      // visited in order.
+      next_parsed_object = std::lower_bound(
+          next_parsed_object, parsed_objects.end(), obj_pos,
+          [](const RebuildObjectInfo& info, FX_FILESIZE pos) {
+            return info.pos < pos;
+          });
+      RebuildObjectInfo object =
+          next_parsed_object != parsed_objects.end() &&
+                  next_parsed_object->pos == obj_pos
+              ? std::move(*next_parsed_object)
+              : ParseObjectForRebuild(syntax_.get(), obj_pos);
+      syntax_->SetPos(object.end_pos);
+
+      if (object.xref_dict) {
         cross_ref_table = CPDF_CrossRefTable::MergeUp(
             std::move(cross_ref_table),
-            std::make_unique<CPDF_CrossRefTable>(
-                ToDictionary(pStream->GetDict()->Clone()),
-                pStream->GetObjNum()));
+            std::make_unique<CPDF_CrossRefTable>(std::move(object.xref_dict),
+                                                 object.xref_obj_num));
       }
 
       if (obj_num < kMaxObjectNumber) {
         cross_ref_table->AddNormal(obj_num, gen_num, /*is_object_stream=*/false,
                                    obj_pos);
-        const auto object_stream =
-            CPDF_ObjectStream::Create(std::move(pStream));
-        if (object_stream) {
-          const auto& object_info = object_stream->object_info();
-          for (size_t i = 0; i < object_info.size(); ++i) {
-            const auto& info = object_info[i];
-            if (info.obj_num < kMaxObjectNumber) {
-              cross_ref_table->AddCompressed(info.obj_num, obj_num, i);
-            }
+        for (size_t i = 0; i < object.compressed_obj_nums.size(); ++i) {
+          const uint32_t compressed_obj_num = object.compressed_obj_nums[i];
+          if (compressed_obj_num < kMaxObjectNumber) {
+            cross_ref_table->AddCompressed(compressed_obj_num, obj_num, i);
           }
         }
       }
@@ -1022,6 +1229,10 @@ RetainPtr<const CPDF_Dictionary> CPDF_Parser::GetEncryptDict() const {
   return nullptr;
 }
 
+RetainPtr<CPDF_ReadValidator> CPDF_Parser::GetValidator() const {
+  return syntax_ ? syntax_->GetValidator() : nullptr;
+}
+
 ByteString CPDF_Parser::GetEncodedPassword() const {
   return GetSecurityHandler()->GetEncodedPassword(GetPassword().AsStringView());
 }
@@ -1103,9 +1314,10 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
     return nullptr;
   }
 
-  auto it = object_stream_map_.find(object_number);
-  if (it != object_stream_map_.end()) {
-    return it->second.get();
+  std::optional<const CPDF_ObjectStream*> cached =
+      object_stream_cache_.Get(object_number);
+  if (cached.has_value()) {
+    return cached.value();
   }
 
   const auto* info = cross_ref_table_->GetObjectInfo(object_number);
@@ -1127,12 +1339,8 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
     return nullptr;
   }
 
-  std::unique_ptr<CPDF_ObjectStream> objs_stream =
-      CPDF_ObjectStream::Create(ToStream(object));
-  const CPDF_ObjectStream* result = objs_stream.get();
-  object_stream_map_[object_number] = std::move(objs_stream);
-
-  return result;
+  return object_stream_cache_.Add(object_number,
+                                  CPDF_ObjectStream::Create(ToStream(object)));
 }
 
 RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObjectAt(FX_FILESIZE pos,
@@ -1305,7 +1513,7 @@ bool CPDF_Parser::LoadLinearizedAllCrossRefStream(
       return false;
     }
   }
-  object_stream_map_.clear();
+  object_stream_cache_.Clear();
   xref_stream_ = true;
   return true;
 }
@@ -1323,7 +1531,7 @@ CPDF_Parser::Error CPDF_Parser::LoadLinearizedMainXRefTable() {
 
   const AutoRestorer<uint32_t> save_metadata_objnum(&metadata_objnum_);
   metadata_objnum_ = 0;
-  object_stream_map_.clear();
+  object_stream_cache_.Clear();
 
   if (!LoadLinearizedAllCrossRefTable(main_xref_offset) &&
       !LoadLinearizedAllCrossRefStream(main_xref_offset)) {
@@ -1389,7 +1597,18 @@ std::vector<unsigned int> CPDF_Parser::GetTrailerEnds() {
 
 bool CPDF_Parser::WriteToArchive(IFX_ArchiveStream* archive,
                                  FX_FILESIZE src_size) {
-  static constexpr FX_FILESIZE kBufferSize = 4096;
+  // Copy resident file data in one piece.
+  pdfium::span<const uint8_t> resident_data =
+      syntax_->GetValidator()->GetResidentSpan();
+  FX_SAFE_SIZE_T src_end = syntax_->GetHeaderOffset();
+  src_end += src_size;
+  if (src_end.IsValid() && src_end.ValueOrDie() <= resident_data.size()) {
+    return archive->WriteBlock(resident_data.subspan(
+        static_cast<size_t>(syntax_->GetHeaderOffset()),
+        static_cast<size_t>(src_size)));
+  }
+
+  static constexpr FX_FILESIZE kBufferSize = 64 * 1024;
   DataVector<uint8_t> buffer(kBufferSize);
   syntax_->SetPos(0);
   while (src_size) {
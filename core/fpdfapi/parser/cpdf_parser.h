@@ -11,13 +11,13 @@
 #include <stdint.h>
 
 #include <limits>
-#include <map>
 #include <memory>
 #include <set>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_object_stream_cache.h"
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_types.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -58,6 +58,10 @@ class CPDF_Parser {
 
   static constexpr size_t kInvalidPos = std::numeric_limits<size_t>::max();
 
+  // Sets how many threads parsers created afterwards may use to rebuild the
+  // cross-reference table of big in-memory files. Defaults to 1.
+  static void SetDefaultRebuildThreadCount(size_t count);
+
   explicit CPDF_Parser(ParsedObjectsHolder* holder);
   CPDF_Parser();
   ~CPDF_Parser();
@@ -69,6 +73,10 @@ class CPDF_Parser {
 
   ByteString GetPassword() const { return password_; }
 
+  // Returns the validator in front of the stream being parsed, or nullptr if
+  // parsing has not started.
+  RetainPtr<CPDF_ReadValidator> GetValidator() const;
+
   // Take the GetPassword() value and encode it, if necessary, based on the
   // password encoding conversion.
   ByteString GetEncodedPassword() const;
@@ -97,6 +105,8 @@ class CPDF_Parser {
     return security_handler_;
   }
   bool IsObjectFree(uint32_t objnum) const;
+  // The generation of `objnum` in the cross-reference table, or 0.
+  uint16_t GetObjectGenNum(uint32_t objnum) const;
 
   int GetFileVersion() const { return file_version_; }
   bool IsXRefStream() const { return xref_stream_; }
@@ -109,6 +119,15 @@ class CPDF_Parser {
 
   bool xref_table_rebuilt() const { return xref_table_rebuilt_; }
 
+  // Decoded object streams, which are kept while they fit in the cache's
+  // memory limit.
+  CPDF_ObjectStreamCache* object_stream_cache() {
+    return &object_stream_cache_;
+  }
+  const CPDF_ObjectStreamCache* object_stream_cache() const {
+    return &object_stream_cache_;
+  }
+
   std::vector<unsigned int> GetTrailerEnds();
   bool WriteToArchive(IFX_ArchiveStream* archive, FX_FILESIZE src_size);
 
@@ -118,6 +137,10 @@ class CPDF_Parser {
 
   CPDF_Dictionary* GetMutableTrailerForTesting();
 
+  void SetRebuildThreadCountForTesting(size_t count) {
+    rebuild_thread_count_ = count;
+  }
+
   RetainPtr<CPDF_Object> ParseIndirectObjectAtForTesting(FX_FILESIZE pos) {
     return ParseIndirectObjectAt(pos, 0);
   }
@@ -194,11 +217,12 @@ class CPDF_Parser {
   // ownership of the ID array data.
   std::unique_ptr<CPDF_CrossRefTable> cross_ref_table_;
   FX_FILESIZE last_xref_offset_ = 0;
+  // The number of threads RebuildCrossRef() may use for big in-memory files.
+  size_t rebuild_thread_count_;
   ByteString password_;
   std::unique_ptr<CPDF_LinearizedHeader> linearized_;
 
-  // A map of object numbers to indirect streams.
-  std::map<uint32_t, std::unique_ptr<CPDF_ObjectStream>> object_stream_map_;
+  CPDF_ObjectStreamCache object_stream_cache_;
 
   // All indirect object numbers that are being parsed.
   std::set<uint32_t> parsing_obj_nums_;
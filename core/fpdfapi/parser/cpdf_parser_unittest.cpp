@@ -17,6 +17,8 @@
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/cfx_read_only_vector_stream.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -130,6 +132,14 @@ class CPDF_TestParser final : public CPDF_Parser {
     return InitTestFromBufferWithOffset(buffer, 0 /*header_offset*/);
   }
 
+  // Setup reading from a buffer that stays in memory, like a mapped file.
+  bool InitTestFromResidentBuffer(DataVector<uint8_t> buffer) {
+    SetSyntaxParserForTesting(CPDF_SyntaxParser::CreateForTesting(
+        pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(buffer)),
+        0 /*header_offset*/));
+    return true;
+  }
+
   // Expose protected CPDF_Parser methods for testing.
   using CPDF_Parser::LoadCrossRefTable;
   using CPDF_Parser::ParseLinearizedHeader;
@@ -177,6 +187,72 @@ TEST(ParserTest, RebuildCrossRefFailed) {
   ASSERT_FALSE(parser.RebuildCrossRef());
 }
 
+TEST(ParserTest, RebuildCrossRefInParallel) {
+  std::string data = "%PDF-1.7\n";
+  for (int i = 1; i <= 3000; ++i) {
+    // The strings look like object headers, but are not.
+    data += std::to_string(i) + " 0 obj\n<</Index " + std::to_string(i) +
+            " /Name (" + std::to_string(i + 3000) + " 0 obj)>>\nendobj\n";
+  }
+  data += "7 1 obj\n<</Generation 1>>\nendobj\n";
+  data += "7 0 obj\n<</Generation 0>>\nendobj\n";
+
+  const std::string object_stream_header = "4000 0 4001 2 ";
+  const std::string object_stream_data = object_stream_header + "1 2";
+  data += "5000 0 obj\n<</Type /ObjStm /N 2 /First " +
+          std::to_string(object_stream_header.size()) + " /Length " +
+          std::to_string(object_stream_data.size()) + ">>\nstream\n" +
+          object_stream_data + "\nendstream\nendobj\n";
+  data +=
+      "6000 0 obj\n<</Type /XRef /Size 6001 /Root 1 0 R /W [1 1 1] "
+      "/Length 3>>\nstream\n123\nendstream\nendobj\n";
+
+  // Make the file big enough for RebuildCrossRef() to parse objects on
+  // multiple threads. The stream data is full of what look like object
+  // headers, which must not be parsed as objects.
+  std::string filler;
+  while (filler.size() < 1024 * 1024) {
+    filler += "9 0 obj\n<</Fake true>>\nendobj\n";
+  }
+  data += "7000 0 obj\n<</Length " + std::to_string(filler.size()) +
+          ">>\nstream\n" + filler + "\nendstream\nendobj\n";
+  data += "8000 0 obj\n<</Last true>>\nendobj\n";
+  data += "trailer\n<</Root 1 0 R /Size 8001>>\n";
+
+  CPDF_TestParser serial_parser;
+  serial_parser.SetRebuildThreadCountForTesting(1);
+  ASSERT_TRUE(serial_parser.InitTestFromResidentBuffer(
+      DataVector<uint8_t>(data.begin(), data.end())));
+  ASSERT_TRUE(serial_parser.RebuildCrossRef());
+
+  CPDF_TestParser parallel_parser;
+  parallel_parser.SetRebuildThreadCountForTesting(4);
+  ASSERT_TRUE(parallel_parser.InitTestFromResidentBuffer(
+      DataVector<uint8_t>(data.begin(), data.end())));
+  ASSERT_TRUE(parallel_parser.RebuildCrossRef());
+
+  const CPDF_CrossRefTable* serial_table =
+      serial_parser.GetCrossRefTableForTesting();
+  const CPDF_CrossRefTable* parallel_table =
+      parallel_parser.GetCrossRefTableForTesting();
+  EXPECT_EQ(serial_table->objects_info(), parallel_table->objects_info());
+  EXPECT_EQ(serial_table->trailer_object_number(),
+            parallel_table->trailer_object_number());
+
+  EXPECT_EQ(3006u, parallel_table->objects_info().size());
+  EXPECT_EQ(1u, GetObjInfo(parallel_parser, 7).gennum);
+  EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kFree,
+            GetObjInfo(parallel_parser, 3001).type);
+  const CPDF_CrossRefTable::ObjectInfo compressed_info =
+      GetObjInfo(parallel_parser, 4001);
+  ASSERT_EQ(CPDF_CrossRefTable::ObjectType::kCompressed,
+            compressed_info.type);
+  EXPECT_EQ(5000u, compressed_info.archive.obj_num);
+  EXPECT_EQ(1u, compressed_info.archive.obj_index);
+  EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kNormal,
+            GetObjInfo(parallel_parser, 8000).type);
+}
+
 TEST(ParserTest, LoadCrossRefTable) {
   {
     static const unsigned char kXrefTable[] =
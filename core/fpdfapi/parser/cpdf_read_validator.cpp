@@ -87,6 +87,14 @@ FX_FILESIZE CPDF_ReadValidator::GetSize() {
   return file_size_;
 }
 
+pdfium::span<const uint8_t> CPDF_ReadValidator::GetResidentSpan() {
+  pdfium::span<const uint8_t> resident_data = file_read_->GetResidentSpan();
+  if (resident_data.empty() || !IsWholeFileAvailable()) {
+    return {};
+  }
+  return resident_data;
+}
+
 void CPDF_ReadValidator::ScheduleDownload(FX_FILESIZE offset, size_t size) {
   has_unavailable_data_ = true;
   if (!hints_ || size == 0) {
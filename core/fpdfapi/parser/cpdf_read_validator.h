@@ -39,6 +39,9 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
     return read_error() || has_unavailable_data();
   }
 
+  // Returns the underlying stream, which does no availability checks.
+  RetainPtr<IFX_SeekableReadStream> GetFileRead() const { return file_read_; }
+
   void ResetErrors();
   bool IsWholeFileAvailable();
   bool CheckDataRangeAndRequestIfUnavailable(FX_FILESIZE offset, size_t size);
@@ -48,6 +51,9 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                          FX_FILESIZE offset) override;
   FX_FILESIZE GetSize() override;
+  // Only exposes the underlying stream's resident data once the whole file is
+  // available, so reads through the span never skip download requests.
+  pdfium::span<const uint8_t> GetResidentSpan() override;
 
  protected:
   CPDF_ReadValidator(RetainPtr<IFX_SeekableReadStream> file_read,
@@ -261,6 +261,14 @@ TEST_F(CPDFSecurityHandlerEmbedderTest, OwnerPasswordVersion2UTF8) {
   VerifySavedModifiedHelloWorldDocumentWithPassword(kAgeUTF8);
 }
 
+TEST_F(CPDFSecurityHandlerEmbedderTest, SaveWithObjectStreams) {
+  OpenAndVerifyHelloWorldDocumentWithPassword("encrypted_hello_world_r3.pdf",
+                                              kAgeUTF8);
+  EXPECT_TRUE(FPDF_SaveWithObjectStreams(document(), this, 0, 0));
+  VerifySavedHelloWorldDocumentWithPassword(kAgeLatin1);
+  VerifySavedHelloWorldDocumentWithPassword(kHotelLatin1);
+}
+
 TEST_F(CPDFSecurityHandlerEmbedderTest, OwnerPasswordVersion2Latin1) {
   // The same password encoded as Latin-1 also works at revision 2.
   OpenAndVerifyHelloWorldDocumentWithPassword("encrypted_hello_world_r2.pdf",
@@ -90,9 +90,15 @@ void CPDF_Stream::InitStreamFromFile(RetainPtr<IFX_SeekableReadStream> file) {
   const int size = pdfium::checked_cast<int>(file->GetSize());
   data_ = std::move(file);
   dict_ = pdfium::MakeRetain<CPDF_Dictionary>();
+  owner_.MarkModifiedByChild(dict_.Get());
   SetLengthInDict(size);
 }
 
+void CPDF_Stream::SetModificationOwner(const CPDF_ModificationOwner& owner) {
+  owner_ = owner;
+  dict_->SetModificationOwner(owner);
+}
+
 RetainPtr<CPDF_Object> CPDF_Stream::Clone() const {
   return CloneObjectNonCyclic(false);
 }
@@ -138,6 +144,7 @@ void CPDF_Stream::SetData(pdfium::span<const uint8_t> pData) {
 void CPDF_Stream::TakeData(DataVector<uint8_t> data) {
   const int size = pdfium::checked_cast<int>(data.size());
   data_ = std::move(data);
+  owner_.MarkModified();
   SetLengthInDict(size);
 }
 
@@ -178,16 +185,35 @@ bool CPDF_Stream::WriteTo(IFX_ArchiveStream* archive,
                           const CPDF_Encryptor* encryptor) const {
   const bool is_metadata = IsMetaDataStreamDictionary(GetDict().Get());
   CPDF_FlateEncoder encoder(pdfium::WrapRetain(this), !is_metadata);
+  return WriteEncoderTo(&encoder, /*encrypt_data=*/!is_metadata, archive,
+                        encryptor);
+}
+
+bool CPDF_Stream::IsFlateEncodedOnWrite() const {
+  return !HasFilter() && !IsMetaDataStreamDictionary(GetDict().Get());
+}
 
+bool CPDF_Stream::WriteEncodedTo(IFX_ArchiveStream* archive,
+                                 const CPDF_Encryptor* encryptor,
+                                 DataVector<uint8_t> encoded_data) const {
+  CHECK(IsFlateEncodedOnWrite());
+  CPDF_FlateEncoder encoder(pdfium::WrapRetain(this), std::move(encoded_data));
+  return WriteEncoderTo(&encoder, /*encrypt_data=*/true, archive, encryptor);
+}
+
+bool CPDF_Stream::WriteEncoderTo(CPDF_FlateEncoder* encoder,
+                                 bool encrypt_data,
+                                 IFX_ArchiveStream* archive,
+                                 const CPDF_Encryptor* encryptor) const {
   DataVector<uint8_t> encrypted_data;
-  pdfium::span<const uint8_t> data = encoder.GetSpan();
-  if (encryptor && !is_metadata) {
+  pdfium::span<const uint8_t> data = encoder->GetSpan();
+  if (encryptor && encrypt_data) {
     encrypted_data = encryptor->Encrypt(data);
     data = encrypted_data;
   }
 
-  encoder.UpdateLength(data.size());
-  if (!encoder.WriteDictTo(archive, encryptor)) {
+  encoder->UpdateLength(data.size());
+  if (!encoder->WriteDictTo(archive, encryptor)) {
     return false;
   }
 
@@ -215,6 +241,13 @@ pdfium::span<const uint8_t> CPDF_Stream::GetInMemoryRawData() const {
   return std::get<DataVector<uint8_t>>(data_);
 }
 
+pdfium::span<const uint8_t> CPDF_Stream::GetResidentRawData() const {
+  if (IsMemoryBased()) {
+    return GetInMemoryRawData();
+  }
+  return std::get<RetainPtr<IFX_SeekableReadStream>>(data_)->GetResidentSpan();
+}
+
 void CPDF_Stream::SetLengthInDict(int length) {
   dict_->SetNewFor<CPDF_Number>("Length", length);
 }
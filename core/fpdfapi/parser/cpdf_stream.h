@@ -13,11 +13,13 @@
 #include <set>
 #include <variant>
 
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_string_wrappers.h"
 #include "core/fxcrt/retain_ptr.h"
 
+class CPDF_FlateEncoder;
 class IFX_SeekableReadStream;
 
 class CPDF_Stream final : public CPDF_Object {
@@ -33,12 +35,27 @@ class CPDF_Stream final : public CPDF_Object {
   CPDF_Stream* AsMutableStream() override;
   bool WriteTo(IFX_ArchiveStream* archive,
                const CPDF_Encryptor* encryptor) const override;
+  void SetModificationOwner(const CPDF_ModificationOwner& owner) override;
+
+  // Whether WriteTo() compresses the data with Flate, which it does for
+  // unfiltered streams other than XML metadata.
+  bool IsFlateEncodedOnWrite() const;
+
+  // Same as WriteTo(), with `encoded_data` being the data already compressed
+  // by CPDF_FlateEncoder::Encode(). Requires IsFlateEncodedOnWrite().
+  bool WriteEncodedTo(IFX_ArchiveStream* archive,
+                      const CPDF_Encryptor* encryptor,
+                      DataVector<uint8_t> encoded_data) const;
 
   size_t GetRawSize() const;
   // Can only be called when stream is memory-based.
   // This is meant to be used by CPDF_StreamAcc only.
   // Other callers should use CPDF_StreamAcc to access data in all cases.
   pdfium::span<const uint8_t> GetInMemoryRawData() const;
+  // Returns the raw data when it can be referenced without copying: the data
+  // of a memory-based stream, or the resident data of a file-based stream.
+  // Returns an empty span otherwise. Also meant for CPDF_StreamAcc only.
+  pdfium::span<const uint8_t> GetResidentRawData() const;
 
   // Copies span or stream into internally-owned buffer.
   void SetData(pdfium::span<const uint8_t> pData);
@@ -67,6 +84,11 @@ class CPDF_Stream final : public CPDF_Object {
  private:
   friend class CPDF_Dictionary;
 
+  bool WriteEncoderTo(CPDF_FlateEncoder* encoder,
+                      bool encrypt_data,
+                      IFX_ArchiveStream* archive,
+                      const CPDF_Encryptor* encryptor) const;
+
   // Initializes with empty data and /Length set to 0 in `dict`.
   // `dict` must be non-null and be a direct object.
   explicit CPDF_Stream(RetainPtr<CPDF_Dictionary> dict);
@@ -95,6 +117,7 @@ class CPDF_Stream final : public CPDF_Object {
 
   std::variant<RetainPtr<IFX_SeekableReadStream>, DataVector<uint8_t>> data_;
   RetainPtr<CPDF_Dictionary> dict_;
+  CPDF_ModificationOwner owner_;
 };
 
 inline CPDF_Stream* ToStream(CPDF_Object* obj) {
@@ -79,8 +79,8 @@ pdfium::span<const uint8_t> CPDF_StreamAcc::GetSpan() const {
   if (is_owned()) {
     return std::get<DataVector<uint8_t>>(data_);
   }
-  if (stream_ && stream_->IsMemoryBased()) {
-    return stream_->GetInMemoryRawData();
+  if (stream_) {
+    return stream_->GetResidentRawData();
   }
   return {};
 }
@@ -108,8 +108,9 @@ void CPDF_StreamAcc::ProcessRawData() {
     return;
   }
 
-  if (stream_->IsMemoryBased()) {
-    data_ = stream_->GetInMemoryRawData();
+  pdfium::span<const uint8_t> resident_data = stream_->GetResidentRawData();
+  if (!resident_data.empty()) {
+    data_ = resident_data;
     return;
   }
 
@@ -129,9 +130,8 @@ void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
   }
 
   std::variant<pdfium::raw_span<const uint8_t>, DataVector<uint8_t>> src_data;
-  pdfium::span<const uint8_t> src_span;
-  if (stream_->IsMemoryBased()) {
-    src_span = stream_->GetInMemoryRawData();
+  pdfium::span<const uint8_t> src_span = stream_->GetResidentRawData();
+  if (!src_span.empty()) {
     src_data = src_span;
   } else {
     DataVector<uint8_t> temp_src_data = ReadRawStream();
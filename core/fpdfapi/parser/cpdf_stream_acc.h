@@ -53,7 +53,8 @@ class CPDF_StreamAcc final : public Retainable {
   void ProcessRawData();
   void ProcessFilteredData(uint32_t estimated_size, bool bImageAcc);
 
-  // Returns the raw data from `stream_`, or no data on failure.
+  // Copies the raw data from `stream_` when it cannot be borrowed. Returns no
+  // data on failure.
   DataVector<uint8_t> ReadRawStream() const;
 
   bool is_owned() const {
@@ -9,6 +9,8 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/cfx_read_only_vector_stream.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_stream.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/invalid_seekable_read_stream.h"
@@ -34,3 +36,18 @@ TEST(StreamAccTest, DataStreamLifeTime) {
   EXPECT_TRUE(
       std::equal(std::begin(kData), std::end(kData), span.begin(), span.end()));
 }
+
+TEST(StreamAccTest, ResidentFileDataNotCopied) {
+  auto file = pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(
+      DataVector<uint8_t>{'a', 'b', 'c'});
+  const uint8_t* file_data = file->GetResidentSpan().data();
+  auto stream = pdfium::MakeRetain<CPDF_Stream>(
+      std::move(file), pdfium::MakeRetain<CPDF_Dictionary>());
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  stream_acc->LoadAllDataFiltered();
+  EXPECT_EQ(file_data, stream_acc->GetSpan().data());
+  EXPECT_EQ(3u, stream_acc->GetSize());
+
+  DataVector<uint8_t> detached = stream_acc->DetachData();
+  EXPECT_EQ(pdfium::span(detached), stream_acc->GetSpan());
+}
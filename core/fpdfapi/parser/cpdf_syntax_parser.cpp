@@ -7,7 +7,9 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 
 #include <algorithm>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_boolean.h"
@@ -20,6 +22,7 @@
 #include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
+#include "core/fpdfapi/parser/fpdf_parser_scan.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
 #include "core/fxcrt/cfx_read_only_vector_stream.h"
@@ -30,6 +33,7 @@
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/stl_util.h"
 
 namespace {
 
@@ -68,6 +72,15 @@ class ReadableSubStream final : public IFX_SeekableReadStream {
 
   FX_FILESIZE GetSize() override { return part_size_; }
 
+  pdfium::span<const uint8_t> GetResidentSpan() override {
+    pdfium::span<const uint8_t> resident_data = file_read_->GetResidentSpan();
+    if (resident_data.empty()) {
+      return {};
+    }
+    return resident_data.subspan(static_cast<size_t>(part_offset_),
+                                 static_cast<size_t>(part_size_));
+  }
+
  private:
   RetainPtr<IFX_SeekableReadStream> file_read_;
   FX_FILESIZE part_offset_;
@@ -77,7 +90,7 @@ class ReadableSubStream final : public IFX_SeekableReadStream {
 }  // namespace
 
 // static
-int CPDF_SyntaxParser::s_CurrentRecursionDepth = 0;
+thread_local int CPDF_SyntaxParser::s_CurrentRecursionDepth = 0;
 
 // static
 std::unique_ptr<CPDF_SyntaxParser> CPDF_SyntaxParser::CreateForTesting(
@@ -115,6 +128,16 @@ bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
   if (read_pos >= file_len_) {
     return false;
   }
+
+  // Reference resident file data directly rather than copying blocks of it.
+  pdfium::span<const uint8_t> resident_data = file_access_->GetResidentSpan();
+  if (resident_data.size() == static_cast<size_t>(file_len_)) {
+    buf_view_ = resident_data;
+    buf_offset_ = 0;
+    file_buf_.clear();
+    return true;
+  }
+
   size_t read_size = read_buffer_size_;
   FX_SAFE_FILESIZE safe_end = read_pos;
   safe_end += read_size;
@@ -122,12 +145,14 @@ bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
     read_size = file_len_ - read_pos;
   }
 
+  buf_view_ = {};
   file_buf_.resize(read_size);
   if (!file_access_->ReadBlockAtOffset(file_buf_, read_pos)) {
     file_buf_.clear();
     return false;
   }
 
+  buf_view_ = file_buf_;
   buf_offset_ = read_pos;
   return true;
 }
@@ -142,11 +167,24 @@ bool CPDF_SyntaxParser::GetNextChar(uint8_t& ch) {
     return false;
   }
 
-  ch = file_buf_[pos - buf_offset_];
+  ch = buf_view_[pos - buf_offset_];
   pos_++;
   return true;
 }
 
+pdfium::span<const uint8_t> CPDF_SyntaxParser::GetBufferedData() {
+  FX_FILESIZE pos = pos_ + header_offset_;
+  if (pos >= file_len_) {
+    return {};
+  }
+
+  if (!IsPositionRead(pos) && !ReadBlockAt(pos)) {
+    return {};
+  }
+
+  return buf_view_.subspan(static_cast<size_t>(pos - buf_offset_));
+}
+
 FX_FILESIZE CPDF_SyntaxParser::GetDocumentSize() const {
   return file_len_ - header_offset_;
 }
@@ -166,7 +204,7 @@ bool CPDF_SyntaxParser::GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch) {
       return false;
     }
   }
-  *ch = file_buf_[pos - buf_offset_];
+  *ch = buf_view_[pos - buf_offset_];
   return true;
 }
 
@@ -193,20 +231,8 @@ CPDF_SyntaxParser::WordType CPDF_SyntaxParser::GetNextWordInternal() {
 
     word_buffer_[word_size_++] = ch;
     if (ch == '/') {
-      while (true) {
-        if (!GetNextChar(ch)) {
-          return word_type;
-        }
-
-        if (!PDFCharIsOther(ch) && !PDFCharIsNumeric(ch)) {
-          pos_--;
-          return word_type;
-        }
-
-        if (word_size_ < sizeof(word_buffer_) - 1) {
-          word_buffer_[word_size_++] = ch;
-        }
-      }
+      bool is_number = false;
+      ReadRestOfWord(&is_number);
     } else if (ch == '<') {
       if (!GetNextChar(ch)) {
         return word_type;
@@ -231,25 +257,32 @@ CPDF_SyntaxParser::WordType CPDF_SyntaxParser::GetNextWordInternal() {
     return word_type;
   }
 
-  while (true) {
-    if (word_size_ < sizeof(word_buffer_) - 1) {
-      word_buffer_[word_size_++] = ch;
-    }
+  bool is_number = PDFCharIsNumeric(ch);
+  word_buffer_[word_size_++] = ch;
+  ReadRestOfWord(&is_number);
+  return is_number ? WordType::kNumber : WordType::kWord;
+}
 
-    if (!PDFCharIsNumeric(ch)) {
-      word_type = WordType::kWord;
+void CPDF_SyntaxParser::ReadRestOfWord(bool* is_number) {
+  while (true) {
+    pdfium::span<const uint8_t> data = GetBufferedData();
+    if (data.empty()) {
+      return;
     }
 
-    if (!GetNextChar(ch)) {
-      return word_type;
-    }
+    const size_t length = PDFScanWord(data, is_number);
+    const size_t copy_length =
+        std::min<size_t>(length, sizeof(word_buffer_) - 1 - word_size_);
+    fxcrt::Copy(data.first(copy_length),
+                pdfium::span(word_buffer_).subspan(word_size_));
+    word_size_ += copy_length;
+    pos_ += length;
 
-    if (PDFCharIsDelimiter(ch) || PDFCharIsWhitespace(ch)) {
-      pos_--;
-      break;
+    // Keep going if the word may continue in the next block.
+    if (length < data.size()) {
+      return;
     }
   }
-  return word_type;
 }
 
 ByteString CPDF_SyntaxParser::ReadString() {
@@ -402,32 +435,29 @@ void CPDF_SyntaxParser::ToNextWord() {
     return;
   }
 
-  uint8_t ch;
-  if (!GetNextChar(ch)) {
-    return;
-  }
-
   while (true) {
-    while (PDFCharIsWhitespace(ch)) {
-      if (!GetNextChar(ch)) {
-        return;
-      }
+    pdfium::span<const uint8_t> data = GetBufferedData();
+    if (data.empty()) {
+      return;
     }
 
-    if (ch != '%') {
-      break;
+    const size_t length = PDFScanWhitespace(data);
+    pos_ += length;
+    if (length == data.size()) {
+      continue;
     }
 
-    while (true) {
+    if (data[length] != '%') {
+      return;
+    }
+
+    uint8_t ch;
+    do {
       if (!GetNextChar(ch)) {
         return;
       }
-      if (PDFCharIsLineEnding(ch)) {
-        break;
-      }
-    }
+    } while (!PDFCharIsLineEnding(ch));
   }
-  pos_--;
 }
 
 // A state machine which goes % -> E -> O -> F -> line ending.
@@ -605,8 +635,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
         pool_, PDF_NameDecode(ByteStringView(word_span).Substr(1)));
   }
   if (word == "<<") {
-    RetainPtr<CPDF_Dictionary> pDict =
-        pdfium::MakeRetain<CPDF_Dictionary>(pool_);
+    std::vector<CPDF_Dictionary::Entry> entries;
     while (true) {
       WordResult inner_word_result = GetNextWord();
       const ByteString& inner_word = inner_word_result.word;
@@ -646,10 +675,14 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
       // `key` has to be "/X" at the minimum.
       // `pObj` cannot be a stream, per ISO 32000-1:2008 section 7.3.8.1.
       if (key.GetLength() > 1 && !pObj->IsStream()) {
-        pDict->SetFor(key.Substr(1), std::move(pObj));
+        entries.emplace_back(key.Substr(1), std::move(pObj));
       }
     }
 
+    RetainPtr<CPDF_Dictionary> pDict =
+        pdfium::MakeRetain<CPDF_Dictionary>(pool_);
+    pDict->SetEntries(std::move(entries));
+
     AutoRestorer<FX_FILESIZE> pos_restorer(&pos_);
     if (GetNextWord().word != "stream") {
       return pDict;
@@ -853,7 +886,15 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
   }
 
   RetainPtr<CPDF_Stream> stream;
-  if (substream) {
+  RetainPtr<IFX_SeekableReadStream> file = GetValidator()->GetFileRead();
+  if (substream && !file->GetResidentSpan().empty()) {
+    // The file owns its resident data, so `stream` can keep referencing the
+    // file bytes without holding on to the validator.
+    substream = pdfium::MakeRetain<ReadableSubStream>(
+        std::move(file), header_offset_ + streamStartPos, len);
+    stream = pdfium::MakeRetain<CPDF_Stream>(std::move(substream),
+                                             std::move(pDict));
+  } else if (substream) {
     // It is unclear from CPDF_SyntaxParser's perspective what object
     // `substream` is ultimately holding references to. To avoid unexpectedly
     // changing object lifetimes by handing `substream` to `stream`, make a
@@ -980,6 +1021,21 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
   DCHECK_GT(taglen, 0);
 
   while (true) {
+    // Skip to the first match within the buffered data. A match that may
+    // extend past it is checked byte by byte below.
+    pdfium::span<const uint8_t> data = GetBufferedData();
+    if (data.empty()) {
+      return -1;
+    }
+    std::optional<size_t> found = PDFFindTag(data, tag);
+    if (found.has_value()) {
+      pos_ += found.value() + taglen;
+      return GetPos() - taglen - startpos;
+    }
+    if (data.size() >= static_cast<size_t>(taglen)) {
+      pos_ += data.size() - taglen + 1;
+    }
+
     const FX_FILESIZE match_start_pos = GetPos();
     bool match_found = true;
 
@@ -1007,5 +1063,5 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
 
 bool CPDF_SyntaxParser::IsPositionRead(FX_FILESIZE pos) const {
   return buf_offset_ <= pos &&
-         pos < static_cast<FX_FILESIZE>(buf_offset_ + file_buf_.size());
+         pos < static_cast<FX_FILESIZE>(buf_offset_ + buf_view_.size());
 }
@@ -16,6 +16,7 @@
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_types.h"
+#include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/string_pool_template.h"
@@ -80,6 +81,7 @@ class CPDF_SyntaxParser {
   // All offsets was readed from document, should not be great than document
   // size. Use it for checks instead of real file size.
   FX_FILESIZE GetDocumentSize() const;
+  FX_FILESIZE GetHeaderOffset() const { return header_offset_; }
 
   ByteString ReadString();
   DataVector<uint8_t> ReadHexString();
@@ -95,11 +97,19 @@ class CPDF_SyntaxParser {
   friend class cpdf_syntax_parser_ReadHexString_Test;
 
   static constexpr int kParserMaxRecursionDepth = 64;
-  static int s_CurrentRecursionDepth;
+  static thread_local int s_CurrentRecursionDepth;
 
   bool ReadBlockAt(FX_FILESIZE read_pos);
+  // Returns the data from the current position to the end of the block it is
+  // in, reading the block if needed. Empty at the end of the file or if the
+  // block cannot be read.
+  pdfium::span<const uint8_t> GetBufferedData();
   bool GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch);
   WordType GetNextWordInternal();
+  // Appends the rest of the current word, starting at `pos_`, to
+  // `word_buffer_` and moves past it. Clears `*is_number` if it has any
+  // non-numeric characters.
+  void ReadRestOfWord(bool* is_number);
   bool IsWholeWord(FX_FILESIZE startpos,
                    FX_FILESIZE limit,
                    ByteStringView tag,
@@ -125,6 +135,8 @@ class CPDF_SyntaxParser {
   FX_FILESIZE pos_ = 0;
   WeakPtr<ByteStringPool> pool_;
   DataVector<uint8_t> file_buf_;
+  // Views either `file_buf_`, or the whole file when its data is resident.
+  pdfium::raw_span<const uint8_t> buf_view_;
   FX_FILESIZE buf_offset_ = 0;
   uint32_t word_size_ = 0;
   uint32_t read_buffer_size_ = CPDF_Stream::kFileBufSize;
@@ -7,6 +7,7 @@
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/fx_extension.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -147,3 +148,44 @@ TEST(SyntaxParserTest, PeekNextWord) {
   EXPECT_EQ("WORD", parser.PeekNextWord());
   EXPECT_EQ("WORD", parser.GetNextWord().word);
 }
+
+TEST(SyntaxParserTest, WordsAcrossReadBlocks) {
+  static const char data[] =
+      "  /AVeryLongNameThatSpansSeveralBlocks 12345678901234567890\n"
+      "%a comment\r\n                      1.5 endobj";
+  for (uint32_t block_size : {1u, 3u, 16u, 512u}) {
+    CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+        ByteStringView(data).unsigned_span()));
+    parser.SetReadBufferSize(block_size);
+
+    CPDF_SyntaxParser::WordResult result = parser.GetNextWord();
+    EXPECT_EQ("/AVeryLongNameThatSpansSeveralBlocks", result.word);
+    EXPECT_FALSE(result.is_number);
+
+    result = parser.GetNextWord();
+    EXPECT_EQ("12345678901234567890", result.word);
+    EXPECT_TRUE(result.is_number);
+
+    result = parser.GetNextWord();
+    EXPECT_EQ("1.5", result.word);
+    EXPECT_TRUE(result.is_number);
+
+    result = parser.GetNextWord();
+    EXPECT_EQ("endobj", result.word);
+    EXPECT_FALSE(result.is_number);
+
+    EXPECT_EQ("", parser.GetNextWord().word);
+  }
+}
+
+TEST(SyntaxParserTest, FindTagAcrossReadBlocks) {
+  static const char data[] = "stream data endstrea endstream endobj";
+  for (uint32_t block_size : {1u, 3u, 16u, 512u}) {
+    CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+        ByteStringView(data).unsigned_span()));
+    parser.SetReadBufferSize(block_size);
+    EXPECT_EQ(21, parser.FindTag("endstream"));
+    EXPECT_EQ(30, parser.GetPos());
+    EXPECT_EQ(-1, parser.FindTag("endstream"));
+  }
+}
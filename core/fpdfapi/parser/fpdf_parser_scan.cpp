@@ -0,0 +1,240 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/fpdf_parser_scan.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "build/build_config.h"
+#include "core/fpdfapi/parser/fpdf_parser_utility.h"
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/compiler_specific.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define PDF_SCAN_USE_BLOCKS
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#define PDF_SCAN_USE_BLOCKS
+#endif
+
+namespace {
+
+constexpr size_t kScalarPrefix = 16;
+
+#if defined(PDF_SCAN_USE_BLOCKS)
+
+constexpr size_t kBlockSize = 16;
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+using Block = __m128i;
+
+// The caller ensures that `data` has at least kBlockSize bytes.
+Block LoadBlock(pdfium::span<const uint8_t> data) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data()));
+}
+
+Block And(Block a, Block b) {
+  return _mm_and_si128(a, b);
+}
+
+Block Or(Block a, Block b) {
+  return _mm_or_si128(a, b);
+}
+
+Block Equals(Block block, uint8_t ch) {
+  return _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(ch)));
+}
+
+// Matches bytes in [`low`, `high`].
+Block InRange(Block block, uint8_t low, uint8_t high) {
+  const Block offset =
+      _mm_sub_epi8(block, _mm_set1_epi8(static_cast<char>(low)));
+  return _mm_cmpeq_epi8(
+      _mm_min_epu8(offset, _mm_set1_epi8(static_cast<char>(high - low))),
+      offset);
+}
+
+// Returns `kBitsPerLane` bits for each byte of `mask`, in order starting with
+// the lowest bits. They are all set for bytes that matched.
+constexpr int kBitsPerLane = 1;
+constexpr uint64_t kAllLanes = 0xffff;
+
+uint64_t ToBits(Block mask) {
+  return static_cast<uint32_t>(_mm_movemask_epi8(mask));
+}
+
+#elif defined(ARCH_CPU_ARM64)
+
+using Block = uint8x16_t;
+
+// The caller ensures that `data` has at least kBlockSize bytes.
+Block LoadBlock(pdfium::span<const uint8_t> data) {
+  return vld1q_u8(data.data());
+}
+
+Block And(Block a, Block b) {
+  return vandq_u8(a, b);
+}
+
+Block Or(Block a, Block b) {
+  return vorrq_u8(a, b);
+}
+
+Block Equals(Block block, uint8_t ch) {
+  return vceqq_u8(block, vdupq_n_u8(ch));
+}
+
+// Matches bytes in [`low`, `high`].
+Block InRange(Block block, uint8_t low, uint8_t high) {
+  return vcleq_u8(vsubq_u8(block, vdupq_n_u8(low)), vdupq_n_u8(high - low));
+}
+
+// Returns `kBitsPerLane` bits for each byte of `mask`, in order starting with
+// the lowest bits. They are all set for bytes that matched.
+constexpr int kBitsPerLane = 4;
+constexpr uint64_t kAllLanes = ~uint64_t{0};
+
+uint64_t ToBits(Block mask) {
+  return vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0);
+}
+
+#endif
+
+size_t FirstLane(uint64_t bits) {
+  return std::countr_zero(bits) / kBitsPerLane;
+}
+
+// NUL, TAB, LF, FF, CR, SPACE, 0x80 and 0xff. See kPDFCharTypes.
+Block IsWhitespace(Block block) {
+  return Or(Or(Or(Equals(block, 0x00), Equals(block, '\t')),
+               Or(Equals(block, '\n'), Equals(block, '\f'))),
+            Or(Or(Equals(block, '\r'), Equals(block, ' ')),
+               Or(Equals(block, 0x80), Equals(block, 0xff))));
+}
+
+Block IsDelimiter(Block block) {
+  return Or(Or(Or(Equals(block, '%'), Equals(block, '/')),
+               Or(Equals(block, '('), Equals(block, ')'))),
+            Or(Or(Or(Equals(block, '<'), Equals(block, '>')),
+                  Or(Equals(block, '['), Equals(block, ']'))),
+               Or(Equals(block, '{'), Equals(block, '}'))));
+}
+
+Block IsNumeric(Block block) {
+  return Or(Or(InRange(block, '0', '9'), Equals(block, '.')),
+            Or(Equals(block, '+'), Equals(block, '-')));
+}
+
+#endif  // defined(PDF_SCAN_USE_BLOCKS)
+
+}  // namespace
+
+size_t PDFScanWhitespace(pdfium::span<const uint8_t> data) {
+  // Most runs are short, and loading blocks for them costs more than checking
+  // a few bytes, so check the first ones one at a time.
+  const size_t prefix = std::min(data.size(), kScalarPrefix);
+  size_t i = 0;
+  for (; i < prefix; ++i) {
+    if (!PDFCharIsWhitespace(data[i])) {
+      return i;
+    }
+  }
+#if defined(PDF_SCAN_USE_BLOCKS)
+  for (; data.size() - i >= kBlockSize; i += kBlockSize) {
+    const uint64_t other =
+        ~ToBits(IsWhitespace(LoadBlock(data.subspan(i)))) & kAllLanes;
+    if (other) {
+      return i + FirstLane(other);
+    }
+  }
+#endif
+  while (i < data.size() && PDFCharIsWhitespace(data[i])) {
+    ++i;
+  }
+  return i;
+}
+
+size_t PDFScanWord(pdfium::span<const uint8_t> data, bool* is_number) {
+  const size_t prefix = std::min(data.size(), kScalarPrefix);
+  size_t i = 0;
+  for (; i < prefix; ++i) {
+    const uint8_t type = GetPDFCharTypeFromArray(data[i]);
+    if (type == 'W' || type == 'D') {
+      return i;
+    }
+    if (type != 'N') {
+      *is_number = false;
+    }
+  }
+#if defined(PDF_SCAN_USE_BLOCKS)
+  for (; data.size() - i >= kBlockSize; i += kBlockSize) {
+    const Block block = LoadBlock(data.subspan(i));
+    const uint64_t end = ToBits(Or(IsWhitespace(block), IsDelimiter(block)));
+    uint64_t word = kAllLanes;
+    if (end) {
+      // Keep the lanes before the first end of word.
+      word = (end & (~end + 1)) - 1;
+    }
+    if (*is_number && (~ToBits(IsNumeric(block)) & word)) {
+      *is_number = false;
+    }
+    if (end) {
+      return i + FirstLane(end);
+    }
+  }
+#endif
+  for (; i < data.size(); ++i) {
+    const uint8_t type = GetPDFCharTypeFromArray(data[i]);
+    if (type == 'W' || type == 'D') {
+      break;
+    }
+    if (type != 'N') {
+      *is_number = false;
+    }
+  }
+  return i;
+}
+
+std::optional<size_t> PDFFindTag(pdfium::span<const uint8_t> data,
+                                 ByteStringView tag) {
+  const size_t tag_length = tag.GetLength();
+  DCHECK_GT(tag_length, 0u);
+  if (data.size() < tag_length) {
+    return std::nullopt;
+  }
+
+  // The last offset where `tag` fits.
+  const size_t last = data.size() - tag_length;
+  size_t i = 0;
+#if defined(PDF_SCAN_USE_BLOCKS)
+  // Look for the first and the last byte of `tag` at the same time, so that
+  // few candidates need a full comparison.
+  const uint8_t first_byte = tag[0];
+  const uint8_t last_byte = tag[tag_length - 1];
+  for (; last - i >= kBlockSize; i += kBlockSize) {
+    uint64_t candidates =
+        ToBits(And(Equals(LoadBlock(data.subspan(i)), first_byte),
+                   Equals(LoadBlock(data.subspan(i + tag_length - 1)),
+                          last_byte)));
+    while (candidates) {
+      const size_t lane = FirstLane(candidates);
+      if (ByteStringView(data.subspan(i + lane, tag_length)) == tag) {
+        return i + lane;
+      }
+      candidates &= ~(((uint64_t{1} << kBitsPerLane) - 1)
+                      << (lane * kBitsPerLane));
+    }
+  }
+#endif
+  for (; i <= last; ++i) {
+    if (ByteStringView(data.subspan(i, tag_length)) == tag) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
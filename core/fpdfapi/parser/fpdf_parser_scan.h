@@ -0,0 +1,34 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_FPDF_PARSER_SCAN_H_
+#define CORE_FPDFAPI_PARSER_FPDF_PARSER_SCAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/span.h"
+
+// Scanners for runs of the character classes in fpdf_parser_utility.h. Where
+// SSE2 or NEON is available, they classify 16 bytes at a time. The results are
+// the same as looping over the bytes with the PDFCharIs*() functions.
+
+// Returns the length of the run of whitespace at the start of `data`.
+size_t PDFScanWhitespace(pdfium::span<const uint8_t> data);
+
+// Returns the length of the run at the start of `data` of characters that are
+// neither whitespace nor delimiters, i.e. the rest of a word or a name. Sets
+// `*is_number` to false if any of them is not numeric, and leaves it alone
+// otherwise.
+size_t PDFScanWord(pdfium::span<const uint8_t> data, bool* is_number);
+
+// Returns the offset of the first occurrence of `tag` in `data`, if any.
+// `tag` must not be empty.
+std::optional<size_t> PDFFindTag(pdfium::span<const uint8_t> data,
+                                 ByteStringView tag);
+
+#endif  // CORE_FPDFAPI_PARSER_FPDF_PARSER_SCAN_H_
@@ -0,0 +1,117 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/fpdf_parser_scan.h"
+
+#include <vector>
+
+#include "core/fpdfapi/parser/fpdf_parser_utility.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+size_t ScanWhitespaceByByte(pdfium::span<const uint8_t> data) {
+  size_t i = 0;
+  while (i < data.size() && PDFCharIsWhitespace(data[i])) {
+    ++i;
+  }
+  return i;
+}
+
+size_t ScanWordByByte(pdfium::span<const uint8_t> data, bool* is_number) {
+  size_t i = 0;
+  while (i < data.size() && !PDFCharIsWhitespace(data[i]) &&
+         !PDFCharIsDelimiter(data[i])) {
+    if (!PDFCharIsNumeric(data[i])) {
+      *is_number = false;
+    }
+    ++i;
+  }
+  return i;
+}
+
+}  // namespace
+
+TEST(ParserScanTest, EveryByteValue) {
+  // Put each byte value after runs of every length up to 40 bytes, so it is
+  // found in each lane of a block and in the scalar tail.
+  for (int value = 0; value < 256; ++value) {
+    const uint8_t ch = static_cast<uint8_t>(value);
+    for (size_t run = 0; run <= 40; ++run) {
+      std::vector<uint8_t> spaces(run, ' ');
+      spaces.push_back(ch);
+      spaces.push_back('a');
+      EXPECT_EQ(ScanWhitespaceByByte(spaces), PDFScanWhitespace(spaces))
+          << value << " after " << run;
+
+      std::vector<uint8_t> digits(run, '7');
+      digits.push_back(ch);
+      digits.push_back(' ');
+      bool expected_is_number = true;
+      bool is_number = true;
+      EXPECT_EQ(ScanWordByByte(digits, &expected_is_number),
+                PDFScanWord(digits, &is_number))
+          << value << " after " << run;
+      EXPECT_EQ(expected_is_number, is_number) << value << " after " << run;
+    }
+  }
+}
+
+TEST(ParserScanTest, ScanWhitespace) {
+  EXPECT_EQ(0u, PDFScanWhitespace({}));
+  EXPECT_EQ(0u, PDFScanWhitespace(ByteStringView("a  ").unsigned_span()));
+  EXPECT_EQ(3u, PDFScanWhitespace(ByteStringView("\r\n\ta").unsigned_span()));
+  EXPECT_EQ(20u, PDFScanWhitespace(
+                     ByteStringView("                    ").unsigned_span()));
+}
+
+TEST(ParserScanTest, ScanWord) {
+  bool is_number = true;
+  EXPECT_EQ(0u, PDFScanWord({}, &is_number));
+  EXPECT_TRUE(is_number);
+
+  EXPECT_EQ(6u,
+            PDFScanWord(ByteStringView("-12.50 0 m").unsigned_span(),
+                        &is_number));
+  EXPECT_TRUE(is_number);
+
+  EXPECT_EQ(2u, PDFScanWord(ByteStringView("Tf/F1").unsigned_span(),
+                            &is_number));
+  EXPECT_FALSE(is_number);
+
+  // Non-numeric characters after the end of the word do not count.
+  is_number = true;
+  EXPECT_EQ(17u,
+            PDFScanWord(ByteStringView("12345678901234567 abc").unsigned_span(),
+                        &is_number));
+  EXPECT_TRUE(is_number);
+
+  // An earlier non-numeric word is not forgotten.
+  is_number = false;
+  EXPECT_EQ(1u, PDFScanWord(ByteStringView("1(").unsigned_span(), &is_number));
+  EXPECT_FALSE(is_number);
+}
+
+TEST(ParserScanTest, FindTag) {
+  EXPECT_FALSE(PDFFindTag({}, "endobj").has_value());
+  EXPECT_FALSE(
+      PDFFindTag(ByteStringView("endob").unsigned_span(), "endobj").has_value());
+  EXPECT_EQ(0u, PDFFindTag(ByteStringView("endobj").unsigned_span(), "endobj"));
+  EXPECT_EQ(1u, PDFFindTag(ByteStringView("ax").unsigned_span(), "x"));
+
+  // Find the first match, past partial matches, at every offset.
+  for (size_t offset = 0; offset < 50; ++offset) {
+    ByteString data = "endstrea ";
+    for (size_t i = 0; i < offset; ++i) {
+      data += 'e';
+    }
+    data += "endstream endstream";
+    EXPECT_EQ(offset + 9, PDFFindTag(data.unsigned_span(), "endstream"));
+    EXPECT_FALSE(PDFFindTag(data.First(offset + 17).unsigned_span(),
+                            "endstream")
+                     .has_value());
+  }
+}
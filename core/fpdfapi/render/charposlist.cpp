@@ -6,9 +6,12 @@
 
 #include "core/fpdfapi/render/charposlist.h"
 
+#include <utility>
+
 #include "build/build_config.h"
 #include "core/fpdfapi/font/cpdf_cidfont.h"
 #include "core/fpdfapi/font/cpdf_font.h"
+#include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/cfx_substfont.h"
@@ -204,3 +207,18 @@ std::vector<TextCharPos> GetCharPosList(pdfium::span<const uint32_t> char_codes,
 
   return results;
 }
+
+pdfium::span<const TextCharPos> GetTextObjectCharPosList(
+    CPDF_TextObject* text_obj) {
+  RetainPtr<CPDF_Font> font = text_obj->GetFont();
+  const float font_size = text_obj->GetFontSize();
+  CPDF_TextObject::CharPosCache& cache = text_obj->char_pos_cache();
+  if (cache.font != font || cache.font_size != font_size) {
+    cache.char_pos_list =
+        GetCharPosList(text_obj->GetCharCodes(), text_obj->GetCharPositions(),
+                       font.Get(), font_size);
+    cache.font = std::move(font);
+    cache.font_size = font_size;
+  }
+  return cache.char_pos_list;
+}
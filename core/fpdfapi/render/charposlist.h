@@ -14,6 +14,7 @@
 #include "core/fxcrt/span.h"
 
 class CPDF_Font;
+class CPDF_TextObject;
 class TextCharPos;
 
 std::vector<TextCharPos> GetCharPosList(pdfium::span<const uint32_t> char_codes,
@@ -21,4 +22,10 @@ std::vector<TextCharPos> GetCharPosList(pdfium::span<const uint32_t> char_codes,
                                         CPDF_Font* font,
                                         float font_size);
 
+// Returns GetCharPosList() for the text in `text_obj` and its current font and
+// font size. The result is kept in `text_obj` and reused by later calls until
+// any of those change.
+pdfium::span<const TextCharPos> GetTextObjectCharPosList(
+    CPDF_TextObject* text_obj);
+
 #endif  // CORE_FPDFAPI_RENDER_CHARPOSLIST_H_
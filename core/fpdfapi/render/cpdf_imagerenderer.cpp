@@ -70,13 +70,24 @@ bool CPDF_ImageRenderer::StartLoadDIBBase() {
     return false;
   }
 
+  // The image needs no more pixels than it covers on the device along its own
+  // edges, which also works when rotated, nor more than fit in the clip box.
+  const FX_RECT clip_box = render_status_->GetRenderDevice()->GetClipBox();
+  const float max_extent =
+      static_cast<float>(std::max(clip_box.Width(), clip_box.Height()));
+  auto get_extent = [max_extent](float x, float y) {
+    // In this order, NaN gives `max_extent`.
+    const float extent = std::min(max_extent, hypotf(x, y));
+    return std::max(1, static_cast<int>(ceilf(extent)));
+  };
+  const CFX_Size max_size_required(
+      get_extent(image_matrix_.a, image_matrix_.b),
+      get_extent(image_matrix_.c, image_matrix_.d));
   if (!loader_->Start(
           image_object_, render_status_->GetContext()->GetPageCache(),
           render_status_->GetFormResource(), render_status_->GetPageResource(),
           std_cs_, render_status_->GetGroupFamily(),
-          render_status_->GetLoadMask(),
-          {render_status_->GetRenderDevice()->GetWidth(),
-           render_status_->GetRenderDevice()->GetHeight()})) {
+          render_status_->GetLoadMask(), max_size_required, GetNeededRect())) {
     return false;
   }
   mode_ = Mode::kDefault;
@@ -657,6 +668,19 @@ std::optional<FX_RECT> CPDF_ImageRenderer::GetUnitRect() const {
   return image_rect;
 }
 
+CFX_FloatRect CPDF_ImageRenderer::GetNeededRect() const {
+  CFX_FloatRect needed_rect(0, 0, 1, 1);
+  if (image_matrix_.a * image_matrix_.d == image_matrix_.b * image_matrix_.c) {
+    return needed_rect;
+  }
+
+  CFX_FloatRect clip_box(render_status_->GetRenderDevice()->GetClipBox());
+  // Resampling at the edges of the clip box looks just beyond them.
+  clip_box.Inflate(1, 1);
+  needed_rect.Intersect(image_matrix_.GetInverse().TransformRect(clip_box));
+  return needed_rect;
+}
+
 bool CPDF_ImageRenderer::GetDimensionsFromUnitRect(const FX_RECT& rect,
                                                    int* left,
                                                    int* top,
@@ -83,6 +83,8 @@ class CPDF_ImageRenderer {
       const FX_RECT& rect) const;
   const CPDF_RenderOptions& GetRenderOptions() const;
   std::optional<FX_RECT> GetUnitRect() const;
+  // Returns the part of the image's unit square that is within the clip box.
+  CFX_FloatRect GetNeededRect() const;
   bool GetDimensionsFromUnitRect(const FX_RECT& rect,
                                  int* left,
                                  int* top,
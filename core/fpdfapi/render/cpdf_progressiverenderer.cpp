@@ -6,6 +6,9 @@
 
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "build/build_config.h"
 #include "core/fpdfapi/page/cpdf_image.h"
 #include "core/fpdfapi/page/cpdf_imageobject.h"
@@ -60,8 +63,11 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
           current_layer_->GetObjectHolder()->GetTransparency());
       render_status_->Initialize(nullptr, nullptr);
       device_->SaveState();
-      clip_rect_ = current_layer_->GetMatrix().GetInverse().TransformRect(
-          CFX_FloatRect(device_->GetClipBox()));
+      clip_rect_ = CPDF_RenderStatus::GetObjectCullingRect(
+          device_, current_layer_->GetMatrix());
+      visible_object_indices_ =
+          current_layer_->GetObjectHolder()->GetPageObjectIndicesInRect(
+              clip_rect_);
     }
     CPDF_PageObjectHolder::const_iterator iter;
     CPDF_PageObjectHolder::const_iterator iterEnd =
@@ -72,6 +78,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     } else {
       iter = current_layer_->GetObjectHolder()->begin();
     }
+    iter = SkipCulledObjects(iter);
     int nObjsToGo = kStepLimit;
     bool is_mask = false;
     while (iter != iterEnd) {
@@ -116,6 +123,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         nObjsToGo = kStepLimit;
       }
       ++iter;
+      iter = SkipCulledObjects(iter);
       if (is_mask && iter != iterEnd) {
         return;
       }
@@ -125,6 +133,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
       render_status_.reset();
       device_->RestoreState(false);
       current_layer_ = nullptr;
+      visible_object_indices_.reset();
       layer_index_++;
       if (is_mask || (pPause && pPause->NeedToPauseNow())) {
         return;
@@ -140,3 +149,19 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     }
   }
 }
+
+CPDF_PageObjectHolder::const_iterator
+CPDF_ProgressiveRenderer::SkipCulledObjects(
+    CPDF_PageObjectHolder::const_iterator iter) const {
+  if (!visible_object_indices_.has_value()) {
+    return iter;
+  }
+
+  const CPDF_PageObjectHolder* holder = current_layer_->GetObjectHolder();
+  const size_t index = std::distance(holder->begin(), iter);
+  auto it = std::ranges::lower_bound(visible_object_indices_.value(), index);
+  if (it == visible_object_indices_->end()) {
+    return holder->end();
+  }
+  return holder->begin() + *it;
+}
@@ -7,9 +7,12 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 #define CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
@@ -46,6 +49,11 @@ class CPDF_ProgressiveRenderer {
   // Maximum page objects to render before checking for pause.
   static constexpr int kStepLimit = 100;
 
+  // Returns `iter`, or the first object after it that may intersect
+  // `clip_rect_`.
+  CPDF_PageObjectHolder::const_iterator SkipCulledObjects(
+      CPDF_PageObjectHolder::const_iterator iter) const;
+
   Status status_ = kReady;
   UnownedPtr<CPDF_RenderContext> const context_;
   UnownedPtr<CFX_RenderDevice> const device_;
@@ -55,6 +63,9 @@ class CPDF_ProgressiveRenderer {
   uint32_t layer_index_ = 0;
   UnownedPtr<CPDF_RenderContext::Layer> current_layer_;
   CPDF_PageObjectHolder::const_iterator last_object_rendered_;
+  // From CPDF_PageObjectHolder::GetPageObjectIndicesInRect() for
+  // `current_layer_` and `clip_rect_`.
+  std::optional<std::vector<size_t>> visible_object_indices_;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
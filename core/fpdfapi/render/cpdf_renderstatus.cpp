@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <utility>
 #include <vector>
@@ -80,7 +81,11 @@
 namespace {
 
 constexpr int kRenderMaxRecursionDepth = 64;
-int g_CurrentRecursionDepth = 0;
+
+// In device pixels. See CPDF_RenderStatus::GetObjectCullingRect().
+constexpr float kCullingMargin = 2.0f;
+
+thread_local int g_CurrentRecursionDepth = 0;
 
 CFX_FillRenderOptions GetFillOptionsForDrawPathWithBlend(
     const CPDF_RenderOptions::Options& options,
@@ -211,30 +216,52 @@ void CPDF_RenderStatus::Initialize(const CPDF_RenderStatus* pParentStatus,
 void CPDF_RenderStatus::RenderObjectList(
     const CPDF_PageObjectHolder* pObjectHolder,
     const CFX_Matrix& mtObj2Device) {
-  CFX_FloatRect clip_rect = mtObj2Device.GetInverse().TransformRect(
-      CFX_FloatRect(device_->GetClipBox()));
+  CFX_FloatRect clip_rect = GetObjectCullingRect(device_, mtObj2Device);
+  if (!stop_obj_) {
+    // Only visit the objects that the spatial index says may be visible. This
+    // cannot be done with `stop_obj_`, which must be found even if culled.
+    std::optional<std::vector<size_t>> indices =
+        pObjectHolder->GetPageObjectIndicesInRect(clip_rect);
+    if (indices.has_value()) {
+      for (size_t index : indices.value()) {
+        RenderObjectInRect(pObjectHolder->GetPageObjectByIndex(index),
+                           clip_rect, mtObj2Device);
+        if (stopped_) {
+          return;
+        }
+      }
+      return;
+    }
+  }
+
   for (const auto& pCurObj : *pObjectHolder) {
     if (pCurObj.get() == stop_obj_) {
       stopped_ = true;
       return;
     }
-    if (!pCurObj || !pCurObj->IsActive()) {
-      continue;
-    }
-
-    if (pCurObj->GetRect().left > clip_rect.right ||
-        pCurObj->GetRect().right < clip_rect.left ||
-        pCurObj->GetRect().bottom > clip_rect.top ||
-        pCurObj->GetRect().top < clip_rect.bottom) {
-      continue;
-    }
-    RenderSingleObject(pCurObj.get(), mtObj2Device);
+    RenderObjectInRect(pCurObj.get(), clip_rect, mtObj2Device);
     if (stopped_) {
       return;
     }
   }
 }
 
+void CPDF_RenderStatus::RenderObjectInRect(CPDF_PageObject* pObj,
+                                           const CFX_FloatRect& clip_rect,
+                                           const CFX_Matrix& mtObj2Device) {
+  if (!pObj || !pObj->IsActive()) {
+    return;
+  }
+
+  if (pObj->GetRect().left > clip_rect.right ||
+      pObj->GetRect().right < clip_rect.left ||
+      pObj->GetRect().bottom > clip_rect.top ||
+      pObj->GetRect().top < clip_rect.bottom) {
+    return;
+  }
+  RenderSingleObject(pObj, mtObj2Device);
+}
+
 void CPDF_RenderStatus::RenderSingleObject(CPDF_PageObject* pObj,
                                            const CFX_Matrix& mtObj2Device) {
   AutoRestorer<int> restorer(&g_CurrentRecursionDepth);
@@ -294,6 +321,15 @@ bool CPDF_RenderStatus::ContinueSingleObject(CPDF_PageObject* pObj,
   return ContinueSingleObject(pObj, mtObj2Device, pPause);
 }
 
+// static
+CFX_FloatRect CPDF_RenderStatus::GetObjectCullingRect(
+    const CFX_RenderDevice* device,
+    const CFX_Matrix& mtObj2Device) {
+  CFX_FloatRect clip_rect(device->GetClipBox());
+  clip_rect.Inflate(kCullingMargin, kCullingMargin);
+  return mtObj2Device.GetInverse().TransformRect(clip_rect);
+}
+
 FX_RECT CPDF_RenderStatus::GetObjectClippedRect(
     const CPDF_PageObject* pObj,
     const CFX_Matrix& mtObj2Device) const {
@@ -908,17 +944,17 @@ bool CPDF_RenderStatus::ProcessText(CPDF_TextObject* textobj,
       }
     }
     return CPDF_TextRenderer::DrawTextPath(
-        device_, textobj->GetCharCodes(), textobj->GetCharPositions(),
-        pFont.Get(), font_size, text_matrix, pDeviceMatrix,
-        textobj->graph_state().GetObject(), fill_argb, stroke_argb,
-        clipping_path,
+        device_, GetTextObjectCharPosList(textobj), pFont.Get(), font_size,
+        text_matrix, pDeviceMatrix, textobj->graph_state().GetObject(),
+        fill_argb, stroke_argb, clipping_path,
         GetFillOptionsForDrawTextPath(options_.GetOptions(), textobj, is_stroke,
                                       is_fill));
   }
   text_matrix.Concat(mtObj2Device);
-  return CPDF_TextRenderer::DrawNormalText(
-      device_, textobj->GetCharCodes(), textobj->GetCharPositions(),
-      pFont.Get(), font_size, text_matrix, fill_argb, options_);
+  return CPDF_TextRenderer::DrawNormalText(device_,
+                                           GetTextObjectCharPosList(textobj),
+                                           pFont.Get(), font_size, text_matrix,
+                                           fill_argb, options_);
 }
 
 // TODO(npm): Font fallback for type 3 fonts? (Completely separate code!!)
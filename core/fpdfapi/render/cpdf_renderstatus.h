@@ -129,7 +129,18 @@ class CPDF_RenderStatus {
       const CPDF_GraphicStates* pSrcStates,
       bool stroke);
 
+  // Returns the area in object space that objects must intersect to be drawn
+  // on `device`. Anti-aliasing and minimum width strokes reach a little past
+  // object bounding boxes, so the area has a margin to keep objects cut by
+  // the clip box from being skipped.
+  static CFX_FloatRect GetObjectCullingRect(const CFX_RenderDevice* device,
+                                            const CFX_Matrix& mtObj2Device);
+
  private:
+  // Renders `pObj` unless it is inactive or outside `clip_rect`.
+  void RenderObjectInRect(CPDF_PageObject* pObj,
+                          const CFX_FloatRect& clip_rect,
+                          const CFX_Matrix& mtObj2Device);
   bool ProcessTransparency(CPDF_PageObject* PageObj,
                            const CFX_Matrix& mtObj2Device);
   void ProcessObjectNoClip(CPDF_PageObject* pObj,
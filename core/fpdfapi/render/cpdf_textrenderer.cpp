@@ -65,6 +65,24 @@ bool CPDF_TextRenderer::DrawTextPath(
     const CFX_FillRenderOptions& fill_options) {
   std::vector<TextCharPos> pos =
       GetCharPosList(char_codes, char_pos, pFont, font_size);
+  return DrawTextPath(pDevice, pos, pFont, font_size, mtText2User,
+                      pUser2Device, pGraphState, fill_argb, stroke_argb,
+                      pClippingPath, fill_options);
+}
+
+// static
+bool CPDF_TextRenderer::DrawTextPath(
+    CFX_RenderDevice* pDevice,
+    pdfium::span<const TextCharPos> pos,
+    CPDF_Font* pFont,
+    float font_size,
+    const CFX_Matrix& mtText2User,
+    const CFX_Matrix* pUser2Device,
+    const CFX_GraphStateData* pGraphState,
+    FX_ARGB fill_argb,
+    FX_ARGB stroke_argb,
+    CFX_Path* pClippingPath,
+    const CFX_FillRenderOptions& fill_options) {
   if (pos.empty()) {
     return true;
   }
@@ -79,20 +97,19 @@ bool CPDF_TextRenderer::DrawTextPath(
     }
 
     CFX_Font* font = GetFont(pFont, fontPosition);
-    if (!pDevice->DrawTextPath(
-            pdfium::span(pos).subspan(startIndex, i - startIndex), font,
-            font_size, mtText2User, pUser2Device, pGraphState, fill_argb,
-            stroke_argb, pClippingPath, fill_options)) {
+    if (!pDevice->DrawTextPath(pos.subspan(startIndex, i - startIndex), font,
+                               font_size, mtText2User, pUser2Device,
+                               pGraphState, fill_argb, stroke_argb,
+                               pClippingPath, fill_options)) {
       bDraw = false;
     }
     fontPosition = curFontPosition;
     startIndex = i;
   }
   CFX_Font* font = GetFont(pFont, fontPosition);
-  if (!pDevice->DrawTextPath(pdfium::span(pos).subspan(startIndex), font,
-                             font_size, mtText2User, pUser2Device, pGraphState,
-                             fill_argb, stroke_argb, pClippingPath,
-                             fill_options)) {
+  if (!pDevice->DrawTextPath(pos.subspan(startIndex), font, font_size,
+                             mtText2User, pUser2Device, pGraphState, fill_argb,
+                             stroke_argb, pClippingPath, fill_options)) {
     bDraw = false;
   }
   return bDraw;
@@ -148,6 +165,18 @@ bool CPDF_TextRenderer::DrawNormalText(CFX_RenderDevice* pDevice,
                                        const CPDF_RenderOptions& options) {
   std::vector<TextCharPos> pos =
       GetCharPosList(char_codes, char_pos, pFont, font_size);
+  return DrawNormalText(pDevice, pos, pFont, font_size, mtText2Device,
+                        fill_argb, options);
+}
+
+// static
+bool CPDF_TextRenderer::DrawNormalText(CFX_RenderDevice* pDevice,
+                                       pdfium::span<const TextCharPos> pos,
+                                       CPDF_Font* pFont,
+                                       float font_size,
+                                       const CFX_Matrix& mtText2Device,
+                                       FX_ARGB fill_argb,
+                                       const CPDF_RenderOptions& options) {
   if (pos.empty()) {
     return true;
   }
@@ -164,18 +193,17 @@ bool CPDF_TextRenderer::DrawNormalText(CFX_RenderDevice* pDevice,
     }
 
     CFX_Font* font = GetFont(pFont, fontPosition);
-    if (!pDevice->DrawNormalText(
-            pdfium::span(pos).subspan(startIndex, i - startIndex), font,
-            font_size, mtText2Device, fill_argb, text_options)) {
+    if (!pDevice->DrawNormalText(pos.subspan(startIndex, i - startIndex),
+                                 font, font_size, mtText2Device, fill_argb,
+                                 text_options)) {
       bDraw = false;
     }
     fontPosition = curFontPosition;
     startIndex = i;
   }
   CFX_Font* font = GetFont(pFont, fontPosition);
-  if (!pDevice->DrawNormalText(pdfium::span(pos).subspan(startIndex), font,
-                               font_size, mtText2Device, fill_argb,
-                               text_options)) {
+  if (!pDevice->DrawNormalText(pos.subspan(startIndex), font, font_size,
+                               mtText2Device, fill_argb, text_options)) {
     bDraw = false;
   }
   return bDraw;
@@ -19,6 +19,7 @@ class CFX_GraphStateData;
 class CFX_Path;
 class CPDF_RenderOptions;
 class CPDF_Font;
+class TextCharPos;
 struct CFX_FillRenderOptions;
 
 class CPDF_TextRenderer {
@@ -46,6 +47,19 @@ class CPDF_TextRenderer {
                            CFX_Path* pClippingPath,
                            const CFX_FillRenderOptions& fill_options);
 
+  // Same as above, with `pos` from GetCharPosList().
+  static bool DrawTextPath(CFX_RenderDevice* pDevice,
+                           pdfium::span<const TextCharPos> pos,
+                           CPDF_Font* pFont,
+                           float font_size,
+                           const CFX_Matrix& mtText2User,
+                           const CFX_Matrix* pUser2Device,
+                           const CFX_GraphStateData* pGraphState,
+                           FX_ARGB fill_argb,
+                           FX_ARGB stroke_argb,
+                           CFX_Path* pClippingPath,
+                           const CFX_FillRenderOptions& fill_options);
+
   static bool DrawNormalText(CFX_RenderDevice* pDevice,
                              pdfium::span<const uint32_t> char_codes,
                              pdfium::span<const float> char_pos,
@@ -55,6 +69,15 @@ class CPDF_TextRenderer {
                              FX_ARGB fill_argb,
                              const CPDF_RenderOptions& options);
 
+  // Same as above, with `pos` from GetCharPosList().
+  static bool DrawNormalText(CFX_RenderDevice* pDevice,
+                             pdfium::span<const TextCharPos> pos,
+                             CPDF_Font* pFont,
+                             float font_size,
+                             const CFX_Matrix& mtText2Device,
+                             FX_ARGB fill_argb,
+                             const CPDF_RenderOptions& options);
+
   CPDF_TextRenderer() = delete;
   CPDF_TextRenderer(const CPDF_TextRenderer&) = delete;
   CPDF_TextRenderer& operator=(const CPDF_TextRenderer&) = delete;
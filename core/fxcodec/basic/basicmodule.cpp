@@ -7,16 +7,19 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <optional>
 #include <utility>
 
 #include "core/fxcodec/scanlinedecoder.h"
 #include "core/fxcrt/byteorder.h"
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/stl_util.h"
+#include "core/fxge/calculate_pitch.h"
 
 namespace fxcodec {
 
@@ -211,8 +214,107 @@ void RLScanlineDecoder::UpdateOperator(uint8_t used_bytes) {
   operator_ = 257 - count;
 }
 
+int ReducedSize(int size, uint8_t resolution_levels_to_skip) {
+  return ((size - 1) >> resolution_levels_to_skip) + 1;
+}
+
+// Keeps the first pixel of each 2^N x 2^N block of pixels from `source`.
+class ReducedScanlineDecoder final : public ScanlineDecoder {
+ public:
+  ReducedScanlineDecoder(std::unique_ptr<ScanlineDecoder> source,
+                         uint8_t resolution_levels_to_skip,
+                         uint32_t pitch);
+  ~ReducedScanlineDecoder() override;
+
+  // ScanlineDecoder:
+  [[nodiscard]] bool Rewind() override;
+  pdfium::span<uint8_t> GetNextLine() override;
+  uint32_t GetSrcOffset() override;
+
+ private:
+  std::unique_ptr<ScanlineDecoder> const source_;
+  const uint8_t resolution_levels_to_skip_;
+  DataVector<uint8_t> scanline_;
+};
+
+ReducedScanlineDecoder::ReducedScanlineDecoder(
+    std::unique_ptr<ScanlineDecoder> source,
+    uint8_t resolution_levels_to_skip,
+    uint32_t pitch)
+    : ScanlineDecoder(
+          source->GetWidth(),
+          source->GetHeight(),
+          ReducedSize(source->GetWidth(), resolution_levels_to_skip),
+          ReducedSize(source->GetHeight(), resolution_levels_to_skip),
+          source->CountComps(),
+          source->GetBPC(),
+          pitch),
+      source_(std::move(source)),
+      resolution_levels_to_skip_(resolution_levels_to_skip),
+      scanline_(pitch) {}
+
+ReducedScanlineDecoder::~ReducedScanlineDecoder() {
+  // Span in superclass can't outlive our buffer.
+  last_scanline_ = pdfium::span<uint8_t>();
+}
+
+bool ReducedScanlineDecoder::Rewind() {
+  // `source_` rewinds itself when asked for an earlier line.
+  return true;
+}
+
+pdfium::span<uint8_t> ReducedScanlineDecoder::GetNextLine() {
+  // `source_` still decodes the lines in between, but they are not unpacked.
+  pdfium::span<const uint8_t> src_line =
+      source_->GetScanline(next_line_ << resolution_levels_to_skip_);
+  const size_t bpp = static_cast<size_t>(comps_) * bpc_;
+  const size_t src_bits = static_cast<size_t>(orig_width_) * bpp;
+  if (src_line.size() < (src_bits + 7) / 8) {
+    return pdfium::span<uint8_t>();
+  }
+
+  const size_t bytes_per_pixel = bpp / 8;
+  const size_t src_step_bytes = bytes_per_pixel << resolution_levels_to_skip_;
+  UNSAFE_TODO({
+    const uint8_t* src = src_line.data();
+    uint8_t* dest = scanline_.data();
+    for (int col = 0; col < output_width_; ++col) {
+      for (size_t i = 0; i < bytes_per_pixel; ++i) {
+        dest[i] = src[i];
+      }
+      src += src_step_bytes;
+      dest += bytes_per_pixel;
+    }
+  });
+  return scanline_;
+}
+
+uint32_t ReducedScanlineDecoder::GetSrcOffset() {
+  return source_->GetSrcOffset();
+}
+
 }  // namespace
 
+// static
+std::unique_ptr<ScanlineDecoder> BasicModule::CreateReducedDecoder(
+    std::unique_ptr<ScanlineDecoder> source,
+    uint8_t resolution_levels_to_skip) {
+  if (resolution_levels_to_skip == 0) {
+    return source;
+  }
+  if (source->GetBPC() * source->CountComps() % 8 != 0) {
+    return nullptr;
+  }
+  const std::optional<uint32_t> pitch = fxge::CalculatePitch8(
+      source->GetBPC(), source->CountComps(),
+      ReducedSize(source->GetWidth(), resolution_levels_to_skip));
+  if (!pitch.has_value()) {
+    return nullptr;
+  }
+  return std::make_unique<ReducedScanlineDecoder>(
+      std::move(source), resolution_levels_to_skip, pitch.value());
+}
+
 // static
 std::unique_ptr<ScanlineDecoder> BasicModule::CreateRunLengthDecoder(
     pdfium::span<const uint8_t> src_buf,
@@ -20,6 +20,13 @@ class ScanlineDecoder;
 
 class BasicModule {
  public:
+  // Wraps `source` to return lines at 1/2^`resolution_levels_to_skip` of its
+  // size, rounded up, by skipping lines and pixels. Returns nullptr if the
+  // pixels of `source` are not whole bytes.
+  static std::unique_ptr<ScanlineDecoder> CreateReducedDecoder(
+      std::unique_ptr<ScanlineDecoder> source,
+      uint8_t resolution_levels_to_skip);
+
   static std::unique_ptr<ScanlineDecoder> CreateRunLengthDecoder(
       pdfium::span<const uint8_t> src_buf,
       int width,
@@ -11,6 +11,7 @@
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
 #include "core/fxcodec/basic/basicmodule.h"
 #include "core/fxcodec/data_and_bytes_consumed.h"
+#include "core/fxcodec/scanlinedecoder.h"
 #include "core/fxcrt/data_vector.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -98,3 +99,35 @@ TEST(fxcodec, RLEFullLengthInputs) {
     EXPECT_THAT(result.data, ElementsAreArray(src_buf_4));
   }
 }
+
+TEST(fxcodec, RLEReducedDecoder) {
+  // clang-format off
+  const uint8_t src_buf[] = {
+      10,  20,  30,
+      40,  50,  60,
+      70,  80,  90,
+  };
+  // clang-format on
+  DataVector<uint8_t> encoded = BasicModule::RunLengthEncode(src_buf);
+  std::unique_ptr<ScanlineDecoder> decoder = BasicModule::CreateReducedDecoder(
+      BasicModule::CreateRunLengthDecoder(encoded, 3, 3, 1, 8),
+      /*resolution_levels_to_skip=*/1);
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ(2, decoder->GetWidth());
+  EXPECT_EQ(2, decoder->GetHeight());
+  EXPECT_THAT(decoder->GetScanline(0), ElementsAreArray({10, 30}));
+  EXPECT_THAT(decoder->GetScanline(1), ElementsAreArray({70, 90}));
+
+  // Going back rewinds the source.
+  EXPECT_THAT(decoder->GetScanline(0), ElementsAreArray({10, 30}));
+}
+
+TEST(fxcodec, RLEReducedDecoderOneBit) {
+  // Two lines of 10 pixels.
+  const uint8_t src_buf[] = {0b10101010, 0b10000000, 0b01010101, 0b01000000};
+  DataVector<uint8_t> encoded = BasicModule::RunLengthEncode(src_buf);
+  // Packed pixels are not skipped, as thin lines would drop out.
+  EXPECT_FALSE(BasicModule::CreateReducedDecoder(
+      BasicModule::CreateRunLengthDecoder(encoded, 10, 2, 1, 1),
+      /*resolution_levels_to_skip=*/1));
+}
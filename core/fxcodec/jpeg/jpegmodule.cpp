@@ -21,6 +21,7 @@
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/raw_span.h"
+#include "core/fxcrt/stl_util.h"
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "core/fxge/dib/fx_dib.h"
 
@@ -90,7 +91,8 @@ class JpegDecoder final : public ScanlineDecoder {
               uint32_t width,
               uint32_t height,
               int nComps,
-              bool ColorTransform);
+              bool ColorTransform,
+              uint8_t resolution_levels_to_skip);
 
   // ScanlineDecoder:
   [[nodiscard]] bool Rewind() override;
@@ -112,9 +114,11 @@ class JpegDecoder final : public ScanlineDecoder {
   // Patch up the in-memory JPEG header for known bad JPEGs.
   void PatchUpKnownBadHeaderWithInvalidHeight(size_t dimension_offset);
 
-  // Patch up the JPEG trailer, even if it is correct.
+  // Patch up the JPEG trailer, unless it is already correct.
   void PatchUpTrailer();
 
+  // The source data may be borrowed from a read-only file mapping or from
+  // embedder memory, so patches go to a private copy of it.
   pdfium::span<uint8_t> GetWritableSrcData();
 
   // For a given invalid height byte offset in
@@ -123,12 +127,15 @@ class JpegDecoder final : public ScanlineDecoder {
   static constexpr size_t kSofMarkerByteOffset = 5;
 
   JpegCommon common_ = {};
+  // Must outlive `src_span_`, which points into it once patched.
+  DataVector<uint8_t> patched_src_;
   pdfium::raw_span<const uint8_t> src_span_;
   DataVector<uint8_t> scanline_buf_;
   bool decompress_created_ = false;
   bool started_ = false;
   bool jpeg_transform_ = false;
   uint32_t default_scale_denom_ = 1;
+  uint8_t resolution_levels_to_skip_ = 0;
 };
 
 JpegDecoder::JpegDecoder() = default;
@@ -191,8 +198,9 @@ bool JpegDecoder::InitDecode(bool bAcceptKnownBadHeader) {
 
   orig_width_ = common_.cinfo.image_width;
   orig_height_ = common_.cinfo.image_height;
-  output_width_ = orig_width_;
-  output_height_ = orig_height_;
+  // Matches how libjpeg rounds up the output size of scaled decoding.
+  output_width_ = ((orig_width_ - 1) >> resolution_levels_to_skip_) + 1;
+  output_height_ = ((orig_height_ - 1) >> resolution_levels_to_skip_) + 1;
   default_scale_denom_ = common_.cinfo.scale_denom;
   return true;
 }
@@ -201,7 +209,8 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
                          uint32_t width,
                          uint32_t height,
                          int nComps,
-                         bool ColorTransform) {
+                         bool ColorTransform,
+                         uint8_t resolution_levels_to_skip) {
   src_span_ = JpegScanSOI(src_span);
   if (src_span_.size() < 2) {
     return false;
@@ -220,6 +229,7 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
   common_.source_mgr.fill_input_buffer = jpeg_common_src_fill_buffer;
   common_.source_mgr.resync_to_restart = jpeg_common_src_resync;
   jpeg_transform_ = ColorTransform;
+  resolution_levels_to_skip_ = resolution_levels_to_skip;
   output_width_ = orig_width_ = width;
   output_height_ = orig_height_ = height;
   if (!InitDecode(/*bAcceptKnownBadHeader=*/true)) {
@@ -249,14 +259,16 @@ bool JpegDecoder::Rewind() {
       return false;
     }
   }
-  common_.cinfo.scale_denom = default_scale_denom_;
-  output_width_ = orig_width_;
-  output_height_ = orig_height_;
+  // libjpeg scales by doing smaller inverse DCTs, which is much cheaper than
+  // decoding at full size.
+  common_.cinfo.scale_denom = default_scale_denom_
+                              << resolution_levels_to_skip_;
   if (!jpeg_common_start_decompress(&common_)) {
     jpeg_common_destroy_decompress(&common_);
     return false;
   }
-  CHECK_LE(static_cast<int>(common_.cinfo.output_width), orig_width_);
+  CHECK_LE(static_cast<int>(common_.cinfo.output_width), output_width_);
+  CHECK_LE(static_cast<int>(common_.cinfo.output_height), output_height_);
   started_ = true;
   return true;
 }
@@ -335,15 +347,19 @@ void JpegDecoder::PatchUpKnownBadHeaderWithInvalidHeight(
 }
 
 void JpegDecoder::PatchUpTrailer() {
-  auto pData = GetWritableSrcData();
-  pData[src_span_.size() - 2] = 0xff;
-  pData[src_span_.size() - 1] = 0xd9;
+  static constexpr uint8_t kTrailer[] = {0xff, 0xd9};
+  if (src_span_.last<2u>() == pdfium::span(kTrailer)) {
+    return;
+  }
+  fxcrt::Copy(kTrailer, GetWritableSrcData().last<2u>());
 }
 
 pdfium::span<uint8_t> JpegDecoder::GetWritableSrcData() {
-  // SAFETY: const_cast<> doesn't change size.
-  return UNSAFE_BUFFERS(
-      pdfium::span(const_cast<uint8_t*>(src_span_.data()), src_span_.size()));
+  if (patched_src_.empty()) {
+    patched_src_ = DataVector<uint8_t>(src_span_.begin(), src_span_.end());
+    src_span_ = patched_src_;
+  }
+  return patched_src_;
 }
 
 }  // namespace
@@ -354,11 +370,14 @@ std::unique_ptr<ScanlineDecoder> JpegModule::CreateDecoder(
     uint32_t width,
     uint32_t height,
     int nComps,
-    bool ColorTransform) {
+    bool ColorTransform,
+    uint8_t resolution_levels_to_skip) {
   DCHECK(!src_span.empty());
+  DCHECK_LE(resolution_levels_to_skip, kMaxResolutionLevelsToSkip);
 
   auto pDecoder = std::make_unique<JpegDecoder>();
-  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform)) {
+  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform,
+                        resolution_levels_to_skip)) {
     return nullptr;
   }
 
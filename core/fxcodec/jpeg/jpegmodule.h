@@ -37,12 +37,17 @@ class JpegModule {
     bool color_transform;
   };
 
+  // libjpeg can only scale down by up to 1/8.
+  static constexpr uint8_t kMaxResolutionLevelsToSkip = 3;
+
+  // Decodes at 1/2^`resolution_levels_to_skip` of the full size, rounded up.
   static std::unique_ptr<ScanlineDecoder> CreateDecoder(
       pdfium::span<const uint8_t> src_span,
       uint32_t width,
       uint32_t height,
       int nComps,
-      bool ColorTransform);
+      bool ColorTransform,
+      uint8_t resolution_levels_to_skip);
 
   static std::optional<ImageInfo> LoadInfo(
       pdfium::span<const uint8_t> src_span);
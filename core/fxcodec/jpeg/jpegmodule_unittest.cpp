@@ -0,0 +1,117 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jpeg/jpegmodule.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/file_util.h"
+#include "testing/utils/path_service.h"
+
+namespace fxcodec {
+
+namespace {
+
+std::vector<uint8_t> DecodeAllLines(pdfium::span<const uint8_t> src) {
+  std::optional<JpegModule::ImageInfo> info = JpegModule::LoadInfo(src);
+  if (!info.has_value()) {
+    return {};
+  }
+  std::unique_ptr<ScanlineDecoder> decoder = JpegModule::CreateDecoder(
+      src, info->width, info->height, info->num_components,
+      info->color_transform, /*resolution_levels_to_skip=*/0);
+  if (!decoder) {
+    return {};
+  }
+  std::vector<uint8_t> result;
+  for (uint32_t row = 0; row < info->height; ++row) {
+    pdfium::span<const uint8_t> line = decoder->GetScanline(row);
+    if (line.empty()) {
+      return {};
+    }
+    result.insert(result.end(), line.begin(), line.end());
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(JpegModuleTest, DecoderDoesNotModifySource) {
+  std::string file_path = PathService::GetTestFilePath("mona_lisa.jpg");
+  ASSERT_FALSE(file_path.empty());
+  std::vector<uint8_t> contents = GetFileContents(file_path.c_str());
+  ASSERT_GT(contents.size(), 2u);
+  std::vector<uint8_t> expected = DecodeAllLines(contents);
+  ASSERT_FALSE(expected.empty());
+
+  // Break the EOI marker, which the decoder patches up before decoding.
+  contents[contents.size() - 2] = 0;
+  contents[contents.size() - 1] = 0;
+  const std::vector<uint8_t> original = contents;
+  EXPECT_EQ(expected, DecodeAllLines(contents));
+  EXPECT_EQ(original, contents);
+}
+
+TEST(JpegModuleTest, ReducedResolution) {
+  std::string file_path = PathService::GetTestFilePath("mona_lisa.jpg");
+  ASSERT_FALSE(file_path.empty());
+  std::vector<uint8_t> contents = GetFileContents(file_path.c_str());
+  std::optional<JpegModule::ImageInfo> info = JpegModule::LoadInfo(contents);
+  ASSERT_TRUE(info.has_value());
+  const int comps = info->num_components;
+  std::unique_ptr<ScanlineDecoder> full_decoder = JpegModule::CreateDecoder(
+      contents, info->width, info->height, comps, info->color_transform,
+      /*resolution_levels_to_skip=*/0);
+  ASSERT_TRUE(full_decoder);
+
+  for (uint8_t levels = 1; levels <= JpegModule::kMaxResolutionLevelsToSkip;
+       ++levels) {
+    std::unique_ptr<ScanlineDecoder> decoder = JpegModule::CreateDecoder(
+        contents, info->width, info->height, comps, info->color_transform,
+        levels);
+    ASSERT_TRUE(decoder);
+    const int scale = 1 << levels;
+    EXPECT_EQ(static_cast<int>((info->width + scale - 1) / scale),
+              decoder->GetWidth());
+    EXPECT_EQ(static_cast<int>((info->height + scale - 1) / scale),
+              decoder->GetHeight());
+
+    // Each reduced pixel should be close to the top-left full size pixel of
+    // the block it covers, for an image without sharp edges.
+    const int row = decoder->GetHeight() / 2;
+    std::vector<uint8_t> line;
+    {
+      pdfium::span<const uint8_t> scanline = decoder->GetScanline(row);
+      ASSERT_FALSE(scanline.empty());
+      line.assign(scanline.begin(), scanline.end());
+    }
+    pdfium::span<const uint8_t> full_line =
+        full_decoder->GetScanline(row * scale);
+    ASSERT_FALSE(full_line.empty());
+    int total_diff = 0;
+    for (int col = 0; col < decoder->GetWidth(); ++col) {
+      for (int comp = 0; comp < comps; ++comp) {
+        total_diff += abs(line[col * comps + comp] -
+                          full_line[col * scale * comps + comp]);
+      }
+    }
+    EXPECT_LT(total_diff / (decoder->GetWidth() * comps), 32);
+
+    // Every row decodes.
+    for (int i = 0; i < decoder->GetHeight(); ++i) {
+      EXPECT_FALSE(decoder->GetScanline(i).empty());
+    }
+  }
+}
+
+}  // namespace fxcodec
@@ -506,6 +506,21 @@ bool CJPX_Decoder::Init(pdfium::span<const uint8_t> src_data,
   return true;
 }
 
+void CJPX_Decoder::SetDecodeHeight(uint32_t height) {
+  // The decode area is in reference grid coordinates, where each line of the
+  // first component takes `dy` lines.
+  FX_SAFE_UINT32 y1 = height;
+  y1 *= components_span(image_.get())[0].dy;
+  y1 += image_->y0;
+  if (height == 0 || !y1.IsValid() || y1.ValueOrDie() >= image_->y1) {
+    return;
+  }
+  parameters_.DA_x0 = image_->x0;
+  parameters_.DA_y0 = image_->y0;
+  parameters_.DA_x1 = image_->x1;
+  parameters_.DA_y1 = y1.ValueOrDie();
+}
+
 bool CJPX_Decoder::StartDecode() {
   if (!parameters_.nb_tile_to_decode) {
     if (!opj_set_decode_area(codec_.get(), image_.get(), parameters_.DA_x0,
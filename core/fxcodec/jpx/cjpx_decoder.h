@@ -54,6 +54,11 @@ class CJPX_Decoder {
   ~CJPX_Decoder();
 
   JpxImageInfo GetInfo() const;
+
+  // Limits decoding to the first `height` lines of the full size image, when
+  // only those get drawn. Must be called before StartDecode().
+  void SetDecodeHeight(uint32_t height);
+
   bool StartDecode();
 
   // `swap_rgb` can only be set when an image's color space type contains at
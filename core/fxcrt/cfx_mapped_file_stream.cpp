@@ -0,0 +1,82 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mapped_file_stream.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/stl_util.h"
+
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif  // O_CLOEXEC
+
+// static
+RetainPtr<CFX_MappedFileStream> CFX_MappedFileStream::Create(
+    const char* filename) {
+  int fd = open(filename, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat s;
+  if (fstat(fd, &s) != 0 || !S_ISREG(s.st_mode) || s.st_size <= 0 ||
+      !pdfium::IsValueInRangeForNumericType<size_t>(s.st_size)) {
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = static_cast<size_t>(s.st_size);
+  void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+
+  // SAFETY: mmap() succeeded, so `address` points to `size` readable bytes.
+  return pdfium::MakeRetain<CFX_MappedFileStream>(UNSAFE_BUFFERS(
+      pdfium::span(static_cast<const uint8_t*>(address), size)));
+}
+
+CFX_MappedFileStream::CFX_MappedFileStream(
+    pdfium::span<const uint8_t> mapping)
+    : mapping_(mapping) {}
+
+CFX_MappedFileStream::~CFX_MappedFileStream() {
+  munmap(const_cast<uint8_t*>(mapping_.data()), mapping_.size());
+}
+
+FX_FILESIZE CFX_MappedFileStream::GetSize() {
+  return pdfium::checked_cast<FX_FILESIZE>(mapping_.size());
+}
+
+bool CFX_MappedFileStream::ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                                             FX_FILESIZE offset) {
+  if (buffer.empty() || offset < 0) {
+    return false;
+  }
+
+  FX_SAFE_SIZE_T pos = buffer.size();
+  pos += offset;
+  if (!pos.IsValid() || pos.ValueOrDie() > mapping_.size()) {
+    return false;
+  }
+
+  fxcrt::Copy(
+      mapping_.subspan(pdfium::checked_cast<size_t>(offset), buffer.size()),
+      buffer);
+  return true;
+}
+
+pdfium::span<const uint8_t> CFX_MappedFileStream::GetResidentSpan() {
+  return mapping_;
+}
@@ -0,0 +1,46 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_MAPPED_FILE_STREAM_H_
+#define CORE_FXCRT_CFX_MAPPED_FILE_STREAM_H_
+
+#include <stdint.h>
+
+#include "build/build_config.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/raw_span.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+
+#if !BUILDFLAG(IS_POSIX)
+#error "Included on the wrong platform"
+#endif
+
+// Read-only stream over a file mapped into memory with mmap(). Reads are
+// served from the mapping, and GetResidentSpan() exposes the whole file so
+// consumers can reference its bytes directly instead of copying them. The
+// mapping is released when the last reference goes away. As with any mapping,
+// the file must not be truncated while the stream is alive.
+class CFX_MappedFileStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Returns nullptr if `filename` cannot be opened or mapped, including when
+  // the file is empty.
+  static RetainPtr<CFX_MappedFileStream> Create(const char* filename);
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override;
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override;
+  pdfium::span<const uint8_t> GetResidentSpan() override;
+
+ private:
+  explicit CFX_MappedFileStream(pdfium::span<const uint8_t> mapping);
+  ~CFX_MappedFileStream() override;
+
+  const pdfium::raw_span<const uint8_t> mapping_;
+};
+
+#endif  // CORE_FXCRT_CFX_MAPPED_FILE_STREAM_H_
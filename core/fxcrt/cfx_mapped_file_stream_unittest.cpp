@@ -0,0 +1,61 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mapped_file_stream.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/path_service.h"
+
+TEST(MappedFileStreamTest, NonexistentFile) {
+  EXPECT_FALSE(CFX_MappedFileStream::Create("does/not/exist.pdf"));
+}
+
+TEST(MappedFileStreamTest, Directory) {
+  std::string test_dir;
+  ASSERT_TRUE(PathService::GetTestDataDir(&test_dir));
+  EXPECT_FALSE(CFX_MappedFileStream::Create(test_dir.c_str()));
+}
+
+TEST(MappedFileStreamTest, ReadBlockAtOffset) {
+  std::string test_file = PathService::GetTestFilePath("rectangles.pdf");
+  ASSERT_FALSE(test_file.empty());
+  RetainPtr<CFX_MappedFileStream> stream =
+      CFX_MappedFileStream::Create(test_file.c_str());
+  ASSERT_TRUE(stream);
+
+  const FX_FILESIZE size = stream->GetSize();
+  ASSERT_GT(size, 16);
+  pdfium::span<const uint8_t> resident_data = stream->GetResidentSpan();
+  ASSERT_EQ(static_cast<size_t>(size), resident_data.size());
+  EXPECT_EQ('%', resident_data[0]);
+  EXPECT_EQ('P', resident_data[1]);
+
+  std::vector<uint8_t> buffer(8);
+  ASSERT_TRUE(stream->ReadBlockAtOffset(buffer, 0));
+  EXPECT_EQ(resident_data.first(8u), pdfium::span(buffer));
+  ASSERT_TRUE(stream->ReadBlockAtOffset(buffer, size - 8));
+  EXPECT_EQ(resident_data.last(8u), pdfium::span(buffer));
+
+  EXPECT_FALSE(stream->ReadBlockAtOffset(buffer, size - 7));
+  EXPECT_FALSE(stream->ReadBlockAtOffset(buffer, -1));
+  EXPECT_FALSE(stream->ReadBlockAtOffset(pdfium::span<uint8_t>(), 0));
+}
+
+TEST(MappedFileStreamTest, CreateFromFilename) {
+  std::string test_file = PathService::GetTestFilePath("rectangles.pdf");
+  ASSERT_FALSE(test_file.empty());
+  RetainPtr<IFX_SeekableReadStream> stream =
+      IFX_SeekableReadStream::CreateFromFilename(test_file.c_str());
+  ASSERT_TRUE(stream);
+  EXPECT_EQ(static_cast<size_t>(stream->GetSize()),
+            stream->GetResidentSpan().size());
+}
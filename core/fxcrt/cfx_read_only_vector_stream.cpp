@@ -28,3 +28,10 @@ bool CFX_ReadOnlyVectorStream::ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                                                  FX_FILESIZE offset) {
   return stream_->ReadBlockAtOffset(buffer, offset);
 }
+
+pdfium::span<const uint8_t> CFX_ReadOnlyVectorStream::GetResidentSpan() {
+  if (!data_.empty()) {
+    return data_;
+  }
+  return fixed_data_.span();
+}
@@ -22,6 +22,7 @@ class CFX_ReadOnlyVectorStream final : public IFX_SeekableReadStream {
   FX_FILESIZE GetSize() override;
   bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                          FX_FILESIZE offset) override;
+  pdfium::span<const uint8_t> GetResidentSpan() override;
 
  private:
   explicit CFX_ReadOnlyVectorStream(DataVector<uint8_t> data);
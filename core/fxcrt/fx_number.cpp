@@ -6,7 +6,9 @@
 
 #include "core/fxcrt/fx_number.h"
 
+#include <array>
 #include <limits>
+#include <optional>
 #include <variant>
 
 #include "core/fxcrt/fx_extension.h"
@@ -14,6 +16,65 @@
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 
+namespace {
+
+// Powers of ten that a float holds exactly.
+constexpr std::array<float, 11> kExactPowersOfTen = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+// Largest integer below which a float holds every integer exactly.
+constexpr uint32_t kMaxExactMantissa = 1u << 24;
+
+// Parses the common short decimals like "-12.5" or "612.375" without going
+// through StringToFloat(). When the digits and the power of ten are both
+// exact floats, one division gives the correctly rounded result, the same
+// value StringToFloat() returns. Returns nullopt for anything else, including
+// numbers without a '.'.
+std::optional<float> ParseShortDecimal(ByteStringView strc) {
+  size_t cc = 0;
+  bool negative = false;
+  if (strc[0] == '+' || strc[0] == '-') {
+    negative = strc[0] == '-';
+    cc++;
+  }
+
+  uint32_t mantissa = 0;
+  size_t digits = 0;
+  size_t fraction_digits = 0;
+  bool seen_point = false;
+  for (; cc < strc.GetLength(); ++cc) {
+    const char ch = strc.CharAt(cc);
+    if (ch == '.') {
+      if (seen_point) {
+        return std::nullopt;
+      }
+      seen_point = true;
+      continue;
+    }
+    if (!FXSYS_IsDecimalDigit(ch)) {
+      return std::nullopt;
+    }
+    mantissa = mantissa * 10 + (ch - '0');
+    if (mantissa >= kMaxExactMantissa) {
+      return std::nullopt;
+    }
+    ++digits;
+    if (seen_point) {
+      ++fraction_digits;
+    }
+  }
+  if (!seen_point || digits == 0 ||
+      fraction_digits >= kExactPowersOfTen.size()) {
+    return std::nullopt;
+  }
+
+  const float value =
+      static_cast<float>(mantissa) / kExactPowersOfTen[fraction_digits];
+  return negative ? -value : value;
+}
+
+}  // namespace
+
 FX_Number::FX_Number() = default;
 
 FX_Number::FX_Number(int32_t value) : value_(value) {}
@@ -26,7 +87,8 @@ FX_Number::FX_Number(ByteStringView strc) {
   }
 
   if (strc.Contains('.')) {
-    value_ = StringToFloat(strc);
+    std::optional<float> value = ParseShortDecimal(strc);
+    value_ = value.has_value() ? value.value() : StringToFloat(strc);
     return;
   }
 
@@ -5,6 +5,7 @@
 #include <limits>
 
 #include "core/fxcrt/fx_number.h"
+#include "core/fxcrt/fx_string.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 TEST(fxnumber, Default) {
@@ -150,3 +151,36 @@ TEST(fxnumber, FromStringFloat) {
   FX_Number number("3.24");
   EXPECT_FLOAT_EQ(3.24f, number.GetFloat());
 }
+
+TEST(fxnumber, FromStringFloatMatchesStringToFloat) {
+  static constexpr const char* kStrings[] = {
+      "0.0",          "-0.0",          ".5",         "-.5",
+      "+.75",         "5.",            "-5.",        ".",
+      "-.",           "1.2.3",         "1.5e3",      "12.34abc",
+      "16777215.5",   "1677721.65",    "0.0000000001", "1.00000000001",
+      "0.1",          "612.375",       "-144.125",   "3.4028235e38"};
+  for (const char* str : kStrings) {
+    FX_Number number(str);
+    EXPECT_FALSE(number.IsInteger()) << str;
+    EXPECT_EQ(StringToFloat(str), number.GetFloat()) << str;
+  }
+
+  // Coordinates as typical content streams write them, up to the limits of
+  // the exact path and beyond.
+  for (uint32_t value = 0; value < 20000000; value += 9973) {
+    for (int decimals = 1; decimals <= 6; ++decimals) {
+      ByteString str = ByteString::FormatInteger(static_cast<int>(value));
+      while (str.GetLength() <= static_cast<size_t>(decimals)) {
+        str.InsertAtFront('0');
+      }
+      str.Insert(str.GetLength() - decimals, '.');
+      EXPECT_EQ(StringToFloat(str.AsStringView()),
+                FX_Number(str.AsStringView()).GetFloat())
+          << str;
+      const ByteString negative = "-" + str;
+      EXPECT_EQ(StringToFloat(negative.AsStringView()),
+                FX_Number(negative.AsStringView()).GetFloat())
+          << negative;
+    }
+  }
+}
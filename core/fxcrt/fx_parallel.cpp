@@ -0,0 +1,53 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/fx_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace fxcrt {
+
+size_t GetMaxParallelism() {
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void RunOnThreads(size_t count, const std::function<void(size_t)>& task) {
+  if (count == 0) {
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(count - 1);
+  for (size_t i = 1; i < count; ++i) {
+    threads.emplace_back(task, i);
+  }
+  task(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void ParallelFor(size_t count,
+                 size_t thread_count,
+                 const std::function<void(size_t)>& task) {
+  thread_count = std::min(thread_count, count);
+  if (thread_count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_index = 0;
+  RunOnThreads(thread_count, [&next_index, count, &task](size_t) {
+    for (size_t i = next_index++; i < count; i = next_index++) {
+      task(i);
+    }
+  });
+}
+
+}  // namespace fxcrt
@@ -0,0 +1,33 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_FX_PARALLEL_H_
+#define CORE_FXCRT_FX_PARALLEL_H_
+
+#include <stddef.h>
+
+#include <functional>
+
+namespace fxcrt {
+
+// Returns how many threads the machine can run at once, which is at least 1.
+size_t GetMaxParallelism();
+
+// Runs `task(0)` on the calling thread and `task(1)` ... `task(count - 1)` on
+// new threads, and returns once all of them have finished. Nothing in PDFium
+// is shareable between threads unless stated otherwise, so `task` must only
+// touch state that is safe to use concurrently.
+void RunOnThreads(size_t count, const std::function<void(size_t)>& task);
+
+// Calls `task(i)` once for every `i` in [0, count), using up to
+// `thread_count` threads including the calling one. Each thread repeatedly
+// claims the lowest unclaimed index, so a thread that finishes its work early
+// takes over work that would otherwise wait for a busy thread.
+void ParallelFor(size_t count,
+                 size_t thread_count,
+                 const std::function<void(size_t)>& task);
+
+}  // namespace fxcrt
+
+#endif  // CORE_FXCRT_FX_PARALLEL_H_
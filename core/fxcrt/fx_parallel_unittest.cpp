@@ -0,0 +1,47 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/fx_parallel.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace fxcrt {
+
+TEST(FXParallelTest, GetMaxParallelism) {
+  EXPECT_GE(GetMaxParallelism(), 1u);
+}
+
+TEST(FXParallelTest, RunOnThreads) {
+  RunOnThreads(0, [](size_t) { ADD_FAILURE(); });
+
+  const std::thread::id caller = std::this_thread::get_id();
+  std::vector<std::thread::id> ids(4);
+  RunOnThreads(ids.size(),
+               [&ids](size_t i) { ids[i] = std::this_thread::get_id(); });
+  EXPECT_EQ(caller, ids[0]);
+  EXPECT_EQ(ids.size(),
+            std::set<std::thread::id>(ids.begin(), ids.end()).size());
+}
+
+TEST(FXParallelTest, ParallelForVisitsEachIndexOnce) {
+  static constexpr size_t kCount = 1000;
+  for (size_t thread_count : {0u, 1u, 3u, 16u}) {
+    std::vector<std::atomic<int>> visits(kCount);
+    ParallelFor(kCount, thread_count, [&visits](size_t i) { ++visits[i]; });
+    for (const auto& visit : visits) {
+      EXPECT_EQ(1, visit);
+    }
+  }
+}
+
+TEST(FXParallelTest, ParallelForEmpty) {
+  ParallelFor(0, 4, [](size_t) { ADD_FAILURE(); });
+}
+
+}  // namespace fxcrt
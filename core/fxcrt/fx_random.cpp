@@ -33,8 +33,8 @@ struct MTContext {
   std::array<uint32_t, MT_N> mt;
 };
 
-bool g_bHaveGlobalSeed = false;
-uint32_t g_nGlobalSeed = 0;
+thread_local bool g_bHaveGlobalSeed = false;
+thread_local uint32_t g_nGlobalSeed = 0;
 
 #if BUILDFLAG(IS_WIN)
 bool GenerateSeedFromCryptoRandom(uint32_t* pSeed) {
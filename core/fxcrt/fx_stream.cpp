@@ -9,8 +9,13 @@
 #include <memory>
 #include <utility>
 
+#include "build/build_config.h"
 #include "core/fxcrt/fileaccess_iface.h"
 
+#if BUILDFLAG(IS_POSIX)
+#include "core/fxcrt/cfx_mapped_file_stream.h"
+#endif
+
 namespace {
 
 class CFX_CRTFileStream final : public IFX_SeekableStream {
@@ -70,6 +75,13 @@ bool IFX_WriteStream::WriteFilesize(FX_FILESIZE size) {
 // static
 RetainPtr<IFX_SeekableReadStream> IFX_SeekableReadStream::CreateFromFilename(
     const char* filename) {
+#if BUILDFLAG(IS_POSIX)
+  RetainPtr<CFX_MappedFileStream> mapped =
+      CFX_MappedFileStream::Create(filename);
+  if (mapped) {
+    return mapped;
+  }
+#endif
   std::unique_ptr<FileAccessIface> pFA = FileAccessIface::Create();
   if (!pFA->Open(filename)) {
     return nullptr;
@@ -84,3 +96,7 @@ bool IFX_SeekableReadStream::IsEOF() {
 FX_FILESIZE IFX_SeekableReadStream::GetPosition() {
   return 0;
 }
+
+pdfium::span<const uint8_t> IFX_SeekableReadStream::GetResidentSpan() {
+  return {};
+}
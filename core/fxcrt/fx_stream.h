@@ -58,6 +58,13 @@ class IFX_SeekableReadStream : virtual public Retainable,
   virtual FX_FILESIZE GetPosition();
   [[nodiscard]] virtual bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                                                FX_FILESIZE offset) = 0;
+
+  // Returns the entire contents of the stream when they are resident in memory
+  // that lives as long as this object, e.g. a file mapping, so callers that
+  // hold a reference can read them without copying. The data may be read-only
+  // and shared, so callers must never write to it. Returns an empty span
+  // otherwise.
+  virtual pdfium::span<const uint8_t> GetResidentSpan();
 };
 
 class IFX_SeekableStream : public IFX_SeekableReadStream,
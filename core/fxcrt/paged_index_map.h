@@ -0,0 +1,331 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_PAGED_INDEX_MAP_H_
+#define CORE_FXCRT_PAGED_INDEX_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <bit>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/notreached.h"
+
+namespace fxcrt {
+
+// Maps uint32_t keys, such as PDF object numbers, to values. Keys below
+// `kMaxPagedKey` live in fixed-size pages that are allocated when a key in
+// them is first used, so lookups take constant time and a dense range of keys
+// needs one allocation per page instead of one per entry. The few keys above
+// that limit fall back to a std::map.
+//
+// Iteration visits entries in increasing key order. Dereferencing an iterator
+// yields a std::pair of the key and a reference to the value, by value, so it
+// cannot be bound to a non-const reference. Pointers to values stay valid
+// until their entry is erased.
+template <typename T>
+class PagedIndexMap {
+ public:
+  // Matches CPDF_Parser::kMaxObjectNumber, so that every valid object number
+  // is paged.
+  static constexpr uint32_t kMaxPagedKey = 4 * 1024 * 1024;
+
+  using key_type = uint32_t;
+  using mapped_type = T;
+  using value_type = std::pair<const uint32_t, T>;
+
+  template <bool kIsConst>
+  class Iterator {
+   public:
+    using MapType =
+        std::conditional_t<kIsConst, const PagedIndexMap, PagedIndexMap>;
+    using ValueRef = std::conditional_t<kIsConst, const T&, T&>;
+    using Entry = std::pair<uint32_t, ValueRef>;
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = PagedIndexMap::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = Entry;
+
+    class ArrowProxy {
+     public:
+      explicit ArrowProxy(Entry entry) : entry_(entry) {}
+      const Entry* operator->() const { return &entry_; }
+
+     private:
+      Entry entry_;
+    };
+
+    Iterator() = default;
+
+    Entry operator*() const { return Entry(key_, *map_->find(key_)); }
+    ArrowProxy operator->() const { return ArrowProxy(**this); }
+
+    Iterator& operator++() {
+      key_ = map_->NextKey(key_);
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.map_ == rhs.map_ && lhs.key_ == rhs.key_;
+    }
+
+   private:
+    friend class PagedIndexMap;
+
+    Iterator(MapType* map, uint64_t key) : map_(map), key_(key) {}
+
+    MapType* map_ = nullptr;
+    // kEndKey for the end iterator.
+    uint64_t key_ = kEndKey;
+  };
+
+  using iterator = Iterator</*kIsConst=*/false>;
+  using const_iterator = Iterator</*kIsConst=*/true>;
+
+  PagedIndexMap() = default;
+  PagedIndexMap(const PagedIndexMap&) = delete;
+  PagedIndexMap& operator=(const PagedIndexMap&) = delete;
+  PagedIndexMap(PagedIndexMap&&) = default;
+  PagedIndexMap& operator=(PagedIndexMap&&) = default;
+  ~PagedIndexMap() = default;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  void clear() {
+    pages_.clear();
+    overflow_.clear();
+    size_ = 0;
+  }
+
+  iterator begin() { return iterator(this, NextKey(kBeforeFirstKey)); }
+  iterator end() { return iterator(this, kEndKey); }
+  const_iterator begin() const {
+    return const_iterator(this, NextKey(kBeforeFirstKey));
+  }
+  const_iterator end() const { return const_iterator(this, kEndKey); }
+
+  bool contains(uint32_t key) const { return !!find(key); }
+
+  // Returns the value for `key`, or nullptr if there is none.
+  T* find(uint32_t key) {
+    return const_cast<T*>(std::as_const(*this).find(key));
+  }
+  const T* find(uint32_t key) const {
+    if (key >= kMaxPagedKey) {
+      auto it = overflow_.find(key);
+      return it != overflow_.end() ? &it->second : nullptr;
+    }
+    const Page* page = GetPage(key);
+    if (!page || !page->IsPresent(key % kPageSize)) {
+      return nullptr;
+    }
+    return &page->values[key % kPageSize];
+  }
+
+  // Adds a value for `key` constructed from `args` if there is none. Returns
+  // the value for `key`, and whether it was added.
+  template <typename... Args>
+  std::pair<T*, bool> try_emplace(uint32_t key, Args&&... args) {
+    if (key >= kMaxPagedKey) {
+      auto result = overflow_.try_emplace(key, std::forward<Args>(args)...);
+      if (result.second) {
+        ++size_;
+      }
+      return {&result.first->second, result.second};
+    }
+    Page* page = GetOrCreatePage(key);
+    const size_t index = key % kPageSize;
+    T* value = &page->values[index];
+    if (page->IsPresent(index)) {
+      return {value, false};
+    }
+    *value = T(std::forward<Args>(args)...);
+    page->SetPresent(index);
+    ++size_;
+    return {value, true};
+  }
+
+  T& operator[](uint32_t key) { return *try_emplace(key).first; }
+
+  // Returns whether there was an entry for `key`.
+  bool erase(uint32_t key) {
+    if (key >= kMaxPagedKey) {
+      if (!overflow_.erase(key)) {
+        return false;
+      }
+      --size_;
+      return true;
+    }
+    Page* page = GetPage(key);
+    const size_t index = key % kPageSize;
+    if (!page || !page->IsPresent(index)) {
+      return false;
+    }
+    page->values[index] = T();
+    page->ClearPresent(index);
+    --size_;
+    return true;
+  }
+
+  // Erases all entries with keys greater than or equal to `key`.
+  void erase_from(uint32_t key) {
+    size_ -= std::distance(overflow_.lower_bound(key), overflow_.end());
+    overflow_.erase(overflow_.lower_bound(key), overflow_.end());
+    if (key >= kMaxPagedKey) {
+      return;
+    }
+    const size_t page_index = key / kPageSize;
+    if (page_index >= pages_.size()) {
+      return;
+    }
+    for (size_t i = page_index + 1; i < pages_.size(); ++i) {
+      if (pages_[i]) {
+        size_ -= pages_[i]->Count();
+      }
+    }
+    pages_.resize(page_index + 1);
+    if (pages_[page_index]) {
+      for (size_t index = key % kPageSize; index < kPageSize; ++index) {
+        erase(static_cast<uint32_t>(page_index * kPageSize + index));
+      }
+    }
+  }
+
+  // Returns the greatest key. The map must not be empty.
+  uint32_t last_key() const {
+    CHECK(!empty());
+    if (!overflow_.empty()) {
+      return overflow_.rbegin()->first;
+    }
+    for (size_t page_index = pages_.size(); page_index > 0; --page_index) {
+      const Page* page = pages_[page_index - 1].get();
+      if (!page) {
+        continue;
+      }
+      for (size_t word = kWordsPerPage; word > 0; --word) {
+        const uint64_t bits = page->present[word - 1];
+        if (bits) {
+          return static_cast<uint32_t>((page_index - 1) * kPageSize +
+                                       (word - 1) * 64 + 63 -
+                                       std::countl_zero(bits));
+        }
+      }
+    }
+    NOTREACHED();
+  }
+
+  friend bool operator==(const PagedIndexMap& lhs, const PagedIndexMap& rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (auto lhs_it = lhs.begin(), rhs_it = rhs.begin(); lhs_it != lhs.end();
+         ++lhs_it, ++rhs_it) {
+      if (lhs_it->first != rhs_it->first ||
+          !(lhs_it->second == rhs_it->second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr size_t kPageSize = 256;
+  static constexpr size_t kWordsPerPage = kPageSize / 64;
+  static constexpr uint64_t kBeforeFirstKey = static_cast<uint64_t>(-1);
+  static constexpr uint64_t kEndKey = uint64_t{1} << 32;
+
+  struct Page {
+    bool IsPresent(size_t index) const {
+      return present[index / 64] & (uint64_t{1} << (index % 64));
+    }
+    void SetPresent(size_t index) {
+      present[index / 64] |= uint64_t{1} << (index % 64);
+    }
+    void ClearPresent(size_t index) {
+      present[index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+    size_t Count() const {
+      size_t count = 0;
+      for (uint64_t bits : present) {
+        count += std::popcount(bits);
+      }
+      return count;
+    }
+
+    std::array<T, kPageSize> values = {};
+    std::array<uint64_t, kWordsPerPage> present = {};
+  };
+
+  const Page* GetPage(uint32_t key) const {
+    const size_t page_index = key / kPageSize;
+    return page_index < pages_.size() ? pages_[page_index].get() : nullptr;
+  }
+  Page* GetPage(uint32_t key) {
+    return const_cast<Page*>(std::as_const(*this).GetPage(key));
+  }
+  Page* GetOrCreatePage(uint32_t key) {
+    const size_t page_index = key / kPageSize;
+    if (page_index >= pages_.size()) {
+      pages_.resize(page_index + 1);
+    }
+    if (!pages_[page_index]) {
+      pages_[page_index] = std::make_unique<Page>();
+    }
+    return pages_[page_index].get();
+  }
+
+  // Returns the smallest key greater than `key`, or kEndKey if there is none.
+  uint64_t NextKey(uint64_t key) const {
+    uint64_t next = key + 1;
+    for (size_t page_index = next / kPageSize; page_index < pages_.size();
+         ++page_index) {
+      const Page* page = pages_[page_index].get();
+      if (page) {
+        for (size_t word = next % kPageSize / 64; word < kWordsPerPage;
+             ++word) {
+          uint64_t bits = page->present[word];
+          if (word == next % kPageSize / 64) {
+            bits &= ~uint64_t{0} << (next % 64);
+          }
+          if (bits) {
+            return page_index * kPageSize + word * 64 + std::countr_zero(bits);
+          }
+        }
+      }
+      next = (page_index + 1) * kPageSize;
+    }
+    auto it = overflow_.lower_bound(
+        static_cast<uint32_t>(std::min<uint64_t>(next, UINT32_MAX)));
+    if (next > UINT32_MAX || it == overflow_.end()) {
+      return kEndKey;
+    }
+    return it->first;
+  }
+
+  std::vector<std::unique_ptr<Page>> pages_;
+  std::map<uint32_t, T> overflow_;
+  size_t size_ = 0;
+};
+
+}  // namespace fxcrt
+
+using fxcrt::PagedIndexMap;
+
+#endif  // CORE_FXCRT_PAGED_INDEX_MAP_H_
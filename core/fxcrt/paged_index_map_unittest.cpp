@@ -0,0 +1,126 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/paged_index_map.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <tuple>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::Pair;
+
+TEST(PagedIndexMap, Empty) {
+  PagedIndexMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_FALSE(map.find(0));
+  EXPECT_FALSE(map.contains(12345));
+  EXPECT_FALSE(map.erase(7));
+}
+
+TEST(PagedIndexMap, InsertFindErase) {
+  PagedIndexMap<int> map;
+  map[3] = 30;
+  auto [value, inserted] = map.try_emplace(1000, 10);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(10, *value);
+  std::tie(value, inserted) = map.try_emplace(3, 99);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(30, *value);
+
+  EXPECT_EQ(2u, map.size());
+  ASSERT_TRUE(map.find(3));
+  EXPECT_EQ(30, *map.find(3));
+  EXPECT_FALSE(map.find(4));
+
+  // Keys that are present with a default value are still present.
+  map[4];
+  ASSERT_TRUE(map.find(4));
+  EXPECT_EQ(0, *map.find(4));
+
+  EXPECT_TRUE(map.erase(3));
+  EXPECT_FALSE(map.erase(3));
+  EXPECT_FALSE(map.contains(3));
+  EXPECT_THAT(map, ElementsAre(Pair(4, 0), Pair(1000, 10)));
+}
+
+TEST(PagedIndexMap, LargeKeys) {
+  constexpr uint32_t kMaxKey = std::numeric_limits<uint32_t>::max();
+  PagedIndexMap<int> map;
+  map[kMaxKey] = 1;
+  map[PagedIndexMap<int>::kMaxPagedKey] = 2;
+  map[PagedIndexMap<int>::kMaxPagedKey - 1] = 3;
+  map[0] = 4;
+  EXPECT_EQ(4u, map.size());
+  EXPECT_EQ(kMaxKey, map.last_key());
+  EXPECT_THAT(map, ElementsAre(Pair(0, 4),
+                               Pair(PagedIndexMap<int>::kMaxPagedKey - 1, 3),
+                               Pair(PagedIndexMap<int>::kMaxPagedKey, 2),
+                               Pair(kMaxKey, 1)));
+
+  EXPECT_TRUE(map.erase(kMaxKey));
+  EXPECT_EQ(PagedIndexMap<int>::kMaxPagedKey, map.last_key());
+}
+
+TEST(PagedIndexMap, IterateInKeyOrder) {
+  PagedIndexMap<int> map;
+  for (uint32_t key : {700u, 5u, 64u, 63u, 256u, 255u, 0u}) {
+    map[key] = static_cast<int>(key) * 2;
+  }
+  EXPECT_THAT(map, ElementsAre(Pair(0, 0), Pair(5, 10), Pair(63, 126),
+                               Pair(64, 128), Pair(255, 510), Pair(256, 512),
+                               Pair(700, 1400)));
+  EXPECT_EQ(700u, map.last_key());
+
+  // Values can be modified through iterators.
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    ++it->second;
+  }
+  EXPECT_EQ(11, *map.find(5));
+}
+
+TEST(PagedIndexMap, EraseFrom) {
+  PagedIndexMap<int> map;
+  for (uint32_t key = 0; key < 1000; key += 7) {
+    map[key] = 1;
+  }
+  map[PagedIndexMap<int>::kMaxPagedKey + 5] = 1;
+  map.erase_from(300);
+  EXPECT_EQ(43u, map.size());
+  EXPECT_EQ(294u, map.last_key());
+  EXPECT_FALSE(map.contains(301));
+  EXPECT_FALSE(map.contains(PagedIndexMap<int>::kMaxPagedKey + 5));
+
+  map.erase_from(0);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PagedIndexMap, PointersStayValid) {
+  PagedIndexMap<int> map;
+  int* value = &map[10];
+  for (uint32_t key = 11; key < 100000; ++key) {
+    map[key] = 1;
+  }
+  *value = 42;
+  EXPECT_EQ(42, *map.find(10));
+}
+
+TEST(PagedIndexMap, Equality) {
+  PagedIndexMap<int> map1;
+  PagedIndexMap<int> map2;
+  EXPECT_EQ(map1, map2);
+  map1[1] = 1;
+  EXPECT_NE(map1, map2);
+  map2[1] = 2;
+  EXPECT_NE(map1, map2);
+  map2[1] = 1;
+  EXPECT_EQ(map1, map2);
+}
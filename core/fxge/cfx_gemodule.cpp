@@ -15,6 +15,10 @@ namespace {
 
 CFX_GEModule* g_pGEModule = nullptr;
 
+// Set on threads with their own module, so that their font and glyph caches
+// are not shared with other threads. Overrides `g_pGEModule`.
+thread_local CFX_GEModule* g_pThreadGEModule = nullptr;
+
 }  // namespace
 
 CFX_GEModule::CFX_GEModule(const char** pUserFontPaths)
@@ -41,8 +45,27 @@ void CFX_GEModule::Destroy() {
   g_pGEModule = nullptr;
 }
 
+// static
+void CFX_GEModule::CreateForThread(const char** pUserFontPaths) {
+  DCHECK(!g_pThreadGEModule);
+  g_pThreadGEModule = new CFX_GEModule(pUserFontPaths);
+  g_pThreadGEModule->platform_->Init();
+  g_pThreadGEModule->GetFontMgr()->GetBuiltinMapper()->SetSystemFontInfo(
+      g_pThreadGEModule->platform_->CreateDefaultSystemFontInfo());
+}
+
+// static
+void CFX_GEModule::DestroyForThread() {
+  DCHECK(g_pThreadGEModule);
+  delete g_pThreadGEModule;
+  g_pThreadGEModule = nullptr;
+}
+
 // static
 CFX_GEModule* CFX_GEModule::Get() {
+  if (g_pThreadGEModule) {
+    return g_pThreadGEModule;
+  }
   DCHECK(g_pGEModule);
   return g_pGEModule;
 }
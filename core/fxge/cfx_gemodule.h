@@ -7,6 +7,7 @@
 #ifndef CORE_FXGE_CFX_GEMODULE_H_
 #define CORE_FXGE_CFX_GEMODULE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -39,6 +40,12 @@ class CFX_GEModule {
 
   static void Create(const char** pUserFontPaths);
   static void Destroy();
+
+  // Gives the calling thread its own module, which Get() returns instead of
+  // the process-wide one until DestroyForThread().
+  static void CreateForThread(const char** pUserFontPaths);
+  static void DestroyForThread();
+
   static CFX_GEModule* Get();
 
   CFX_FontCache* GetFontCache() const { return font_cache_.get(); }
@@ -46,6 +53,11 @@ class CFX_GEModule {
   PlatformIface* GetPlatform() const { return platform_.get(); }
   const char** GetUserFontPaths() const { return user_font_paths_; }
 
+  // The most threads that stretching or transforming one image may use,
+  // including the calling thread. Defaults to 1.
+  size_t GetImageThreadCount() const { return image_thread_count_; }
+  void SetImageThreadCount(size_t count) { image_thread_count_ = count; }
+
  private:
   explicit CFX_GEModule(const char** pUserFontPaths);
   ~CFX_GEModule();
@@ -56,6 +68,7 @@ class CFX_GEModule {
 
   // Exclude because taken from public API.
   UNOWNED_PTR_EXCLUSION const char** const user_font_paths_;
+  size_t image_thread_count_ = 1;
 };
 
 #endif  // CORE_FXGE_CFX_GEMODULE_H_
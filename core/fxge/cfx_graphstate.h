@@ -22,6 +22,11 @@ class CFX_GraphState {
 
   void Emplace();
 
+  // True if both refer to the same data, which implies equal values.
+  bool SharesDataWith(const CFX_GraphState& that) const {
+    return ref_ == that.ref_;
+  }
+
   void SetLineDash(std::vector<float> dashes, float phase);
   void SetLineDashPhase(float phase);
   std::vector<float> GetLineDashArray() const;
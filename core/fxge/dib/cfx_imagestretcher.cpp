@@ -13,6 +13,7 @@
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/span.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/cstretchengine.h"
@@ -113,6 +114,7 @@ bool CFX_ImageStretcher::StartStretch() {
   stretch_engine_ = std::make_unique<CStretchEngine>(
       dest_, dest_format_, dest_width_, dest_height_, clip_rect_, source_,
       resample_options_);
+  stretch_engine_->SetThreadCount(CFX_GEModule::Get()->GetImageThreadCount());
   stretch_engine_->StartStretchHorz();
   if (SourceSizeWithinLimit(source_->GetWidth(), source_->GetHeight())) {
     stretch_engine_->Continue(nullptr);
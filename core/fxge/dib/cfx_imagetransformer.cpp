@@ -8,6 +8,7 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <array>
 #include <iterator>
 #include <memory>
@@ -15,10 +16,12 @@
 
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/fx_parallel.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/notreached.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/stl_util.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/cfx_imagestretcher.h"
 #include "core/fxge/dib/fx_dib.h"
@@ -29,6 +32,10 @@ constexpr int kBase = 256;
 constexpr float kFix16 = 0.05f;
 constexpr uint8_t kOpaqueAlpha = 0xff;
 
+// The least number of result pixels each thread should make, as starting
+// threads has a cost.
+constexpr int64_t kMinPixelsPerThread = 256 * 1024;
+
 uint8_t BilinearInterpolate(const uint8_t* buf,
                             const CFX_ImageTransformer::BilinearData& data,
                             int bytes_per_pixel,
@@ -87,32 +94,50 @@ class CFX_BilinearMatrix {
   const int f;
 };
 
-bool InStretchBounds(const FX_RECT& clip_rect, int col, int row) {
-  return col >= 0 && col <= clip_rect.Width() && row >= 0 &&
-         row <= clip_rect.Height();
+bool InStretchBounds(const FX_RECT& stretch_rect, int col, int row) {
+  return col >= 0 && col <= stretch_rect.Width() && row >= 0 &&
+         row <= stretch_rect.Height();
 }
 
-void AdjustCoords(const FX_RECT& clip_rect, int* col, int* row) {
+void AdjustCoords(const FX_RECT& stretch_rect, int* col, int* row) {
   int& src_col = *col;
   int& src_row = *row;
-  if (src_col == clip_rect.Width()) {
+  if (src_col == stretch_rect.Width()) {
     src_col--;
   }
-  if (src_row == clip_rect.Height()) {
+  if (src_row == stretch_rect.Height()) {
     src_row--;
   }
 }
 
 // Let the compiler deduce the type for |func|, which cheaper than specifying it
 // with std::function.
+//
+// `calc_data.matrix` maps the unclipped result to `stretch_rect`, so that each
+// pixel comes out the same no matter how the result is clipped. `stretch_clip`
+// is the part of `stretch_rect` that was actually stretched.
+//
+// Rows are independent, so they are spread over up to `calc_data.thread_count`
+// threads.
 template <typename F>
 void DoBilinearLoop(const CFX_ImageTransformer::CalcData& calc_data,
                     const FX_RECT& result_rect,
-                    const FX_RECT& clip_rect,
+                    const CFX_Point& result_offset,
+                    const FX_RECT& stretch_rect,
+                    const FX_RECT& stretch_clip,
                     int increment,
                     const F& func) {
   CFX_BilinearMatrix matrix_fix(calc_data.matrix);
-  for (int row = 0; row < result_rect.Height(); row++) {
+  const int clip_col_offset = stretch_clip.left - stretch_rect.left;
+  const int clip_row_offset = stretch_clip.top - stretch_rect.top;
+  const int64_t pixels =
+      static_cast<int64_t>(result_rect.Width()) * result_rect.Height();
+  const size_t thread_count =
+      std::min(calc_data.thread_count,
+               static_cast<size_t>(
+                   std::max<int64_t>(pixels / kMinPixelsPerThread, 1)));
+  fxcrt::ParallelFor(result_rect.Height(), thread_count, [&](size_t row_index) {
+    const int row = static_cast<int>(row_index);
     uint8_t* dest = calc_data.bitmap->GetWritableScanline(row).data();
     for (int col = 0; col < result_rect.Width(); col++) {
       CFX_ImageTransformer::BilinearData d;
@@ -120,20 +145,28 @@ void DoBilinearLoop(const CFX_ImageTransformer::CalcData& calc_data,
       d.res_y = 0;
       d.src_col_l = 0;
       d.src_row_l = 0;
-      matrix_fix.Transform(col, row, &d.src_col_l, &d.src_row_l, &d.res_x,
-                           &d.res_y);
-      if (LIKELY(InStretchBounds(clip_rect, d.src_col_l, d.src_row_l))) {
-        AdjustCoords(clip_rect, &d.src_col_l, &d.src_row_l);
+      matrix_fix.Transform(col + result_offset.x, row + result_offset.y,
+                           &d.src_col_l, &d.src_row_l, &d.res_x, &d.res_y);
+      if (LIKELY(InStretchBounds(stretch_rect, d.src_col_l, d.src_row_l))) {
+        AdjustCoords(stretch_rect, &d.src_col_l, &d.src_row_l);
         d.src_col_r = d.src_col_l + 1;
         d.src_row_r = d.src_row_l + 1;
-        AdjustCoords(clip_rect, &d.src_col_r, &d.src_row_r);
-        d.row_offset_l = d.src_row_l * calc_data.pitch;
-        d.row_offset_r = d.src_row_r * calc_data.pitch;
-        func(d, dest);
+        AdjustCoords(stretch_rect, &d.src_col_r, &d.src_row_r);
+        d.src_col_l -= clip_col_offset;
+        d.src_col_r -= clip_col_offset;
+        d.src_row_l -= clip_row_offset;
+        d.src_row_r -= clip_row_offset;
+        if (LIKELY(d.src_col_l >= 0 && d.src_row_l >= 0 &&
+                   d.src_col_r < stretch_clip.Width() &&
+                   d.src_row_r < stretch_clip.Height())) {
+          d.row_offset_l = d.src_row_l * calc_data.pitch;
+          d.row_offset_r = d.src_row_r * calc_data.pitch;
+          func(d, dest);
+        }
       }
       UNSAFE_TODO(dest += increment);
     }
-  }
+  });
 }
 
 }  // namespace
@@ -200,18 +233,37 @@ CFX_ImageTransformer::CFX_ImageTransformer(RetainPtr<const CFX_DIBBase> source,
                  matrix_.e, matrix_.f));
   CFX_Matrix dest_to_strech = stretch_to_dest.GetInverse();
 
+  FX_RECT stretch_rect =
+      dest_to_strech.TransformRect(CFX_FloatRect(result_rect)).GetOuterRect();
+  if (!stretch_rect.Valid()) {
+    return;
+  }
+
+  stretch_rect.Intersect(0, 0, stretch_width, stretch_height);
+  if (!stretch_rect.Valid()) {
+    return;
+  }
+
+  // Only stretch what `result_clip` needs, plus a margin for the neighbouring
+  // pixels used by the bilinear interpolation and for rounding.
   FX_RECT stretch_clip =
       dest_to_strech.TransformRect(CFX_FloatRect(result_clip)).GetOuterRect();
   if (!stretch_clip.Valid()) {
     return;
   }
 
-  stretch_clip.Intersect(0, 0, stretch_width, stretch_height);
+  stretch_clip.left -= 2;
+  stretch_clip.top -= 2;
+  stretch_clip.right += 2;
+  stretch_clip.bottom += 2;
+  stretch_clip.Intersect(stretch_rect);
   if (!stretch_clip.Valid()) {
     return;
   }
 
   dest_to_stretch_ = dest_to_strech;
+  result_origin_ = CFX_Point(result_rect.left, result_rect.top);
+  stretch_rect_ = stretch_rect;
   stretch_clip_ = stretch_clip;
   stretcher_ = std::make_unique<CFX_ImageStretcher>(
       &storer_, src_, stretch_width, stretch_height, stretch_clip_,
@@ -267,13 +319,15 @@ void CFX_ImageTransformer::ContinueOther(PauseIndicatorIface* pPause) {
     return;
   }
 
-  CFX_Matrix result2stretch(1.0f, 0.0f, 0.0f, 1.0f, result_.left, result_.top);
+  CFX_Matrix result2stretch(1.0f, 0.0f, 0.0f, 1.0f, result_origin_.x,
+                            result_origin_.y);
   result2stretch.Concat(dest_to_stretch_);
-  result2stretch.Translate(-stretch_clip_.left, -stretch_clip_.top);
+  result2stretch.Translate(-stretch_rect_.left, -stretch_rect_.top);
 
   CalcData calc_data = {pTransformed.Get(), result2stretch,
                         storer_.GetBitmap()->GetBuffer().data(),
-                        storer_.GetBitmap()->GetPitch()};
+                        storer_.GetBitmap()->GetPitch(),
+                        CFX_GEModule::Get()->GetImageThreadCount()};
   if (storer_.GetBitmap()->IsMaskFormat()) {
     CalcAlpha(calc_data);
   } else {
@@ -287,6 +341,11 @@ void CFX_ImageTransformer::ContinueOther(PauseIndicatorIface* pPause) {
   storer_.Replace(std::move(pTransformed));
 }
 
+CFX_Point CFX_ImageTransformer::GetResultOffset() const {
+  return CFX_Point(result_.left - result_origin_.x,
+                   result_.top - result_origin_.y);
+}
+
 RetainPtr<CFX_DIBitmap> CFX_ImageTransformer::DetachBitmap() {
   return storer_.Detach();
 }
@@ -295,7 +354,8 @@ void CFX_ImageTransformer::CalcAlpha(const CalcData& calc_data) {
   auto func = [&calc_data](const BilinearData& data, uint8_t* dest) {
     *dest = BilinearInterpolate(calc_data.buf, data, 1, 0);
   };
-  DoBilinearLoop(calc_data, result_, stretch_clip_, 1, func);
+  DoBilinearLoop(calc_data, result_, GetResultOffset(), stretch_rect_,
+                 stretch_clip_, 1, func);
 }
 
 void CFX_ImageTransformer::CalcMono(const CalcData& calc_data) {
@@ -314,7 +374,8 @@ void CFX_ImageTransformer::CalcMono(const CalcData& calc_data) {
     uint8_t idx = BilinearInterpolate(calc_data.buf, data, 1, 0);
     *reinterpret_cast<uint32_t*>(dest) = argb[idx];
   };
-  DoBilinearLoop(calc_data, result_, stretch_clip_, dest_bytes_per_pixel, func);
+  DoBilinearLoop(calc_data, result_, GetResultOffset(), stretch_rect_,
+                 stretch_clip_, dest_bytes_per_pixel, func);
 }
 
 void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
@@ -334,8 +395,8 @@ void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
           BilinearInterpolate(calc_data.buf, data, src_bytes_per_pixel, 2);
       *reinterpret_cast<uint32_t*>(dest) = ArgbEncode(kOpaqueAlpha, r, g, b);
     };
-    DoBilinearLoop(calc_data, result_, stretch_clip_, dest_bytes_per_pixel,
-                   func);
+    DoBilinearLoop(calc_data, result_, GetResultOffset(), stretch_rect_,
+                   stretch_clip_, dest_bytes_per_pixel, func);
     return;
   }
 
@@ -352,8 +413,8 @@ void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
           BilinearInterpolate(calc_data.buf, data, src_bytes_per_pixel, 3);
       *reinterpret_cast<uint32_t*>(dest) = ArgbEncode(alpha, r, g, b);
     };
-    DoBilinearLoop(calc_data, result_, stretch_clip_, dest_bytes_per_pixel,
-                   func);
+    DoBilinearLoop(calc_data, result_, GetResultOffset(), stretch_rect_,
+                   stretch_clip_, dest_bytes_per_pixel, func);
     return;
   }
 
@@ -369,5 +430,6 @@ void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
         BilinearInterpolate(calc_data.buf, data, src_bytes_per_pixel, 3);
     *reinterpret_cast<uint32_t*>(dest) = FXCMYK_TODIB(CmykEncode(c, m, y, k));
   };
-  DoBilinearLoop(calc_data, result_, stretch_clip_, dest_bytes_per_pixel, func);
+  DoBilinearLoop(calc_data, result_, GetResultOffset(), stretch_rect_,
+                 stretch_clip_, dest_bytes_per_pixel, func);
 }
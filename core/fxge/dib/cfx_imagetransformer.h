@@ -37,6 +37,7 @@ class CFX_ImageTransformer {
     const CFX_Matrix& matrix;
     const uint8_t* buf;
     uint32_t pitch;
+    size_t thread_count;
   };
 
   CFX_ImageTransformer(RetainPtr<const CFX_DIBBase> source,
@@ -61,6 +62,9 @@ class CFX_ImageTransformer {
   void ContinueRotate(PauseIndicatorIface* pPause);
   void ContinueOther(PauseIndicatorIface* pPause);
 
+  // Returns the offset of `result_` within the unclipped result.
+  CFX_Point GetResultOffset() const;
+
   void CalcAlpha(const CalcData& calc_data);
   void CalcMono(const CalcData& calc_data);
   void CalcColor(const CalcData& calc_data,
@@ -69,6 +73,8 @@ class CFX_ImageTransformer {
 
   RetainPtr<const CFX_DIBBase> const src_;
   const CFX_Matrix matrix_;
+  CFX_Point result_origin_;
+  FX_RECT stretch_rect_;
   FX_RECT stretch_clip_;
   FX_RECT result_;
   CFX_Matrix dest_to_stretch_;
@@ -0,0 +1,72 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_imagetransformer.h"
+
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/stl_util.h"
+#include "core/fxge/cfx_gemodule.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+RetainPtr<CFX_DIBitmap> MakeTestBitmap(int width,
+                                       int height,
+                                       FXDIB_Format format) {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  CHECK(bitmap->Create(width, height, format));
+  std::vector<uint8_t> bytes(bitmap->GetBuffer().size());
+  uint32_t seed = 1;
+  for (auto& byte : bytes) {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<uint8_t>(seed >> 16);
+  }
+  fxcrt::Copy(bytes, bitmap->GetWritableBuffer());
+  return bitmap;
+}
+
+RetainPtr<CFX_DIBitmap> Transform(RetainPtr<const CFX_DIBitmap> source,
+                                  const CFX_Matrix& matrix,
+                                  size_t thread_count) {
+  CFX_GEModule::Get()->SetImageThreadCount(thread_count);
+  CFX_ImageTransformer transformer(std::move(source), matrix,
+                                   FXDIB_ResampleOptions(), nullptr);
+  while (transformer.Continue(nullptr)) {
+  }
+  CFX_GEModule::Get()->SetImageThreadCount(1);
+  return transformer.DetachBitmap();
+}
+
+}  // namespace
+
+TEST(CFX_ImageTransformer, Threads) {
+  static constexpr FXDIB_Format kFormats[] = {
+      FXDIB_Format::k8bppMask,
+      FXDIB_Format::k8bppRgb,
+      FXDIB_Format::kBgr,
+      FXDIB_Format::kBgra,
+  };
+  // Skewed, so that both the stretch and the bilinear pass run, on enough
+  // pixels for 2 or more threads.
+  const CFX_Matrix matrix(900, 300, -250, 800, 0, 0);
+  for (FXDIB_Format format : kFormats) {
+    RetainPtr<CFX_DIBitmap> source = MakeTestBitmap(600, 500, format);
+    RetainPtr<CFX_DIBitmap> expected = Transform(source, matrix, 1);
+    ASSERT_TRUE(expected);
+
+    RetainPtr<CFX_DIBitmap> result = Transform(source, matrix, 4);
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(expected->GetBuffer() == result->GetBuffer())
+        << static_cast<int>(format);
+  }
+}
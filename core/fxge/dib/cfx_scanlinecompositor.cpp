@@ -7,17 +7,20 @@
 #include "core/fxge/dib/cfx_scanlinecompositor.h"
 
 #include <algorithm>
+#include <type_traits>
 
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxcrt/notreached.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/span_util.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxcrt/zip.h"
 #include "core/fxge/dib/blend.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/dib/fx_dib_simd.h"
 
 using fxge::Blend;
 
@@ -426,10 +429,17 @@ void CompositeRow_Bgr2Bgra_NoBlend_NoClip(pdfium::span<uint8_t> dest_span,
                                           pdfium::span<const uint8_t> src_span,
                                           int width,
                                           int src_Bpp) {
-  uint8_t* dest_scan = dest_span.data();
-  const uint8_t* src_scan = src_span.data();
+  size_t done = 0;
+  if (src_Bpp == 3) {
+    done = fxge::CompositeRowBgr2Bgrx(src_span, dest_span,
+                                      pdfium::checked_cast<size_t>(width),
+                                      /*set_alpha=*/true);
+  }
+  int col = pdfium::checked_cast<int>(done);
+  uint8_t* dest_scan = dest_span.subspan(done * 4).data();
+  const uint8_t* src_scan = src_span.subspan(done * src_Bpp).data();
   UNSAFE_TODO({
-    for (int col = 0; col < width; col++) {
+    for (; col < width; col++) {
       if (src_Bpp == 4) {
         FXARGB_SetDIB(dest_scan, 0xff000000 | FXARGB_GetDIB(src_scan));
       } else {
@@ -603,6 +613,18 @@ void CompositeRowBgra2Bgra(pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src_span,
                            pdfium::span<const uint8_t> clip_span,
                            pdfium::span<DestPixelStruct> dest_span,
                            BlendMode blend_type) {
+  if constexpr (std::is_same_v<DestPixelStruct, FX_BGRA_STRUCT<uint8_t>>) {
+    if (blend_type == BlendMode::kNormal) {
+      const size_t done =
+          fxge::CompositeRowBgra2BgraNormal(src_span, clip_span, dest_span);
+      src_span = src_span.subspan(done);
+      dest_span = dest_span.subspan(done);
+      if (!clip_span.empty()) {
+        clip_span = clip_span.subspan(done);
+      }
+    }
+  }
+
   const bool non_separable_blend = IsNonSeparableBlendMode(blend_type);
   if (clip_span.empty()) {
     if (non_separable_blend) {
@@ -866,7 +888,15 @@ void CompositeRow_Rgb2Rgb_NoBlend_NoClip(pdfium::span<uint8_t> dest_span,
       FXSYS_memcpy(dest_scan, src_scan, width * dest_Bpp);
       return;
     }
-    for (int col = 0; col < width; col++) {
+    int col = 0;
+    if (dest_Bpp == 4 && src_Bpp == 3) {
+      col = pdfium::checked_cast<int>(fxge::CompositeRowBgr2Bgrx(
+          src_span, dest_span, pdfium::checked_cast<size_t>(width),
+          /*set_alpha=*/false));
+      dest_scan += col * 4;
+      src_scan += col * 3;
+    }
+    for (; col < width; col++) {
       FXSYS_memcpy(dest_scan, src_scan, 3);
       dest_scan += dest_Bpp;
       src_scan += src_Bpp;
@@ -1195,9 +1225,21 @@ void CompositeRow_ByteMask2Bgra(pdfium::span<uint8_t> dest_span,
                                 int pixel_count,
                                 BlendMode blend_type,
                                 pdfium::span<const uint8_t> clip_span) {
-  uint8_t* dest_scan = dest_span.data();
+  size_t done = 0;
+  if (blend_type == BlendMode::kNormal) {
+    const size_t count = pdfium::checked_cast<size_t>(pixel_count);
+    done = fxge::CompositeRowByteMask2BgraNormal(
+        src_span.first(count), clip_span, mask_alpha,
+        {.blue = static_cast<uint8_t>(src_b),
+         .green = static_cast<uint8_t>(src_g),
+         .red = static_cast<uint8_t>(src_r)},
+        fxcrt::reinterpret_span<FX_BGRA_STRUCT<uint8_t>>(
+            dest_span.first(count * 4)));
+  }
+  int col = pdfium::checked_cast<int>(done);
+  uint8_t* dest_scan = dest_span.subspan(done * 4).data();
   UNSAFE_TODO({
-    for (int col = 0; col < pixel_count; col++) {
+    for (; col < pixel_count; col++) {
       int src_alpha = GetAlphaWithSrc(mask_alpha, clip_span, src_span, col);
       uint8_t back_alpha = dest_scan[3];
       if (back_alpha == 0) {
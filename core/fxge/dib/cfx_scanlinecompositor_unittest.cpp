@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <array>
+#include <vector>
 
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/stl_util.h"
@@ -101,6 +102,65 @@ void RunPreMultiplyTest(
 }
 #endif  // defined(PDF_USE_SKIA)
 
+// Long enough for the vectorized paths to run several times and leave an odd
+// tail for the scalar code.
+constexpr int kLongWidth = 37;
+
+std::vector<uint8_t> MakeTestBytes(size_t size, uint32_t seed) {
+  std::vector<uint8_t> bytes(size);
+  for (auto& byte : bytes) {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<uint8_t>(seed >> 16);
+  }
+  // Include the extreme values, which take special paths.
+  for (size_t i = 0; i < size; i += 7) {
+    bytes[i] = (i / 7) % 2 ? 255 : 0;
+  }
+  return bytes;
+}
+
+// Checks that compositing a whole row gives the same result as compositing
+// each pixel on its own, which only ever uses the scalar code.
+void RunRgbRowTest(CFX_ScanlineCompositor& compositor,
+                   int dest_bpp,
+                   int src_bpp,
+                   bool use_clip) {
+  const std::vector<uint8_t> src =
+      MakeTestBytes(kLongWidth * src_bpp, /*seed=*/1);
+  const std::vector<uint8_t> clip =
+      use_clip ? MakeTestBytes(kLongWidth, /*seed=*/2) : std::vector<uint8_t>();
+  std::vector<uint8_t> dest_row = MakeTestBytes(kLongWidth * dest_bpp, 3);
+  std::vector<uint8_t> dest_pixels = dest_row;
+  compositor.CompositeRgbBitmapLine(dest_row, src, kLongWidth, clip);
+  for (int i = 0; i < kLongWidth; ++i) {
+    compositor.CompositeRgbBitmapLine(
+        pdfium::span(dest_pixels).subspan(static_cast<size_t>(i * dest_bpp),
+                                          static_cast<size_t>(dest_bpp)),
+        pdfium::span(src).subspan(static_cast<size_t>(i * src_bpp),
+                                   static_cast<size_t>(src_bpp)), 1,
+        use_clip ? pdfium::span(clip).subspan(static_cast<size_t>(i), 1u)
+                 : pdfium::span<const uint8_t>());
+  }
+  EXPECT_THAT(dest_row, ElementsAreArray(dest_pixels));
+}
+
+void RunByteMaskRowTest(CFX_ScanlineCompositor& compositor, bool use_clip) {
+  const std::vector<uint8_t> src = MakeTestBytes(kLongWidth, /*seed=*/4);
+  const std::vector<uint8_t> clip =
+      use_clip ? MakeTestBytes(kLongWidth, /*seed=*/5) : std::vector<uint8_t>();
+  std::vector<uint8_t> dest_row = MakeTestBytes(kLongWidth * 4, /*seed=*/6);
+  std::vector<uint8_t> dest_pixels = dest_row;
+  compositor.CompositeByteMaskLine(dest_row, src, kLongWidth, clip);
+  for (int i = 0; i < kLongWidth; ++i) {
+    compositor.CompositeByteMaskLine(
+        pdfium::span(dest_pixels).subspan(static_cast<size_t>(i * 4), 4u),
+        pdfium::span(src).subspan(static_cast<size_t>(i), 1u), 1,
+        use_clip ? pdfium::span(clip).subspan(static_cast<size_t>(i), 1u)
+                 : pdfium::span<const uint8_t>());
+  }
+  EXPECT_THAT(dest_row, ElementsAreArray(dest_pixels));
+}
+
 }  // namespace
 
 inline bool operator==(const FX_BGRA_STRUCT<uint8_t>& lhs,
@@ -374,3 +434,47 @@ TEST(ScanlineCompositorTest, CompositeRgbBitmapLineBgraPremulHue) {
   RunPreMultiplyTest(compositor, kSrcScan3, kExpectations3);
 }
 #endif  // defined(PDF_USE_SKIA)
+
+TEST(ScanlineCompositorTest, CompositeRgbBitmapLineBgraNormalLongRow) {
+  CFX_ScanlineCompositor compositor;
+  ASSERT_TRUE(compositor.Init(/*dest_format=*/FXDIB_Format::kBgra,
+                              /*src_format=*/FXDIB_Format::kBgra,
+                              /*src_palette=*/{},
+                              /*mask_color=*/0,
+                              /*blend_type=*/BlendMode::kNormal,
+                              /*bRgbByteOrder=*/false));
+  RunRgbRowTest(compositor, /*dest_bpp=*/4, /*src_bpp=*/4, /*use_clip=*/false);
+  RunRgbRowTest(compositor, /*dest_bpp=*/4, /*src_bpp=*/4, /*use_clip=*/true);
+}
+
+TEST(ScanlineCompositorTest, CompositeRgbBitmapLineBgrLongRow) {
+  CFX_ScanlineCompositor compositor;
+  ASSERT_TRUE(compositor.Init(/*dest_format=*/FXDIB_Format::kBgra,
+                              /*src_format=*/FXDIB_Format::kBgr,
+                              /*src_palette=*/{},
+                              /*mask_color=*/0,
+                              /*blend_type=*/BlendMode::kNormal,
+                              /*bRgbByteOrder=*/false));
+  RunRgbRowTest(compositor, /*dest_bpp=*/4, /*src_bpp=*/3, /*use_clip=*/false);
+
+  ASSERT_TRUE(compositor.Init(/*dest_format=*/FXDIB_Format::kBgrx,
+                              /*src_format=*/FXDIB_Format::kBgr,
+                              /*src_palette=*/{},
+                              /*mask_color=*/0,
+                              /*blend_type=*/BlendMode::kNormal,
+                              /*bRgbByteOrder=*/false));
+  RunRgbRowTest(compositor, /*dest_bpp=*/4, /*src_bpp=*/3, /*use_clip=*/false);
+}
+
+TEST(ScanlineCompositorTest, CompositeByteMaskLineBgraNormalLongRow) {
+  for (uint32_t mask_color : {0xff336699u, 0x80336699u}) {
+    CFX_ScanlineCompositor compositor;
+    ASSERT_TRUE(compositor.Init(/*dest_format=*/FXDIB_Format::kBgra,
+                                /*src_format=*/FXDIB_Format::k8bppMask,
+                                /*src_palette=*/{}, mask_color,
+                                /*blend_type=*/BlendMode::kNormal,
+                                /*bRgbByteOrder=*/false));
+    RunByteMaskRowTest(compositor, /*use_clip=*/false);
+    RunByteMaskRowTest(compositor, /*use_clip=*/true);
+  }
+}
@@ -13,13 +13,17 @@
 #include <utility>
 
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/fx_2d_size.h"
+#include "core/fxcrt/fx_parallel.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/pauseindicator_iface.h"
+#include "core/fxcrt/stl_util.h"
 #include "core/fxge/calculate_pitch.h"
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/dib/fx_dib_simd.h"
 #include "core/fxge/dib/scanlinecomposer_iface.h"
 
 static_assert(
@@ -28,6 +32,13 @@ static_assert(
 
 namespace {
 
+// How often ContinueStretchHorz() checks whether to pause, in rows.
+constexpr int kStrechPauseRows = 10;
+
+// The least number of destination pixels each thread should make, as starting
+// threads has a cost.
+constexpr int64_t kMinPixelsPerThread = 256 * 1024;
+
 size_t TotalBytesForWeightCount(size_t weight_count) {
   // Always room for one weight even for empty ranges due to declaration
   // of weights_[1] in the header. Don't shrink below this since
@@ -251,10 +262,13 @@ CStretchEngine::CStretchEngine(ScanlineComposerIface* pDestBitmap,
   if (src_top > src_bottom) {
     std::swap(src_top, src_bottom);
   }
-  src_clip_.left = static_cast<int>(floor(src_left));
-  src_clip_.right = static_cast<int>(ceil(src_right));
-  src_clip_.top = static_cast<int>(floor(src_top));
-  src_clip_.bottom = static_cast<int>(ceil(src_bottom));
+  // Include one more source pixel on each side, which the weights for the
+  // pixels at the edges of `clip_rect` may use. This keeps the clip from
+  // affecting the value of any pixel.
+  src_clip_.left = static_cast<int>(floor(src_left)) - 1;
+  src_clip_.right = static_cast<int>(ceil(src_right)) + 1;
+  src_clip_.top = static_cast<int>(floor(src_top)) - 1;
+  src_clip_.bottom = static_cast<int>(ceil(src_bottom)) + 1;
   FX_RECT src_rect(0, 0, src_width_, src_height_);
   src_clip_.Intersect(src_rect);
 
@@ -313,6 +327,21 @@ bool CStretchEngine::StartStretchHorz() {
   return true;
 }
 
+size_t CStretchEngine::GetThreadCountForRows(int rows) const {
+  const int64_t pixels = static_cast<int64_t>(rows) * dest_clip_.Width();
+  return std::min(thread_count_, static_cast<size_t>(std::max<int64_t>(
+                                     pixels / kMinPixelsPerThread, 1)));
+}
+
+size_t CStretchEngine::GetBandRows(size_t thread_count) const {
+  // Threads are started for every band, so each one gets enough rows to make
+  // up for that, but at least as many as are done between pause checks.
+  const int rows_per_thread =
+      std::max(kStrechPauseRows,
+               static_cast<int>(kMinPixelsPerThread / dest_clip_.Width()));
+  return rows_per_thread * thread_count;
+}
+
 bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
   if (!dest_width_) {
     return false;
@@ -321,8 +350,12 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
     return true;
   }
 
-  int Bpp = dest_bpp_ / 8;
-  static const int kStrechPauseRows = 10;
+  const size_t thread_count =
+      GetThreadCountForRows(src_clip_.bottom - cur_row_);
+  if (thread_count > 1) {
+    return ContinueStretchHorzOnThreads(pPause, thread_count);
+  }
+
   int rows_to_go = kStrechPauseRows;
   for (; cur_row_ < src_clip_.bottom; ++cur_row_) {
     if (rows_to_go == 0) {
@@ -333,115 +366,157 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       rows_to_go = kStrechPauseRows;
     }
 
-    const uint8_t* src_scan = source_->GetScanline(cur_row_).data();
-    pdfium::span<uint8_t> dest_span = inter_buf_.subspan(
-        (cur_row_ - src_clip_.top) * inter_pitch_, inter_pitch_);
-    size_t dest_span_index = 0;
-    // TODO(npm): reduce duplicated code here
-    UNSAFE_TODO({
-      switch (trans_method_) {
-        case TransformMethod::k1BppTo8Bpp:
-        case TransformMethod::k1BppToManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
-            uint32_t dest_a = 0;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-              if (src_scan[j / 8] & (1 << (7 - j % 8))) {
-                dest_a += pixel_weight * 255;
-              }
+    StretchHorzRow(source_->GetScanline(cur_row_),
+                   inter_buf_.subspan((cur_row_ - src_clip_.top) * inter_pitch_,
+                                      inter_pitch_));
+    rows_to_go--;
+  }
+  return false;
+}
+
+bool CStretchEngine::ContinueStretchHorzOnThreads(PauseIndicatorIface* pPause,
+                                                  size_t thread_count) {
+  // GetScanline() may return the same buffer for every line, as CPDF_DIB
+  // does, so the lines of a band are copied before other threads read them.
+  // Pausing is checked between bands.
+  const size_t band_rows = GetBandRows(thread_count);
+  const size_t src_pitch = source_->GetPitch();
+  DataVector<uint8_t> band(Fx2DSizeOrDie(band_rows, src_pitch));
+  bool first_band = true;
+  while (cur_row_ < src_clip_.bottom) {
+    if (!first_band && pPause && pPause->NeedToPauseNow()) {
+      return true;
+    }
+
+    first_band = false;
+    const size_t rows = std::min(
+        band_rows, static_cast<size_t>(src_clip_.bottom - cur_row_));
+    for (size_t i = 0; i < rows; ++i) {
+      pdfium::span<const uint8_t> src_scan =
+          source_->GetScanline(cur_row_ + static_cast<int>(i));
+      fxcrt::Copy(src_scan.first(std::min(src_scan.size(), src_pitch)),
+                  pdfium::span(band).subspan(i * src_pitch));
+    }
+    const size_t first_inter_row =
+        static_cast<size_t>(cur_row_ - src_clip_.top);
+    fxcrt::ParallelFor(rows, thread_count, [&](size_t i) {
+      StretchHorzRow(
+          pdfium::span(band).subspan(i * src_pitch, src_pitch),
+          inter_buf_.subspan((first_inter_row + i) * inter_pitch_,
+                             inter_pitch_));
+    });
+    cur_row_ += static_cast<int>(rows);
+  }
+  return false;
+}
+
+void CStretchEngine::StretchHorzRow(pdfium::span<const uint8_t> src_span,
+                                    pdfium::span<uint8_t> dest_span) const {
+  const int Bpp = dest_bpp_ / 8;
+  const uint8_t* src_scan = src_span.data();
+  size_t dest_span_index = 0;
+  // TODO(npm): reduce duplicated code here
+  UNSAFE_TODO({
+    switch (trans_method_) {
+      case TransformMethod::k1BppTo8Bpp:
+      case TransformMethod::k1BppToManyBpp: {
+        for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          const PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
+          uint32_t dest_a = 0;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+            if (src_scan[j / 8] & (1 << (7 - j % 8))) {
+              dest_a += pixel_weight * 255;
             }
-            dest_span[dest_span_index++] = PixelFromFixed(dest_a);
           }
-          break;
+          dest_span[dest_span_index++] = PixelFromFixed(dest_a);
         }
-        case TransformMethod::k8BppTo8Bpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
-            uint32_t dest_a = 0;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-              dest_a += pixel_weight * src_scan[j];
-            }
-            dest_span[dest_span_index++] = PixelFromFixed(dest_a);
+        break;
+      }
+      case TransformMethod::k8BppTo8Bpp: {
+        for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          const PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
+          uint32_t dest_a = 0;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+            dest_a += pixel_weight * src_scan[j];
           }
-          break;
+          dest_span[dest_span_index++] = PixelFromFixed(dest_a);
         }
-        case TransformMethod::k8BppToManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
-            uint32_t dest_r = 0;
-            uint32_t dest_g = 0;
-            uint32_t dest_b = 0;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-              FX_ARGB argb = src_palette_[src_scan[j]];
-              if (dest_format_ == FXDIB_Format::kBgr) {
-                dest_r += pixel_weight * static_cast<uint8_t>(argb >> 16);
-                dest_g += pixel_weight * static_cast<uint8_t>(argb >> 8);
-                dest_b += pixel_weight * static_cast<uint8_t>(argb);
-              } else {
-                dest_b += pixel_weight * static_cast<uint8_t>(argb >> 24);
-                dest_g += pixel_weight * static_cast<uint8_t>(argb >> 16);
-                dest_r += pixel_weight * static_cast<uint8_t>(argb >> 8);
-              }
+        break;
+      }
+      case TransformMethod::k8BppToManyBpp: {
+        for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          const PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
+          uint32_t dest_r = 0;
+          uint32_t dest_g = 0;
+          uint32_t dest_b = 0;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+            FX_ARGB argb = src_palette_[src_scan[j]];
+            if (dest_format_ == FXDIB_Format::kBgr) {
+              dest_r += pixel_weight * static_cast<uint8_t>(argb >> 16);
+              dest_g += pixel_weight * static_cast<uint8_t>(argb >> 8);
+              dest_b += pixel_weight * static_cast<uint8_t>(argb);
+            } else {
+              dest_b += pixel_weight * static_cast<uint8_t>(argb >> 24);
+              dest_g += pixel_weight * static_cast<uint8_t>(argb >> 16);
+              dest_r += pixel_weight * static_cast<uint8_t>(argb >> 8);
             }
-            dest_span[dest_span_index++] = PixelFromFixed(dest_b);
-            dest_span[dest_span_index++] = PixelFromFixed(dest_g);
-            dest_span[dest_span_index++] = PixelFromFixed(dest_r);
           }
-          break;
+          dest_span[dest_span_index++] = PixelFromFixed(dest_b);
+          dest_span[dest_span_index++] = PixelFromFixed(dest_g);
+          dest_span[dest_span_index++] = PixelFromFixed(dest_r);
         }
-        case TransformMethod::kManyBpptoManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
-            uint32_t dest_r = 0;
-            uint32_t dest_g = 0;
-            uint32_t dest_b = 0;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-              const uint8_t* src_pixel = src_scan + j * Bpp;
-              dest_b += pixel_weight * (*src_pixel++);
-              dest_g += pixel_weight * (*src_pixel++);
-              dest_r += pixel_weight * (*src_pixel);
-            }
-            dest_span[dest_span_index++] = PixelFromFixed(dest_b);
-            dest_span[dest_span_index++] = PixelFromFixed(dest_g);
-            dest_span[dest_span_index++] = PixelFromFixed(dest_r);
-            dest_span_index += Bpp - 3;
+        break;
+      }
+      case TransformMethod::kManyBpptoManyBpp: {
+        for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          const PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
+          uint32_t dest_r = 0;
+          uint32_t dest_g = 0;
+          uint32_t dest_b = 0;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+            const uint8_t* src_pixel = src_scan + j * Bpp;
+            dest_b += pixel_weight * (*src_pixel++);
+            dest_g += pixel_weight * (*src_pixel++);
+            dest_r += pixel_weight * (*src_pixel);
           }
-          break;
+          dest_span[dest_span_index++] = PixelFromFixed(dest_b);
+          dest_span[dest_span_index++] = PixelFromFixed(dest_g);
+          dest_span[dest_span_index++] = PixelFromFixed(dest_r);
+          dest_span_index += Bpp - 3;
         }
-        case TransformMethod::kManyBpptoManyBppWithAlpha: {
-          DCHECK(has_alpha_);
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
-            uint32_t dest_a = 0;
-            uint32_t dest_r = 0;
-            uint32_t dest_g = 0;
-            uint32_t dest_b = 0;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              const uint8_t* src_pixel = src_scan + j * Bpp;
-              uint32_t pixel_weight =
-                  pWeights->GetWeightForPosition(j) * src_pixel[3] / 255;
-              dest_b += pixel_weight * (*src_pixel++);
-              dest_g += pixel_weight * (*src_pixel++);
-              dest_r += pixel_weight * (*src_pixel);
-              dest_a += pixel_weight;
-            }
-            dest_span[dest_span_index++] = PixelFromFixed(dest_b);
-            dest_span[dest_span_index++] = PixelFromFixed(dest_g);
-            dest_span[dest_span_index++] = PixelFromFixed(dest_r);
-            dest_span[dest_span_index] = PixelFromFixed(255 * dest_a);
-            dest_span_index += Bpp - 3;
+        break;
+      }
+      case TransformMethod::kManyBpptoManyBppWithAlpha: {
+        DCHECK(has_alpha_);
+        for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          const PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
+          uint32_t dest_a = 0;
+          uint32_t dest_r = 0;
+          uint32_t dest_g = 0;
+          uint32_t dest_b = 0;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            const uint8_t* src_pixel = src_scan + j * Bpp;
+            uint32_t pixel_weight =
+                pWeights->GetWeightForPosition(j) * src_pixel[3] / 255;
+            dest_b += pixel_weight * (*src_pixel++);
+            dest_g += pixel_weight * (*src_pixel++);
+            dest_r += pixel_weight * (*src_pixel);
+            dest_a += pixel_weight;
           }
-          break;
+          dest_span[dest_span_index++] = PixelFromFixed(dest_b);
+          dest_span[dest_span_index++] = PixelFromFixed(dest_g);
+          dest_span[dest_span_index++] = PixelFromFixed(dest_r);
+          dest_span[dest_span_index] = PixelFromFixed(255 * dest_a);
+          dest_span_index += Bpp - 3;
         }
+        break;
       }
-    });
-    rows_to_go--;
-  }
-  return false;
+    }
+  });
 }
 
 void CStretchEngine::StretchVert() {
@@ -456,87 +531,145 @@ void CStretchEngine::StretchVert() {
     return;
   }
 
+  // The alpha case leaves the colors of transparent pixels as the previous
+  // row had them, so its rows depend on each other.
+  const size_t thread_count =
+      trans_method_ == TransformMethod::kManyBpptoManyBppWithAlpha
+          ? 1
+          : GetThreadCountForRows(dest_clip_.Height());
+  if (thread_count <= 1) {
+    for (int row = dest_clip_.top; row < dest_clip_.bottom; ++row) {
+      StretchVertRow(table, row, dest_scanline_);
+      dest_bitmap_->ComposeScanline(row - dest_clip_.top, dest_scanline_);
+    }
+    return;
+  }
+
+  // Threads fill a band of lines, which are then composed in order on the
+  // calling thread. Each line starts out as `dest_scanline_` does, as the
+  // bytes the rows do not set must keep its values.
+  const size_t band_rows = GetBandRows(thread_count);
+  const size_t line_size = dest_scanline_.size();
+  DataVector<uint8_t> band(Fx2DSizeOrDie(band_rows, line_size));
+  for (size_t i = 0; i < band_rows; ++i) {
+    fxcrt::Copy(dest_scanline_, pdfium::span(band).subspan(i * line_size));
+  }
+  for (int row = dest_clip_.top; row < dest_clip_.bottom;) {
+    const size_t rows =
+        std::min(band_rows, static_cast<size_t>(dest_clip_.bottom - row));
+    fxcrt::ParallelFor(rows, thread_count, [&](size_t i) {
+      StretchVertRow(table, row + static_cast<int>(i),
+                     pdfium::span(band).subspan(i * line_size, line_size));
+    });
+    for (size_t i = 0; i < rows; ++i) {
+      dest_bitmap_->ComposeScanline(
+          row - dest_clip_.top + static_cast<int>(i),
+          pdfium::span(band).subspan(i * line_size, line_size));
+    }
+    row += static_cast<int>(rows);
+  }
+}
+
+void CStretchEngine::StretchVertRow(const WeightTable& table,
+                                    int row,
+                                    pdfium::span<uint8_t> dest_line) const {
   const int DestBpp = dest_bpp_ / 8;
+  const PixelWeight* pWeights = table.GetPixelWeight(row);
+  pdfium::span<const uint8_t> inter_rows = inter_buf_.subspan(
+      static_cast<size_t>((pWeights->src_start_ - src_clip_.top) *
+                          inter_pitch_));
+  uint8_t* dest_scan = dest_line.data();
   UNSAFE_TODO({
-    for (int row = dest_clip_.top; row < dest_clip_.bottom; ++row) {
-      unsigned char* dest_scan = dest_scanline_.data();
-      PixelWeight* pWeights = table.GetPixelWeight(row);
-      switch (trans_method_) {
-        case TransformMethod::k1BppTo8Bpp:
-        case TransformMethod::k1BppToManyBpp:
-        case TransformMethod::k8BppTo8Bpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            pdfium::span<const uint8_t> src_span =
-                inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
-            uint32_t dest_a = 0;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-              dest_a +=
-                  pixel_weight * src_span[(j - src_clip_.top) * inter_pitch_];
-            }
-            *dest_scan = PixelFromFixed(dest_a);
-            dest_scan += DestBpp;
+    switch (trans_method_) {
+      case TransformMethod::k1BppTo8Bpp:
+      case TransformMethod::k1BppToManyBpp:
+      case TransformMethod::k8BppTo8Bpp: {
+        int col = dest_clip_.left;
+        if (DestBpp == 1) {
+          col += static_cast<int>(fxge::StretchRowVert(
+              inter_rows, inter_pitch_, pWeights->GetWeights(),
+              /*keep_4th_bytes=*/false,
+              dest_line.first(static_cast<size_t>(dest_clip_.Width()))));
+          dest_scan += col - dest_clip_.left;
+        }
+        for (; col < dest_clip_.right; ++col) {
+          pdfium::span<const uint8_t> src_span =
+              inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
+          uint32_t dest_a = 0;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+            dest_a +=
+                pixel_weight * src_span[(j - src_clip_.top) * inter_pitch_];
           }
-          break;
+          *dest_scan = PixelFromFixed(dest_a);
+          dest_scan += DestBpp;
         }
-        case TransformMethod::k8BppToManyBpp:
-        case TransformMethod::kManyBpptoManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            pdfium::span<const uint8_t> src_span =
-                inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
-            uint32_t dest_r = 0;
-            uint32_t dest_g = 0;
-            uint32_t dest_b = 0;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-              pdfium::span<const uint8_t> src_pixel = src_span.subspan(
-                  static_cast<size_t>((j - src_clip_.top) * inter_pitch_), 3u);
-              dest_b += pixel_weight * src_pixel[0];
-              dest_g += pixel_weight * src_pixel[1];
-              dest_r += pixel_weight * src_pixel[2];
-            }
-            dest_scan[0] = PixelFromFixed(dest_b);
-            dest_scan[1] = PixelFromFixed(dest_g);
-            dest_scan[2] = PixelFromFixed(dest_r);
-            dest_scan += DestBpp;
+        break;
+      }
+      case TransformMethod::k8BppToManyBpp:
+      case TransformMethod::kManyBpptoManyBpp: {
+        // Recomputing the channels of a pixel that the kernel only did some
+        // of gives the same values.
+        const size_t done = fxge::StretchRowVert(
+            inter_rows, inter_pitch_, pWeights->GetWeights(),
+            /*keep_4th_bytes=*/DestBpp == 4,
+            dest_line.first(static_cast<size_t>(dest_clip_.Width() * DestBpp)));
+        int col = dest_clip_.left + static_cast<int>(done / DestBpp);
+        dest_scan += (col - dest_clip_.left) * DestBpp;
+        for (; col < dest_clip_.right; ++col) {
+          pdfium::span<const uint8_t> src_span =
+              inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
+          uint32_t dest_r = 0;
+          uint32_t dest_g = 0;
+          uint32_t dest_b = 0;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+            pdfium::span<const uint8_t> src_pixel = src_span.subspan(
+                static_cast<size_t>((j - src_clip_.top) * inter_pitch_), 3u);
+            dest_b += pixel_weight * src_pixel[0];
+            dest_g += pixel_weight * src_pixel[1];
+            dest_r += pixel_weight * src_pixel[2];
           }
-          break;
+          dest_scan[0] = PixelFromFixed(dest_b);
+          dest_scan[1] = PixelFromFixed(dest_g);
+          dest_scan[2] = PixelFromFixed(dest_r);
+          dest_scan += DestBpp;
         }
-        case TransformMethod::kManyBpptoManyBppWithAlpha: {
-          DCHECK(has_alpha_);
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
-            pdfium::span<const uint8_t> src_span =
-                inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
-            uint32_t dest_a = 0;
-            uint32_t dest_r = 0;
-            uint32_t dest_g = 0;
-            uint32_t dest_b = 0;
-            static constexpr size_t kPixelBytes = 4;
-            for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
-              uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-              pdfium::span<const uint8_t> src_pixel = src_span.subspan(
-                  static_cast<size_t>((j - src_clip_.top) * inter_pitch_),
-                  kPixelBytes);
-              dest_b += pixel_weight * src_pixel[0];
-              dest_g += pixel_weight * src_pixel[1];
-              dest_r += pixel_weight * src_pixel[2];
-              dest_a += pixel_weight * src_pixel[3];
-            }
-            if (dest_a) {
-              int r = static_cast<uint32_t>(dest_r) * 255 / dest_a;
-              int g = static_cast<uint32_t>(dest_g) * 255 / dest_a;
-              int b = static_cast<uint32_t>(dest_b) * 255 / dest_a;
-              dest_scan[0] = std::clamp(b, 0, 255);
-              dest_scan[1] = std::clamp(g, 0, 255);
-              dest_scan[2] = std::clamp(r, 0, 255);
-            }
-            dest_scan[3] = PixelFromFixed(dest_a);
-            dest_scan += DestBpp;
+        break;
+      }
+      case TransformMethod::kManyBpptoManyBppWithAlpha: {
+        DCHECK(has_alpha_);
+        for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          pdfium::span<const uint8_t> src_span =
+              inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
+          uint32_t dest_a = 0;
+          uint32_t dest_r = 0;
+          uint32_t dest_g = 0;
+          uint32_t dest_b = 0;
+          static constexpr size_t kPixelBytes = 4;
+          for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
+            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+            pdfium::span<const uint8_t> src_pixel = src_span.subspan(
+                static_cast<size_t>((j - src_clip_.top) * inter_pitch_),
+                kPixelBytes);
+            dest_b += pixel_weight * src_pixel[0];
+            dest_g += pixel_weight * src_pixel[1];
+            dest_r += pixel_weight * src_pixel[2];
+            dest_a += pixel_weight * src_pixel[3];
+          }
+          if (dest_a) {
+            int r = static_cast<uint32_t>(dest_r) * 255 / dest_a;
+            int g = static_cast<uint32_t>(dest_g) * 255 / dest_a;
+            int b = static_cast<uint32_t>(dest_b) * 255 / dest_a;
+            dest_scan[0] = std::clamp(b, 0, 255);
+            dest_scan[1] = std::clamp(g, 0, 255);
+            dest_scan[2] = std::clamp(r, 0, 255);
           }
-          break;
+          dest_scan[3] = PixelFromFixed(dest_a);
+          dest_scan += DestBpp;
         }
+        break;
       }
-      dest_bitmap_->ComposeScanline(row - dest_clip_.top, dest_scanline_);
     }
   });
 }
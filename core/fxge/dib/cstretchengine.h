@@ -7,8 +7,11 @@
 #ifndef CORE_FXGE_DIB_CSTRETCHENGINE_H_
 #define CORE_FXGE_DIB_CSTRETCHENGINE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_size_data_vector.h"
@@ -16,6 +19,7 @@
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/dib/fx_dib.h"
 
@@ -58,6 +62,15 @@ class CStretchEngine {
       return UNSAFE_BUFFERS(weights_[position - src_start_]);
     }
 
+    // Returns the weights for positions `src_start_` to `src_end_`.
+    pdfium::span<const uint32_t> GetWeights() const {
+      const size_t count =
+          static_cast<size_t>(std::max(src_end_ - src_start_ + 1, 0));
+      // SAFETY: WeightTable allocates room for at least `count` weights, as
+      // enforced by the check in SetStartEnd().
+      return UNSAFE_BUFFERS(pdfium::span<const uint32_t>(&weights_[0], count));
+    }
+
     void SetWeightForPosition(int position, uint32_t weight) {
       CHECK_GE(position, src_start_);
       CHECK_LE(position, src_end_);
@@ -118,6 +131,10 @@ class CStretchEngine {
   bool ContinueStretchHorz(PauseIndicatorIface* pPause);
   void StretchVert();
 
+  // Lets both passes use up to `count` threads, including the calling one,
+  // when the image is big enough. The result does not depend on `count`.
+  void SetThreadCount(size_t count) { thread_count_ = count; }
+
   const FXDIB_ResampleOptions& GetResampleOptionsForTest() const {
     return resample_options_;
   }
@@ -134,6 +151,26 @@ class CStretchEngine {
     kManyBpptoManyBppWithAlpha
   };
 
+  // Returns how many threads a pass that makes `rows` rows of
+  // `dest_clip_.Width()` pixels should use.
+  size_t GetThreadCountForRows(int rows) const;
+
+  // Returns how many rows to give `thread_count` threads at a time.
+  size_t GetBandRows(size_t thread_count) const;
+
+  bool ContinueStretchHorzOnThreads(PauseIndicatorIface* pPause,
+                                    size_t thread_count);
+
+  // Stretches `src_span`, a line of `source_`, into `dest_span`, a line of
+  // `inter_buf_`.
+  void StretchHorzRow(pdfium::span<const uint8_t> src_span,
+                      pdfium::span<uint8_t> dest_span) const;
+
+  // Stretches `row` of the result from `inter_buf_` into `dest_line`.
+  void StretchVertRow(const WeightTable& table,
+                      int row,
+                      pdfium::span<uint8_t> dest_line) const;
+
   const FXDIB_Format dest_format_;
   const int dest_bpp_;
   const int src_bpp_;
@@ -155,6 +192,7 @@ class CStretchEngine {
   TransformMethod trans_method_;
   State state_ = State::kInitial;
   int cur_row_ = 0;
+  size_t thread_count_ = 1;
   WeightTable weight_table_;
 };
 
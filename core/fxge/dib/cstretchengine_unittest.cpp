@@ -5,12 +5,18 @@
 #include "core/fxge/dib/cstretchengine.h"
 
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_dib.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/pauseindicator_iface.h"
+#include "core/fxcrt/stl_util.h"
+#include "core/fxge/dib/cfx_bitmapstorer.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/dib/fx_dib_simd.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace {
@@ -66,8 +72,159 @@ void ExecuteStretchTests(const FXDIB_ResampleOptions& options) {
   }
 }
 
+std::vector<uint8_t> MakeTestBytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  uint32_t seed = 1;
+  for (auto& byte : bytes) {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<uint8_t>(seed >> 16);
+  }
+  return bytes;
+}
+
+struct ScaleCase {
+  int dest_len;
+  int src_len;
+  bool no_smoothing;
+};
+
+// Downscaling by 2 and 4 gives box weights, the others general ones.
+constexpr ScaleCase kScaleCases[] = {
+    {50, 100, false}, {25, 100, false}, {33, 100, false},
+    {150, 100, false}, {150, 100, true}, {-50, 100, false},
+};
+
+class AlwaysPause final : public PauseIndicatorIface {
+ public:
+  bool NeedToPauseNow() override {
+    ++pause_count_;
+    return true;
+  }
+
+  int pause_count() const { return pause_count_; }
+
+ private:
+  int pause_count_ = 0;
+};
+
+RetainPtr<CFX_DIBitmap> MakeTestBitmap(int width,
+                                       int height,
+                                       FXDIB_Format format) {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  CHECK(bitmap->Create(width, height, format));
+  fxcrt::Copy(MakeTestBytes(bitmap->GetBuffer().size()),
+              bitmap->GetWritableBuffer());
+  return bitmap;
+}
+
+RetainPtr<CFX_DIBitmap> Stretch(RetainPtr<const CFX_DIBitmap> source,
+                                int dest_width,
+                                int dest_height,
+                                size_t thread_count,
+                                PauseIndicatorIface* pause) {
+  const FX_RECT clip_rect(0, 0, abs(dest_width), abs(dest_height));
+  const FXDIB_Format format = source->GetFormat();
+  CFX_BitmapStorer storer;
+  CHECK(storer.SetInfo(clip_rect.Width(), clip_rect.Height(), format, {}));
+  CStretchEngine engine(&storer, format, dest_width, dest_height, clip_rect,
+                        std::move(source), FXDIB_ResampleOptions());
+  engine.SetThreadCount(thread_count);
+  CHECK(engine.StartStretchHorz());
+  while (engine.Continue(pause)) {
+  }
+  return storer.Detach();
+}
+
+FXDIB_ResampleOptions GetOptions(const ScaleCase& scale_case) {
+  FXDIB_ResampleOptions options;
+  options.bNoSmoothing = scale_case.no_smoothing;
+  options.bInterpolateBilinear =
+      !scale_case.no_smoothing && abs(scale_case.dest_len) > scale_case.src_len;
+  return options;
+}
+
 }  // namespace
 
+TEST(CStretchEngine, StretchRowVert) {
+  static constexpr size_t kPitch = 40;
+  static constexpr size_t kRowSize = 37;
+  for (const ScaleCase& scale_case : kScaleCases) {
+    const int dest_height = abs(scale_case.dest_len);
+    CStretchEngine::WeightTable table;
+    ASSERT_TRUE(table.CalculateWeights(scale_case.dest_len, 0, dest_height,
+                                       scale_case.src_len, 0,
+                                       scale_case.src_len,
+                                       GetOptions(scale_case)));
+    const std::vector<uint8_t> src = MakeTestBytes(scale_case.src_len * kPitch);
+    for (bool keep_4th_bytes : {false, true}) {
+      for (int row = 0; row < dest_height; ++row) {
+        const CStretchEngine::PixelWeight* weights = table.GetPixelWeight(row);
+        std::vector<uint8_t> dest(kRowSize, 42);
+        size_t done = fxge::StretchRowVert(
+            pdfium::span(src).subspan(weights->src_start_ * kPitch), kPitch,
+            weights->GetWeights(), keep_4th_bytes, dest);
+        for (size_t i = 0; i < done; ++i) {
+          uint8_t expected = 42;
+          if (!keep_4th_bytes || i % 4 != 3) {
+            uint32_t sum = 0;
+            for (int j = weights->src_start_; j <= weights->src_end_; ++j) {
+              sum += weights->GetWeightForPosition(j) * src[j * kPitch + i];
+            }
+            expected = CStretchEngine::PixelFromFixed(sum);
+          }
+          EXPECT_EQ(expected, dest[i])
+              << scale_case.dest_len << " " << row << " " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(CStretchEngine, Threads) {
+  struct ThreadCase {
+    int src_width;
+    int src_height;
+    int dest_width;
+    int dest_height;
+  };
+  // Big enough for 4 threads in both passes.
+  static constexpr ThreadCase kThreadCases[] = {
+      {1000, 800, 1300, 900},
+      {2000, 1800, -1100, 1000},
+  };
+  static constexpr FXDIB_Format kFormats[] = {
+      FXDIB_Format::k8bppRgb,
+      FXDIB_Format::kBgr,
+      FXDIB_Format::kBgrx,
+      FXDIB_Format::kBgra,
+  };
+  for (const ThreadCase& thread_case : kThreadCases) {
+    for (FXDIB_Format format : kFormats) {
+      RetainPtr<CFX_DIBitmap> source = MakeTestBitmap(
+          thread_case.src_width, thread_case.src_height, format);
+      RetainPtr<CFX_DIBitmap> expected =
+          Stretch(source, thread_case.dest_width, thread_case.dest_height,
+                  /*thread_count=*/1, /*pause=*/nullptr);
+      ASSERT_TRUE(expected);
+
+      RetainPtr<CFX_DIBitmap> result =
+          Stretch(source, thread_case.dest_width, thread_case.dest_height,
+                  /*thread_count=*/4, /*pause=*/nullptr);
+      ASSERT_TRUE(result);
+      EXPECT_TRUE(expected->GetBuffer() == result->GetBuffer())
+          << thread_case.dest_width << " " << static_cast<int>(format);
+
+      AlwaysPause pause;
+      result = Stretch(source, thread_case.dest_width, thread_case.dest_height,
+                       /*thread_count=*/4, &pause);
+      ASSERT_TRUE(result);
+      EXPECT_TRUE(expected->GetBuffer() == result->GetBuffer())
+          << thread_case.dest_width << " " << static_cast<int>(format);
+      EXPECT_GT(pause.pause_count(), 1);
+    }
+  }
+}
+
 TEST(CStretchEngine, OverflowInCtor) {
   FX_RECT clip_rect;
   RetainPtr<CPDF_Dictionary> dict_obj = pdfium::MakeRetain<CPDF_Dictionary>();
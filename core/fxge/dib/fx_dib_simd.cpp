@@ -0,0 +1,593 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/fx_dib_simd.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define FX_DIB_USE_SIMD
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#define FX_DIB_USE_SIMD
+#endif
+
+namespace {
+
+bool g_kernels_enabled = true;
+
+#if defined(FX_DIB_USE_SIMD)
+
+// The kernels work on 4 pixels at a time, with each channel of a pixel in a
+// 32-bit lane, so that the integer math of the scalar code carries over as is.
+constexpr size_t kPixels = 4;
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+using Lanes = __m128i;
+
+// 16 bytes, 4 in each of the Lanes.
+struct Lanes16 {
+  Lanes bytes0;
+  Lanes bytes4;
+  Lanes bytes8;
+  Lanes bytes12;
+};
+
+// The caller ensures that `data` has at least 16 bytes.
+Lanes LoadPixels(const void* data) {
+  return _mm_loadu_si128(static_cast<const __m128i*>(data));
+}
+
+void StorePixels(void* data, Lanes pixels) {
+  _mm_storeu_si128(static_cast<__m128i*>(data), pixels);
+}
+
+// Returns 4 bytes from `data`, one in each lane.
+Lanes LoadBytes(const uint8_t* data) {
+  uint32_t bytes;
+  memcpy(&bytes, data, sizeof(bytes));
+  const __m128i zero = _mm_setzero_si128();
+  return _mm_unpacklo_epi16(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(bytes)), zero),
+      zero);
+}
+
+// Returns 16 bytes from `data`, one in each lane.
+Lanes16 Load16Bytes(const uint8_t* data) {
+  const __m128i bytes =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+  const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+  return {_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+          _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)};
+}
+
+// Inverse of Load16Bytes(). Lanes must be at most 255.
+void Store16Bytes(uint8_t* data, const Lanes16& lanes) {
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(data),
+      _mm_packus_epi16(_mm_packs_epi32(lanes.bytes0, lanes.bytes4),
+                       _mm_packs_epi32(lanes.bytes8, lanes.bytes12)));
+}
+
+Lanes Splat(uint32_t value) {
+  return _mm_set1_epi32(static_cast<int>(value));
+}
+
+Lanes SetLanes(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+  return _mm_setr_epi32(static_cast<int>(a), static_cast<int>(b),
+                        static_cast<int>(c), static_cast<int>(d));
+}
+
+Lanes And(Lanes a, Lanes b) {
+  return _mm_and_si128(a, b);
+}
+
+Lanes Or(Lanes a, Lanes b) {
+  return _mm_or_si128(a, b);
+}
+
+Lanes Add(Lanes a, Lanes b) {
+  return _mm_add_epi32(a, b);
+}
+
+Lanes Sub(Lanes a, Lanes b) {
+  return _mm_sub_epi32(a, b);
+}
+
+template <int N>
+Lanes ShiftLeft(Lanes a) {
+  return _mm_slli_epi32(a, N);
+}
+
+template <int N>
+Lanes ShiftRight(Lanes a) {
+  return _mm_srli_epi32(a, N);
+}
+
+// The product of each pair of lanes must fit in 16 bits. The upper halves of
+// the lanes are then all zero, and so are their products.
+Lanes MulSmall(Lanes a, Lanes b) {
+  return _mm_mullo_epi16(a, b);
+}
+
+// Same as `a * b` for lanes up to 65535. The upper halves of the lanes are
+// zero, so the 16-bit multiplies give the low and high halves of each product.
+Lanes MulWide(Lanes a, Lanes b) {
+  return _mm_or_si128(_mm_mullo_epi16(a, b),
+                      _mm_slli_epi32(_mm_mulhi_epu16(a, b), 16));
+}
+
+// Same as `a / b` where the quotient is at most 255, which float division
+// gets exactly. `b` lanes must not be zero.
+Lanes Divide(Lanes a, Lanes b) {
+  return _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(a), _mm_cvtepi32_ps(b)));
+}
+
+Lanes Equal(Lanes a, Lanes b) {
+  return _mm_cmpeq_epi32(a, b);
+}
+
+Lanes LessThan(Lanes a, Lanes b) {
+  return _mm_cmplt_epi32(a, b);
+}
+
+// Picks lanes from `a` where `mask` is set, and from `b` elsewhere.
+Lanes Select(Lanes mask, Lanes a, Lanes b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+Lanes ToFloat(Lanes a) {
+  return _mm_castps_si128(_mm_cvtepi32_ps(a));
+}
+
+Lanes MulFloat(Lanes a, Lanes b) {
+  return _mm_castps_si128(
+      _mm_mul_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+Lanes TruncateFloat(Lanes a) {
+  return _mm_cvttps_epi32(_mm_castsi128_ps(a));
+}
+
+Lanes SplatFloat(float value) {
+  return _mm_castps_si128(_mm_set1_ps(value));
+}
+
+#elif defined(ARCH_CPU_ARM64)
+
+using Lanes = uint32x4_t;
+
+// 16 bytes, 4 in each of the Lanes.
+struct Lanes16 {
+  Lanes bytes0;
+  Lanes bytes4;
+  Lanes bytes8;
+  Lanes bytes12;
+};
+
+// The caller ensures that `data` has at least 16 bytes.
+Lanes LoadPixels(const void* data) {
+  return vld1q_u32(static_cast<const uint32_t*>(data));
+}
+
+void StorePixels(void* data, Lanes pixels) {
+  vst1q_u32(static_cast<uint32_t*>(data), pixels);
+}
+
+// Returns 4 bytes from `data`, one in each lane.
+Lanes LoadBytes(const uint8_t* data) {
+  uint32_t bytes;
+  memcpy(&bytes, data, sizeof(bytes));
+  return vmovl_u16(
+      vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(bytes)))));
+}
+
+// Returns 16 bytes from `data`, one in each lane.
+Lanes16 Load16Bytes(const uint8_t* data) {
+  const uint8x16_t bytes = vld1q_u8(data);
+  const uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+  const uint16x8_t high = vmovl_high_u8(bytes);
+  return {vmovl_u16(vget_low_u16(low)), vmovl_high_u16(low),
+          vmovl_u16(vget_low_u16(high)), vmovl_high_u16(high)};
+}
+
+// Inverse of Load16Bytes(). Lanes must be at most 255.
+void Store16Bytes(uint8_t* data, const Lanes16& lanes) {
+  const uint16x8_t low =
+      vcombine_u16(vmovn_u32(lanes.bytes0), vmovn_u32(lanes.bytes4));
+  const uint16x8_t high =
+      vcombine_u16(vmovn_u32(lanes.bytes8), vmovn_u32(lanes.bytes12));
+  vst1q_u8(data, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+}
+
+Lanes Splat(uint32_t value) {
+  return vdupq_n_u32(value);
+}
+
+Lanes SetLanes(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+  const uint32_t values[] = {a, b, c, d};
+  return vld1q_u32(values);
+}
+
+Lanes And(Lanes a, Lanes b) {
+  return vandq_u32(a, b);
+}
+
+Lanes Or(Lanes a, Lanes b) {
+  return vorrq_u32(a, b);
+}
+
+Lanes Add(Lanes a, Lanes b) {
+  return vaddq_u32(a, b);
+}
+
+Lanes Sub(Lanes a, Lanes b) {
+  return vsubq_u32(a, b);
+}
+
+template <int N>
+Lanes ShiftLeft(Lanes a) {
+  return vshlq_n_u32(a, N);
+}
+
+template <int N>
+Lanes ShiftRight(Lanes a) {
+  return vshrq_n_u32(a, N);
+}
+
+Lanes MulSmall(Lanes a, Lanes b) {
+  return vmulq_u32(a, b);
+}
+
+// Same as `a * b` for lanes up to 65535.
+Lanes MulWide(Lanes a, Lanes b) {
+  return vmulq_u32(a, b);
+}
+
+// Same as `a / b` where the quotient is at most 255, which float division
+// gets exactly. `b` lanes must not be zero.
+Lanes Divide(Lanes a, Lanes b) {
+  return vcvtq_u32_f32(vdivq_f32(vcvtq_f32_u32(a), vcvtq_f32_u32(b)));
+}
+
+Lanes Equal(Lanes a, Lanes b) {
+  return vceqq_u32(a, b);
+}
+
+Lanes LessThan(Lanes a, Lanes b) {
+  return vcltq_s32(vreinterpretq_s32_u32(a), vreinterpretq_s32_u32(b));
+}
+
+// Picks lanes from `a` where `mask` is set, and from `b` elsewhere.
+Lanes Select(Lanes mask, Lanes a, Lanes b) {
+  return vbslq_u32(mask, a, b);
+}
+
+Lanes ToFloat(Lanes a) {
+  return vreinterpretq_u32_f32(vcvtq_f32_u32(a));
+}
+
+Lanes MulFloat(Lanes a, Lanes b) {
+  return vreinterpretq_u32_f32(
+      vmulq_f32(vreinterpretq_f32_u32(a), vreinterpretq_f32_u32(b)));
+}
+
+Lanes TruncateFloat(Lanes a) {
+  return vcvtq_u32_f32(vreinterpretq_f32_u32(a));
+}
+
+Lanes SplatFloat(float value) {
+  return vreinterpretq_u32_f32(vdupq_n_f32(value));
+}
+
+#endif
+
+// Same as `a * weight` in uint32_t math for lanes up to 65535, which is how
+// CStretchEngine applies its fixed point weights.
+Lanes MulWeight(Lanes a, uint32_t weight) {
+  Lanes product = MulWide(a, Splat(weight & 0xffff));
+  if (weight >> 16) {
+    product = Add(product, ShiftLeft<16>(MulWide(a, Splat(weight >> 16))));
+  }
+  return product;
+}
+
+// Returns the weight shared by all of `weights`, or 0 if they differ. Such
+// weights come from downscaling by a power of 2, and can be applied to the sum
+// of the sources instead of to each of them. Also returns 0 for a single
+// weight, which gains nothing, and for more than 257, whose sources may not
+// add up to less than 65536.
+uint32_t GetBoxWeight(pdfium::span<const uint32_t> weights) {
+  if (weights.size() < 2 || weights.size() > 257) {
+    return 0;
+  }
+  for (uint32_t weight : weights) {
+    if (weight != weights.front()) {
+      return 0;
+    }
+  }
+  return weights.front();
+}
+
+// Same as `a / 255` for lanes up to 65534.
+Lanes Div255(Lanes a) {
+  return ShiftRight<8>(Add(Add(a, Splat(1)), ShiftRight<8>(a)));
+}
+
+// Same as `a / 65025` for lanes up to 255 * 255 * 255, which is
+// `a / 255 / 255`. The float estimate is off by at most one.
+Lanes Div65025(Lanes a) {
+  Lanes quotient =
+      TruncateFloat(MulFloat(ToFloat(a), SplatFloat(1.0f / 65025)));
+  // 65025 is 65536 - 512 + 1.
+  const Lanes remainder =
+      Sub(a, Add(Sub(ShiftLeft<16>(quotient), ShiftLeft<9>(quotient)),
+                 quotient));
+  const Lanes one = Splat(1);
+  quotient = Sub(quotient, And(LessThan(remainder, Splat(0)), one));
+  quotient = Add(quotient, And(LessThan(Splat(65024), remainder), one));
+  return quotient;
+}
+
+// Returns the byte at bit `N` of each lane.
+template <int N>
+Lanes Channel(Lanes pixels) {
+  return And(ShiftRight<N>(pixels), Splat(0xff));
+}
+
+// Same as FXDIB_ALPHA_MERGE() for each lane.
+Lanes AlphaMerge(Lanes backdrop, Lanes source, Lanes source_alpha) {
+  return Div255(Add(MulSmall(backdrop, Sub(Splat(255), source_alpha)),
+                    MulSmall(source, source_alpha)));
+}
+
+// Merges the BGR `source` channels into `dest` pixels that get `src_alpha`
+// composited over them, like the scalar code does for the normal blend mode:
+//
+//   if dest alpha is 0:
+//     dest = source, with alpha `src_alpha`
+//   else:
+//     dest_alpha = AlphaUnion(dest alpha, src_alpha)
+//     alpha_ratio = src_alpha * 255 / dest_alpha
+//     dest = FXDIB_ALPHA_MERGE(dest, source, alpha_ratio), with alpha
+//            dest_alpha
+//
+// When `src_alpha` is 0 and the dest alpha is not, this leaves `dest` alone.
+Lanes CompositeNormal(Lanes source_b,
+                      Lanes source_g,
+                      Lanes source_r,
+                      Lanes src_alpha,
+                      Lanes dest) {
+  const Lanes zero = Splat(0);
+  const Lanes back_alpha = ShiftRight<24>(dest);
+  const Lanes dest_alpha =
+      Sub(Add(back_alpha, src_alpha), Div255(MulSmall(back_alpha, src_alpha)));
+  // `dest_alpha` is only 0 where `back_alpha` is, and those lanes get
+  // `source` instead. Avoid dividing by 0 for them.
+  const Lanes divisor = Or(dest_alpha, And(Equal(dest_alpha, zero), Splat(1)));
+  const Lanes alpha_ratio = Divide(MulSmall(src_alpha, Splat(255)), divisor);
+  const Lanes merged =
+      Or(Or(AlphaMerge(Channel<0>(dest), source_b, alpha_ratio),
+            ShiftLeft<8>(AlphaMerge(Channel<8>(dest), source_g, alpha_ratio))),
+         Or(ShiftLeft<16>(AlphaMerge(Channel<16>(dest), source_r, alpha_ratio)),
+            ShiftLeft<24>(dest_alpha)));
+  const Lanes copied =
+      Or(Or(source_b, ShiftLeft<8>(source_g)),
+         Or(ShiftLeft<16>(source_r), ShiftLeft<24>(src_alpha)));
+  return Select(Equal(back_alpha, zero), copied, merged);
+}
+
+#endif  // defined(FX_DIB_USE_SIMD)
+
+}  // namespace
+
+namespace fxge {
+
+#if defined(FX_DIB_USE_SIMD)
+
+size_t CompositeRowBgra2BgraNormal(
+    pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src,
+    pdfium::span<const uint8_t> clip,
+    pdfium::span<FX_BGRA_STRUCT<uint8_t>> dest) {
+  if (!g_kernels_enabled) {
+    return 0;
+  }
+  size_t pixel_count = std::min(src.size(), dest.size());
+  if (!clip.empty()) {
+    pixel_count = std::min(pixel_count, clip.size());
+  }
+  size_t i = 0;
+  for (; pixel_count - i >= kPixels; i += kPixels) {
+    const Lanes source = LoadPixels(&src[i]);
+    Lanes src_alpha = ShiftRight<24>(source);
+    if (!clip.empty()) {
+      src_alpha = Div255(MulSmall(src_alpha, LoadBytes(&clip[i])));
+    }
+    StorePixels(&dest[i],
+                CompositeNormal(Channel<0>(source), Channel<8>(source),
+                                Channel<16>(source), src_alpha,
+                                LoadPixels(&dest[i])));
+  }
+  return i;
+}
+
+size_t CompositeRowBgr2Bgrx(pdfium::span<const uint8_t> src,
+                            pdfium::span<uint8_t> dest,
+                            size_t pixel_count,
+                            bool set_alpha) {
+  if (!g_kernels_enabled) {
+    return 0;
+  }
+  pixel_count = std::min({pixel_count, src.size() / 3, dest.size() / 4});
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128i color_mask = _mm_set1_epi32(0x00ffffff);
+  const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xff000000));
+  const __m128i lane0 = _mm_setr_epi32(-1, 0, 0, 0);
+  const __m128i lane1 = _mm_setr_epi32(0, -1, 0, 0);
+  const __m128i lane2 = _mm_setr_epi32(0, 0, -1, 0);
+  const __m128i lane3 = _mm_setr_epi32(0, 0, 0, -1);
+  // Each load takes 16 bytes for 4 pixels of 3 bytes.
+  for (; pixel_count - i >= kPixels && src.size() - i * 3 >= 16;
+       i += kPixels) {
+    const __m128i bgr = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(src.subspan(i * 3).data()));
+    // Move the 3 bytes of pixel n up by n bytes, into 32-bit lane n.
+    const __m128i spread = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(bgr, lane0),
+                     _mm_and_si128(_mm_slli_si128(bgr, 1), lane1)),
+        _mm_or_si128(_mm_and_si128(_mm_slli_si128(bgr, 2), lane2),
+                     _mm_and_si128(_mm_slli_si128(bgr, 3), lane3)));
+    __m128i* out = reinterpret_cast<__m128i*>(dest.subspan(i * 4).data());
+    const __m128i alpha =
+        set_alpha ? alpha_mask
+                  : _mm_and_si128(_mm_loadu_si128(out), alpha_mask);
+    _mm_storeu_si128(out,
+                     _mm_or_si128(_mm_and_si128(spread, color_mask), alpha));
+  }
+#elif defined(ARCH_CPU_ARM64)
+  constexpr size_t kNeonPixels = 8;
+  for (; pixel_count - i >= kNeonPixels; i += kNeonPixels) {
+    const uint8x8x3_t bgr = vld3_u8(src.subspan(i * 3).data());
+    uint8_t* out = dest.subspan(i * 4).data();
+    const uint8x8_t alpha =
+        set_alpha ? vdup_n_u8(0xff) : vld4_u8(out).val[3];
+    vst4_u8(out, uint8x8x4_t{{bgr.val[0], bgr.val[1], bgr.val[2], alpha}});
+  }
+#endif
+  return i;
+}
+
+size_t CompositeRowByteMask2BgraNormal(
+    pdfium::span<const uint8_t> mask,
+    pdfium::span<const uint8_t> clip,
+    uint8_t mask_alpha,
+    const FX_BGR_STRUCT<uint8_t>& color,
+    pdfium::span<FX_BGRA_STRUCT<uint8_t>> dest) {
+  if (!g_kernels_enabled) {
+    return 0;
+  }
+  size_t pixel_count = std::min(mask.size(), dest.size());
+  if (!clip.empty()) {
+    pixel_count = std::min(pixel_count, clip.size());
+  }
+  const Lanes source_b = Splat(color.blue);
+  const Lanes source_g = Splat(color.green);
+  const Lanes source_r = Splat(color.red);
+  const Lanes alpha = Splat(mask_alpha);
+  size_t i = 0;
+  for (; pixel_count - i >= kPixels; i += kPixels) {
+    Lanes src_alpha = MulSmall(LoadBytes(&mask[i]), alpha);
+    if (clip.empty()) {
+      src_alpha = Div255(src_alpha);
+    } else {
+      // The product can take 24 bits, so multiply as floats, which is exact.
+      src_alpha = Div65025(TruncateFloat(
+          MulFloat(ToFloat(src_alpha), ToFloat(LoadBytes(&clip[i])))));
+    }
+    StorePixels(&dest[i], CompositeNormal(source_b, source_g, source_r,
+                                          src_alpha, LoadPixels(&dest[i])));
+  }
+  return i;
+}
+
+size_t StretchRowVert(pdfium::span<const uint8_t> src,
+                      size_t src_pitch,
+                      pdfium::span<const uint32_t> weights,
+                      bool keep_4th_bytes,
+                      pdfium::span<uint8_t> dest) {
+  if (!g_kernels_enabled || weights.empty()) {
+    return 0;
+  }
+  const size_t last_row = (weights.size() - 1) * src_pitch;
+  if (src.size() < last_row) {
+    return 0;
+  }
+  const size_t size = std::min(dest.size(), src.size() - last_row);
+  const uint32_t box_weight = GetBoxWeight(weights);
+  const Lanes keep = keep_4th_bytes ? SetLanes(0, 0, 0, 0xffffffff) : Splat(0);
+  constexpr size_t kBytes = 16;
+  size_t i = 0;
+  for (; size - i >= kBytes; i += kBytes) {
+    Lanes16 sums = {Splat(0), Splat(0), Splat(0), Splat(0)};
+    for (size_t row = 0; row < weights.size(); ++row) {
+      const Lanes16 bytes =
+          Load16Bytes(src.subspan(row * src_pitch + i).data());
+      if (box_weight) {
+        sums.bytes0 = Add(sums.bytes0, bytes.bytes0);
+        sums.bytes4 = Add(sums.bytes4, bytes.bytes4);
+        sums.bytes8 = Add(sums.bytes8, bytes.bytes8);
+        sums.bytes12 = Add(sums.bytes12, bytes.bytes12);
+      } else {
+        const uint32_t weight = weights[row];
+        sums.bytes0 = Add(sums.bytes0, MulWeight(bytes.bytes0, weight));
+        sums.bytes4 = Add(sums.bytes4, MulWeight(bytes.bytes4, weight));
+        sums.bytes8 = Add(sums.bytes8, MulWeight(bytes.bytes8, weight));
+        sums.bytes12 = Add(sums.bytes12, MulWeight(bytes.bytes12, weight));
+      }
+    }
+    if (box_weight) {
+      sums.bytes0 = MulWeight(sums.bytes0, box_weight);
+      sums.bytes4 = MulWeight(sums.bytes4, box_weight);
+      sums.bytes8 = MulWeight(sums.bytes8, box_weight);
+      sums.bytes12 = MulWeight(sums.bytes12, box_weight);
+    }
+    const Lanes16 old = Load16Bytes(&dest[i]);
+    Store16Bytes(&dest[i],
+                 {Select(keep, old.bytes0, Channel<16>(sums.bytes0)),
+                  Select(keep, old.bytes4, Channel<16>(sums.bytes4)),
+                  Select(keep, old.bytes8, Channel<16>(sums.bytes8)),
+                  Select(keep, old.bytes12, Channel<16>(sums.bytes12))});
+  }
+  return i;
+}
+
+#else  // defined(FX_DIB_USE_SIMD)
+
+size_t CompositeRowBgra2BgraNormal(
+    pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src,
+    pdfium::span<const uint8_t> clip,
+    pdfium::span<FX_BGRA_STRUCT<uint8_t>> dest) {
+  return 0;
+}
+
+size_t CompositeRowBgr2Bgrx(pdfium::span<const uint8_t> src,
+                            pdfium::span<uint8_t> dest,
+                            size_t pixel_count,
+                            bool set_alpha) {
+  return 0;
+}
+
+size_t CompositeRowByteMask2BgraNormal(
+    pdfium::span<const uint8_t> mask,
+    pdfium::span<const uint8_t> clip,
+    uint8_t mask_alpha,
+    const FX_BGR_STRUCT<uint8_t>& color,
+    pdfium::span<FX_BGRA_STRUCT<uint8_t>> dest) {
+  return 0;
+}
+
+size_t StretchRowVert(pdfium::span<const uint8_t> src,
+                      size_t src_pitch,
+                      pdfium::span<const uint32_t> weights,
+                      bool keep_4th_bytes,
+                      pdfium::span<uint8_t> dest) {
+  return 0;
+}
+
+#endif  // defined(FX_DIB_USE_SIMD)
+
+void SetSimdKernelsEnabledForTesting(bool enabled) {
+  g_kernels_enabled = enabled;
+}
+
+}  // namespace fxge
@@ -0,0 +1,64 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_DIB_FX_DIB_SIMD_H_
+#define CORE_FXGE_DIB_FX_DIB_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/fxcrt/span.h"
+#include "core/fxge/dib/fx_dib.h"
+
+// Kernels for the most common CFX_ScanlineCompositor and CStretchEngine rows.
+// Where SSE2 or NEON is available, they process 4 or more pixels at a time.
+// Each one handles a prefix of the row and returns its length in pixels, or in
+// bytes where noted, which is 0 on other targets, and leaves the rest of the
+// row to the scalar code. The results are exactly the same as those of the
+// scalar code.
+
+namespace fxge {
+
+// Composites `src` over `dest` with the normal blend mode. If `clip` is not
+// empty, it scales the alpha of `src`.
+size_t CompositeRowBgra2BgraNormal(
+    pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src,
+    pdfium::span<const uint8_t> clip,
+    pdfium::span<FX_BGRA_STRUCT<uint8_t>> dest);
+
+// Copies `pixel_count` 3 byte pixels from `src` to 4 byte pixels in `dest`.
+// Sets the 4th byte to 255 if `set_alpha`, or leaves it alone otherwise.
+size_t CompositeRowBgr2Bgrx(pdfium::span<const uint8_t> src,
+                            pdfium::span<uint8_t> dest,
+                            size_t pixel_count,
+                            bool set_alpha);
+
+// Composites `color` over `dest` with the normal blend mode, using `mask`
+// times `mask_alpha` as the alpha. If `clip` is not empty, it scales the
+// alpha too.
+size_t CompositeRowByteMask2BgraNormal(
+    pdfium::span<const uint8_t> mask,
+    pdfium::span<const uint8_t> clip,
+    uint8_t mask_alpha,
+    const FX_BGR_STRUCT<uint8_t>& color,
+    pdfium::span<FX_BGRA_STRUCT<uint8_t>> dest);
+
+// Vertical pass of CStretchEngine for channels that do not depend on each
+// other. Sets each byte of `dest` to the sum of the bytes at the same offset
+// in `weights.size()` rows of `src`, `src_pitch` bytes apart, times the
+// weights. Leaves every 4th byte of `dest` alone if `keep_4th_bytes`. Returns
+// a length in bytes.
+size_t StretchRowVert(pdfium::span<const uint8_t> src,
+                      size_t src_pitch,
+                      pdfium::span<const uint32_t> weights,
+                      bool keep_4th_bytes,
+                      pdfium::span<uint8_t> dest);
+
+// Makes the kernels above return 0 while `enabled` is false, so that callers
+// use only their scalar code. Lets benchmarks compare the two.
+void SetSimdKernelsEnabledForTesting(bool enabled);
+
+}  // namespace fxge
+
+#endif  // CORE_FXGE_DIB_FX_DIB_SIMD_H_
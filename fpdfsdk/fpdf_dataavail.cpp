@@ -226,3 +226,22 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsLinearized(FPDF_AVAIL avail) {
   }
   return avail_context->data_avail()->IsLinearizedPDF();
 }
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDFAvail_GetDownloadHintStats(FPDF_AVAIL avail,
+                               unsigned long* batches,
+                               unsigned long* segments) {
+  auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
+  if (!avail_context) {
+    return false;
+  }
+  const CPDF_DataAvail::HintStats& stats =
+      avail_context->data_avail()->hint_stats();
+  if (batches) {
+    *batches = stats.batches;
+  }
+  if (segments) {
+    *segments = stats.segments;
+  }
+  return true;
+}
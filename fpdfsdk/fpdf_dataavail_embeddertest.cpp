@@ -284,6 +284,60 @@ TEST_F(FPDFDataAvailEmbedderTest, LoadSecondPageIfLinearizedWithHints) {
   EXPECT_TRUE(page);
 }
 
+TEST_F(FPDFDataAvailEmbedderTest, DownloadHintStats) {
+  TestAsyncLoader loader("feature_linearized_loading.pdf");
+  loader.set_is_new_data_available(false);
+  CreateAvail(loader.file_avail(), loader.file_access());
+
+  unsigned long batches = 1;
+  unsigned long segments = 1;
+  ASSERT_TRUE(FPDFAvail_GetDownloadHintStats(avail(), &batches, &segments));
+  EXPECT_EQ(0u, batches);
+  EXPECT_EQ(0u, segments);
+
+  unsigned long round_trips = 0;
+  unsigned long requested_segments = 0;
+  auto check_requested_segments = [&loader, &round_trips,
+                                   &requested_segments]() {
+    const auto& requested = loader.requested_segments();
+    if (requested.empty()) {
+      return;
+    }
+    // Each batch is sorted, with nearby segments merged.
+    for (size_t i = 1; i < requested.size(); ++i) {
+      EXPECT_GT(requested[i].first,
+                requested[i - 1].first + requested[i - 1].second + 4096);
+    }
+    ++round_trips;
+    requested_segments += requested.size();
+    loader.FlushRequestedData();
+  };
+
+  while (FPDFAvail_IsDocAvail(avail(), loader.hints()) != PDF_DATA_AVAIL) {
+    check_requested_segments();
+  }
+  SetDocumentFromAvail();
+  ASSERT_TRUE(document());
+
+  const int page_count = FPDF_GetPageCount(document());
+  ASSERT_GT(page_count, 1);
+  for (int i = 0; i < page_count; ++i) {
+    while (FPDFAvail_IsPageAvail(avail(), i, loader.hints()) !=
+           PDF_DATA_AVAIL) {
+      check_requested_segments();
+    }
+  }
+  check_requested_segments();
+
+  ASSERT_TRUE(FPDFAvail_GetDownloadHintStats(avail(), &batches, &segments));
+  EXPECT_GT(round_trips, 0u);
+  EXPECT_EQ(round_trips, batches);
+  EXPECT_EQ(requested_segments, segments);
+
+  // Either output may be omitted.
+  EXPECT_TRUE(FPDFAvail_GetDownloadHintStats(avail(), nullptr, nullptr));
+}
+
 TEST_F(FPDFDataAvailEmbedderTest, LoadInfoAfterReceivingWholeDocument) {
   TestAsyncLoader loader("linearized.pdf");
   loader.set_is_new_data_available(false);
@@ -405,6 +459,7 @@ TEST_F(FPDFDataAvailEmbedderTest, BadInputsToAPIs) {
   EXPECT_EQ(PDF_DATA_ERROR, FPDFAvail_IsPageAvail(nullptr, 0, nullptr));
   EXPECT_EQ(PDF_FORM_ERROR, FPDFAvail_IsFormAvail(nullptr, nullptr));
   EXPECT_EQ(PDF_LINEARIZATION_UNKNOWN, FPDFAvail_IsLinearized(nullptr));
+  EXPECT_FALSE(FPDFAvail_GetDownloadHintStats(nullptr, nullptr, nullptr));
 }
 
 TEST_F(FPDFDataAvailEmbedderTest, NegativePageIndex) {
@@ -14,6 +14,8 @@
 
 #include "build/build_config.h"
 #include "core/fpdfapi/font/cpdf_font.h"
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_formobject.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
@@ -873,6 +875,44 @@ TEST_F(FPDFEditEmbedderTest, SetText) {
   CloseSavedDocument();
 }
 
+TEST_F(FPDFEditEmbedderTest, SetTextAfterRender) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  // Render first, so that the change has to replace the glyph positions kept
+  // from this render.
+  {
+    ScopedFPDFBitmap page_bitmap = RenderPage(page.get());
+    CompareBitmap(page_bitmap.get(), 200, 200, HelloWorldChecksum());
+  }
+
+  FPDF_PAGEOBJECT page_object = FPDFPage_GetObject(page.get(), 0);
+  ASSERT_TRUE(page_object);
+  ScopedFPDFWideString text = GetFPDFWideString(L"Changed for SetText test");
+  EXPECT_TRUE(FPDFText_SetText(page_object, text.get()));
+
+  // Same as in the SetText test, which does not render before the change.
+  const char* changed_checksum = []() {
+    if (CFX_DefaultRenderDevice::UseSkiaRenderer()) {
+#if BUILDFLAG(IS_WIN)
+      return "e1c530ca0705424f19a1b7ff0bffdbaa";
+#elif BUILDFLAG(IS_APPLE)
+      return "c65881cb16125c23e5513a16dc68f3a2";
+#else
+      return "4a8345a139507932729e07d4831cbe2b";
+#endif
+    }
+#if BUILDFLAG(IS_APPLE)
+    return "b720e83476fd6819d47c533f1f43c728";
+#else
+    return "9a85b9354a69c61772ed24151c140f46";
+#endif
+  }();
+  ScopedFPDFBitmap page_bitmap = RenderPage(page.get());
+  CompareBitmap(page_bitmap.get(), 200, 200, changed_checksum);
+}
+
 TEST_F(FPDFEditEmbedderTest, SetCharcodesBadParams) {
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
   ScopedEmbedderTestPage page = LoadScopedPage(0);
@@ -3198,6 +3238,136 @@ TEST_F(FPDFEditEmbedderTest, FormGetObjects) {
   EXPECT_FALSE(FPDFPage_RemoveObject(page.get(), text2));
 }
 
+TEST_F(FPDFEditEmbedderTest, RepeatedFormObjectsShareParsedForm) {
+  ASSERT_TRUE(OpenDocument("repeated_form_object.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  ASSERT_EQ(4, FPDFPage_CountObjects(page.get()));
+
+  std::array<FPDF_PAGEOBJECT, 4> forms;
+  for (size_t i = 0; i < forms.size(); ++i) {
+    forms[i] = FPDFPage_GetObject(page.get(), i);
+    ASSERT_EQ(FPDF_PAGEOBJ_FORM, FPDFPageObj_GetType(forms[i]));
+  }
+  auto get_form = [](FPDF_PAGEOBJECT form) {
+    return CPDFPageObjectFromFPDFPageObject(form)->AsForm()->form();
+  };
+
+  // The first three draw the form with the same state, and share it. The last
+  // one uses another fill color.
+  EXPECT_EQ(get_form(forms[0]), get_form(forms[1]));
+  EXPECT_EQ(get_form(forms[0]), get_form(forms[2]));
+  EXPECT_NE(get_form(forms[0]), get_form(forms[3]));
+
+  // Each still has its own position.
+  for (size_t i = 0; i < forms.size(); ++i) {
+    float left = 0;
+    float bottom = 0;
+    float right = 0;
+    float top = 0;
+    ASSERT_TRUE(FPDFPageObj_GetBounds(forms[i], &left, &bottom, &right, &top));
+    EXPECT_FLOAT_EQ(10.0f + 20.0f * i, left);
+    EXPECT_FLOAT_EQ(10.0f, bottom);
+    EXPECT_FLOAT_EQ(20.0f + 20.0f * i, right);
+    EXPECT_FLOAT_EQ(20.0f, top);
+  }
+
+  // Getting an object to change from the form of `forms[0]` gives it its own
+  // copy of the form.
+  FPDF_PAGEOBJECT path = FPDFFormObj_GetObject(forms[0], 0);
+  ASSERT_TRUE(path);
+  EXPECT_NE(get_form(forms[0]), get_form(forms[1]));
+  EXPECT_EQ(get_form(forms[1]), get_form(forms[2]));
+  EXPECT_EQ(path, FPDFFormObj_GetObject(forms[0], 0));
+
+  unsigned int r;
+  unsigned int g;
+  unsigned int b;
+  unsigned int a;
+  ASSERT_TRUE(FPDFPageObj_GetFillColor(path, &r, &g, &b, &a));
+  EXPECT_EQ(0u, r);
+  EXPECT_TRUE(FPDFPageObj_SetFillColor(path, 0, 0, 255, 255));
+
+  path = FPDFFormObj_GetObject(forms[1], 0);
+  ASSERT_TRUE(path);
+  ASSERT_TRUE(FPDFPageObj_GetFillColor(path, &r, &g, &b, &a));
+  EXPECT_EQ(0u, r);
+  EXPECT_EQ(0u, b);
+
+  path = FPDFFormObj_GetObject(forms[3], 0);
+  ASSERT_TRUE(path);
+  ASSERT_TRUE(FPDFPageObj_GetFillColor(path, &r, &g, &b, &a));
+  EXPECT_EQ(255u, r);
+}
+
+TEST_F(FPDFEditEmbedderTest, SharedFormsForgottenWithPage) {
+  ASSERT_TRUE(OpenDocument("repeated_form_object.pdf"));
+  auto* page_data = CPDF_DocPageData::FromDocument(
+      CPDFDocumentFromFPDFDocument(document()));
+  EXPECT_EQ(0u, page_data->GetSharedFormStreamCountForTesting());
+  {
+    ScopedEmbedderTestPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    EXPECT_EQ(1u, page_data->GetSharedFormStreamCountForTesting());
+  }
+  EXPECT_EQ(0u, page_data->GetSharedFormStreamCountForTesting());
+
+  // Loading the page again parses the form again.
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  EXPECT_EQ(1u, page_data->GetSharedFormStreamCountForTesting());
+}
+
+TEST_F(FPDFEditEmbedderTest, RenderTileAfterMovingObject) {
+  ScopedFPDFDocument doc(FPDF_CreateNewDocument());
+  ScopedFPDFPage page(FPDFPage_New(doc.get(), 0, 612, 792));
+  ASSERT_TRUE(page);
+
+  // Add enough objects for rendering to use a spatial index, all of them
+  // above y = 100.
+  std::vector<FPDF_PAGEOBJECT> rects;
+  for (int i = 0; i < 400; ++i) {
+    FPDF_PAGEOBJECT rect =
+        FPDFPageObj_CreateNewRect((i % 20) * 30, (i / 20) * 30 + 100, 10, 10);
+    ASSERT_TRUE(rect);
+    EXPECT_TRUE(FPDFPageObj_SetFillColor(rect, 0, 0, 255, 255));
+    EXPECT_TRUE(FPDFPath_SetDrawMode(rect, FPDF_FILLMODE_ALTERNATE, 0));
+    FPDFPage_InsertObject(page.get(), rect);
+    rects.push_back(rect);
+  }
+
+  // Renders the 10x10 tile of the page from (20, 20) to (30, 30), and returns
+  // the blue value of the pixel in its middle.
+  auto render_tile = [&page]() {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(10, 10, 0));
+    EXPECT_TRUE(FPDFBitmap_FillRect(bitmap.get(), 0, 0, 10, 10, 0xFFFFFFFF));
+    static constexpr FS_MATRIX kMatrix = {1, 0, 0, 1, -20, -762};
+    static constexpr FS_RECTF kClip = {0, 0, 10, 10};
+    FPDF_RenderPageBitmapWithMatrix(bitmap.get(), page.get(), &kMatrix, &kClip,
+                                    0);
+    const uint8_t* buffer =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bitmap.get()));
+    const uint8_t* pixel =
+        buffer + 5 * FPDFBitmap_GetStride(bitmap.get()) + 5 * 4;
+    // Blue, green, red.
+    return std::array<uint8_t, 3>{pixel[0], pixel[1], pixel[2]};
+  };
+  static constexpr std::array<uint8_t, 3> kWhite = {255, 255, 255};
+  static constexpr std::array<uint8_t, 3> kBlue = {255, 0, 0};
+  EXPECT_EQ(kWhite, render_tile());
+
+  // Moving an object into the tile must show it, even though the index was
+  // built before it moved.
+  FPDFPageObj_Transform(rects[0], 1, 0, 0, 1, 20, -80);
+  EXPECT_EQ(kBlue, render_tile());
+
+  // And so must removing one and adding it back.
+  ASSERT_TRUE(FPDFPage_RemoveObject(page.get(), rects[0]));
+  EXPECT_EQ(kWhite, render_tile());
+  FPDFPage_InsertObject(page.get(), rects[0]);
+  EXPECT_EQ(kBlue, render_tile());
+}
+
 TEST_F(FPDFEditEmbedderTest, ModifyFormObject) {
   const char* orig_checksum = []() {
     if (CFX_DefaultRenderDevice::UseSkiaRenderer()) {
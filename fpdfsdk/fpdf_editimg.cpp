@@ -524,7 +524,8 @@ FPDFImageObj_GetImageMetadata(FPDF_PAGEOBJECT image_object,
   RetainPtr<CPDF_DIB> pSource = pImg->CreateNewDIB();
   CPDF_DIB::LoadState ret = pSource->StartLoadDIBBase(
       false, nullptr, pPage->GetPageResources().Get(), false,
-      CPDF_ColorSpace::Family::kUnknown, false, {0, 0});
+      CPDF_ColorSpace::Family::kUnknown, false, {0, 0},
+      CFX_FloatRect(0, 0, 1, 1));
   if (ret == CPDF_DIB::LoadState::kFail) {
     return true;
   }
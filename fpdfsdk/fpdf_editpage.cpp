@@ -1149,11 +1149,13 @@ FPDFFormObj_CountObjects(FPDF_PAGEOBJECT form_object) {
 
 FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV
 FPDFFormObj_GetObject(FPDF_PAGEOBJECT form_object, unsigned long index) {
-  const auto* pObjectList = CPDFPageObjHolderFromFPDFFormObject(form_object);
-  if (!pObjectList) {
+  CPDF_FormObject* pFormObject = CPDFFormObjectFromFPDFPageObject(form_object);
+  if (!pFormObject) {
     return nullptr;
   }
 
+  // The caller may change the object, so it must not be shared with other
+  // form objects.
   return FPDFPageObjectFromCPDFPageObject(
-      pObjectList->GetPageObjectByIndex(index));
+      pFormObject->mutable_form()->GetPageObjectByIndex(index));
 }
@@ -162,7 +162,8 @@ bool SaveXFADocumentData(CPDFXFA_Context* pContext,
 bool DoDocSave(FPDF_DOCUMENT document,
                FPDF_FILEWRITE* pFileWrite,
                FPDF_DWORD flags,
-               std::optional<int> version) {
+               std::optional<int> version,
+               uint32_t objects_per_stream) {
   CPDF_Document* pPDFDoc = CPDFDocumentFromFPDFDocument(document);
   if (!pPDFDoc) {
     return false;
@@ -177,7 +178,7 @@ bool DoDocSave(FPDF_DOCUMENT document,
   }
 #endif  // PDF_ENABLE_XFA
 
-  if (flags < FPDF_INCREMENTAL || flags > FPDF_REMOVE_SECURITY) {
+  if (flags < FPDF_INCREMENTAL || flags > FPDF_INCREMENTAL_CHANGES) {
     flags = 0;
   }
 
@@ -186,6 +187,9 @@ bool DoDocSave(FPDF_DOCUMENT document,
   if (version.has_value()) {
     fileMaker.SetFileVersion(version.value());
   }
+  if (objects_per_stream) {
+    fileMaker.EnableObjectStreams(objects_per_stream);
+  }
   if (flags == FPDF_REMOVE_SECURITY) {
     flags = 0;
     fileMaker.RemoveSecurity();
@@ -207,7 +211,8 @@ bool DoDocSave(FPDF_DOCUMENT document,
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SaveAsCopy(FPDF_DOCUMENT document,
                                                     FPDF_FILEWRITE* pFileWrite,
                                                     FPDF_DWORD flags) {
-  return DoDocSave(document, pFileWrite, flags, {});
+  return DoDocSave(document, pFileWrite, flags, {},
+                   /*objects_per_stream=*/0);
 }
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
@@ -215,5 +220,24 @@ FPDF_SaveWithVersion(FPDF_DOCUMENT document,
                      FPDF_FILEWRITE* pFileWrite,
                      FPDF_DWORD flags,
                      int fileVersion) {
-  return DoDocSave(document, pFileWrite, flags, fileVersion);
+  return DoDocSave(document, pFileWrite, flags, fileVersion,
+                   /*objects_per_stream=*/0);
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SaveWithObjectStreams(FPDF_DOCUMENT document,
+                           FPDF_FILEWRITE* pFileWrite,
+                           FPDF_DWORD flags,
+                           int objects_per_stream) {
+  static constexpr int kDefaultObjectsPerStream = 100;
+
+  if (flags == FPDF_INCREMENTAL || flags == FPDF_INCREMENTAL_CHANGES ||
+      objects_per_stream < 0 || objects_per_stream > 0xFFFF) {
+    return false;
+  }
+  if (objects_per_stream == 0) {
+    objects_per_stream = kDefaultObjectsPerStream;
+  }
+  return DoDocSave(document, pFileWrite, flags, {},
+                   static_cast<uint32_t>(objects_per_stream));
 }
@@ -5,7 +5,10 @@
 #include <array>
 #include <string>
 
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/fx_string.h"
+#include "fpdfsdk/cpdfsdk_helpers.h"
 #include "public/cpp/fpdf_scopers.h"
 #include "public/fpdf_edit.h"
 #include "public/fpdf_ppo.h"
@@ -59,6 +62,86 @@ TEST_F(FPDFSaveEmbedderTest, SaveSimpleDocIncremental) {
   EXPECT_EQ(985u, GetString().size());
 }
 
+TEST_F(FPDFSaveEmbedderTest, SaveSimpleDocIncrementalChanges) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL_CHANGES));
+  EXPECT_THAT(GetString(), StartsWith("%PDF-1.7\n%\xa0\xf2\xa4\xf4"));
+  EXPECT_EQ(1051u, GetString().size());
+
+  // Nothing changed, so only a cross-reference stream follows the 840 bytes of
+  // the original file.
+  std::string update = GetString().substr(840);
+  EXPECT_THAT(update,
+              StartsWith("7 0 obj <</Type/XRef/Root 1 0 R /Size 8/Prev 633/ID["));
+  EXPECT_THAT(update, HasSubstr("/W[1 4 2]/Index[7 1]/Length 7>>stream\r\n"));
+
+  // The entry for the stream itself, at offset 840.
+  const std::string kEntry("\x01\x00\x00\x03\x48\x00\x00", 7);
+  EXPECT_THAT(update, HasSubstr(kEntry + "\r\nendstream\r\nendobj"));
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveChangedDocIncrementalChanges) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  {
+    ScopedEmbedderTestPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    FPDFPage_SetRotation(page.get(), 1);
+  }
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL_CHANGES));
+
+  // Only the page object changed. The fonts and the contents were parsed too,
+  // but are not written again.
+  std::string update = GetString().substr(840);
+  EXPECT_THAT(update, StartsWith("3 0 obj\r\n<<"));
+  EXPECT_THAT(update, HasSubstr("/Rotate 90"));
+  EXPECT_THAT(update, HasSubstr("/Index[3 1 7 1]"));
+  EXPECT_THAT(update, Not(HasSubstr("4 0 obj")));
+  EXPECT_THAT(update, Not(HasSubstr("6 0 obj")));
+
+  ASSERT_TRUE(OpenSavedDocument());
+  FPDF_PAGE saved_page = LoadSavedPage(0);
+  ASSERT_TRUE(saved_page);
+  EXPECT_EQ(1, FPDFPage_GetRotation(saved_page));
+  CloseSavedPage(saved_page);
+  CloseSavedDocument();
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveDeletedObjectIncrementalChanges) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  {
+    ScopedEmbedderTestPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+  }
+
+  // Remove the second font from the page's inline /Resources, and delete it.
+  CPDF_Document* doc = CPDFDocumentFromFPDFDocument(document());
+  RetainPtr<CPDF_Dictionary> page_dict = doc->GetMutablePageDictionary(0);
+  ASSERT_TRUE(page_dict);
+  RetainPtr<CPDF_Dictionary> fonts =
+      page_dict->GetMutableDictFor("Resources")->GetMutableDictFor("Font");
+  ASSERT_TRUE(fonts);
+  ASSERT_TRUE(fonts->RemoveFor("F2"));
+  ASSERT_TRUE(doc->GetIndirectObject(5));
+  doc->DeleteIndirectObject(5);
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL_CHANGES));
+
+  // The page is written again, and the font is freed with generation 1.
+  std::string update = GetString().substr(840);
+  EXPECT_THAT(update, StartsWith("3 0 obj\r\n<<"));
+  EXPECT_THAT(update, Not(HasSubstr("/F2")));
+  EXPECT_THAT(update, HasSubstr("/Index[3 1 5 1 7 1]"));
+  const std::string kFreeEntry("\x00\x00\x00\x00\x00\x00\x01", 7);
+  EXPECT_THAT(update, HasSubstr(kFreeEntry));
+
+  ASSERT_TRUE(OpenSavedDocument());
+  FPDF_PAGE saved_page = LoadSavedPage(0);
+  ASSERT_TRUE(saved_page);
+  EXPECT_FALSE(CPDFDocumentFromFPDFDocument(saved_document())
+                   ->GetOrParseIndirectObject(5));
+  CloseSavedPage(saved_page);
+  CloseSavedDocument();
+}
+
 TEST_F(FPDFSaveEmbedderTest, SaveSimpleDocNoIncremental) {
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
   EXPECT_TRUE(FPDF_SaveWithVersion(document(), this, FPDF_NO_INCREMENTAL, 14));
@@ -80,6 +163,78 @@ TEST_F(FPDFSaveEmbedderTest, SaveSimpleDocBadFlags) {
   EXPECT_EQ(805u, GetString().size());
 }
 
+TEST_F(FPDFSaveEmbedderTest, SaveSimpleDocWithObjectStreams) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  std::string original_md5;
+  {
+    ScopedEmbedderTestPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    original_md5 = HashBitmap(bitmap.get());
+  }
+  EXPECT_TRUE(FPDF_SaveWithObjectStreams(document(), this, 0, 0));
+
+  // The catalog, page tree, page and fonts all fit in one object stream. Only
+  // the content stream, the object stream and the cross-reference stream are
+  // written directly.
+  EXPECT_THAT(GetString(), StartsWith("%PDF-1.7\r\n"));
+  EXPECT_THAT(GetString(), HasSubstr("7 0 obj\r\n<<"));
+  EXPECT_THAT(GetString(), HasSubstr("/N 5/Type/ObjStm>>"));
+  EXPECT_THAT(GetString(), HasSubstr("8 0 obj <</Type/XRef/Root 1 0 R /Size 9"));
+  EXPECT_THAT(GetString(), HasSubstr("/W[1 4 2]/Index[0 9]"));
+  EXPECT_THAT(GetString(), Not(HasSubstr("1 0 obj")));
+  EXPECT_THAT(GetString(), Not(HasSubstr("trailer")));
+  EXPECT_EQ(703u, GetString().size());
+
+  ASSERT_TRUE(OpenSavedDocument());
+  FPDF_PAGE saved_page = LoadSavedPage(0);
+  ASSERT_TRUE(saved_page);
+  ScopedFPDFBitmap bitmap = RenderSavedPage(saved_page);
+  EXPECT_EQ(original_md5, HashBitmap(bitmap.get()));
+  CloseSavedPage(saved_page);
+  CloseSavedDocument();
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveLinearizedDocWithObjectStreams) {
+  const int kPageCount = 3;
+  std::array<std::string, kPageCount> original_md5;
+
+  ASSERT_TRUE(OpenDocument("linearized.pdf"));
+  for (int i = 0; i < kPageCount; ++i) {
+    ScopedEmbedderTestPage page = LoadScopedPage(i);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    original_md5[i] = HashBitmap(bitmap.get());
+  }
+
+  EXPECT_TRUE(FPDF_SaveWithObjectStreams(document(), this,
+                                         FPDF_NO_INCREMENTAL, 2));
+  EXPECT_THAT(GetString(), HasSubstr("/N 2/Type/ObjStm>>"));
+  EXPECT_THAT(GetString(), Not(HasSubstr("trailer")));
+
+  ASSERT_TRUE(OpenSavedDocument());
+  ASSERT_EQ(kPageCount, FPDF_GetPageCount(saved_document()));
+  for (int i = 0; i < kPageCount; ++i) {
+    FPDF_PAGE page = LoadSavedPage(i);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderSavedPage(page);
+    EXPECT_EQ(original_md5[i], HashBitmap(bitmap.get()));
+    CloseSavedPage(page);
+  }
+  CloseSavedDocument();
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveWithObjectStreamsBadArgs) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  EXPECT_FALSE(FPDF_SaveWithObjectStreams(document(), this, FPDF_INCREMENTAL,
+                                          0));
+  EXPECT_FALSE(FPDF_SaveWithObjectStreams(document(), this,
+                                          FPDF_INCREMENTAL_CHANGES, 0));
+  EXPECT_FALSE(FPDF_SaveWithObjectStreams(document(), this, 0, -1));
+  EXPECT_FALSE(FPDF_SaveWithObjectStreams(document(), this, 0, 65536));
+  EXPECT_TRUE(GetString().empty());
+}
+
 TEST_F(FPDFSaveEmbedderTest, SaveCopiedDoc) {
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
 
@@ -7,12 +7,19 @@
 #include "public/fpdfview.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "build/build_config.h"
+#include "core/fpdfapi/page/cpdf_decodedimagecache.h"
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_formobject.h"
 #include "core/fpdfapi/page/cpdf_occontext.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
@@ -20,8 +27,11 @@
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_modified_objects.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_object_stream_cache.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
@@ -37,15 +47,18 @@
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
+#include "core/fxcrt/fx_parallel.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/ptr_util.h"
+#include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "core/fxcrt/unowned_ptr_exclusion.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphcache.h"
@@ -57,6 +70,7 @@
 #include "fpdfsdk/cpdfsdk_pageview.h"
 #include "fpdfsdk/cpdfsdk_renderpage.h"
 #include "fxjs/ijs_runtime.h"
+#include "public/cpp/fpdf_scopers.h"
 #include "public/fpdf_formfill.h"
 
 #ifdef PDF_ENABLE_V8
@@ -120,6 +134,11 @@ static_assert(static_cast<int>(CFX_DefaultRenderDevice::RendererType::kSkia) ==
 namespace {
 
 bool g_bLibraryInitialized = false;
+thread_local bool g_bThreadInitialized = false;
+std::thread::id g_init_thread_id;
+
+// Exclude because taken from public API.
+UNOWNED_PTR_EXCLUSION const char** g_user_font_paths = nullptr;
 
 void SetRendererType(FPDF_RENDERER_TYPE public_type) {
   // Internal definition of renderer types must stay updated with respect to
@@ -206,6 +225,79 @@ std::vector<XFAPacket> GetXFAPackets(RetainPtr<const CPDF_Object> xfa_object) {
   return packets;
 }
 
+// Lets each worker thread own a stream object, so that only the stream data,
+// guarded by `lock`, is shared between threads. Resident data is read-only, so
+// it is read without taking the lock.
+class LockedReadStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override { return size_; }
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override {
+    if (!resident_data_.empty()) {
+      FX_SAFE_SIZE_T end = buffer.size();
+      end += offset;
+      if (buffer.empty() || offset < 0 || !end.IsValid() ||
+          end.ValueOrDie() > resident_data_.size()) {
+        return false;
+      }
+      fxcrt::Copy(resident_data_.subspan(static_cast<size_t>(offset),
+                                         buffer.size()),
+                  buffer);
+      return true;
+    }
+    std::lock_guard<std::mutex> guard(*lock_);
+    return source_->ReadBlockAtOffset(buffer, offset);
+  }
+  pdfium::span<const uint8_t> GetResidentSpan() override {
+    return resident_data_;
+  }
+
+ private:
+  LockedReadStream(IFX_SeekableReadStream* source,
+                   FX_FILESIZE size,
+                   pdfium::span<const uint8_t> resident_data,
+                   std::mutex* lock)
+      : source_(source),
+        size_(size),
+        resident_data_(resident_data),
+        lock_(lock) {}
+  ~LockedReadStream() override = default;
+
+  UnownedPtr<IFX_SeekableReadStream> const source_;
+  const FX_FILESIZE size_;
+  const pdfium::raw_span<const uint8_t> resident_data_;
+  UnownedPtr<std::mutex> const lock_;
+};
+
+// Serves the buffer passed to FPDF_LoadMemDocument(). Embedders keep it valid
+// while the document is open, and objects that reference file data never
+// outlive the document, as clones copy their data. So the buffer is exposed
+// as resident, and streams borrow from it instead of copying.
+class MemDocumentStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override { return stream_->GetSize(); }
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override {
+    return stream_->ReadBlockAtOffset(buffer, offset);
+  }
+  pdfium::span<const uint8_t> GetResidentSpan() override { return data_; }
+
+ private:
+  explicit MemDocumentStream(pdfium::span<const uint8_t> data)
+      : data_(data),
+        stream_(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data)) {}
+  ~MemDocumentStream() override = default;
+
+  const pdfium::raw_span<const uint8_t> data_;
+  const RetainPtr<CFX_ReadOnlySpanStream> stream_;
+};
+
 FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
                                FPDF_BYTESTRING password) {
   if (!pFileAccess) {
@@ -228,6 +320,93 @@ FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
   return FPDFDocumentFromCPDFDocument(pDocument.release());
 }
 
+// Parses copies of a document on worker threads, as parsed objects cannot be
+// shared between threads.
+class WorkerDocumentLoader {
+ public:
+  // Returns nullptr if `doc` was not loaded from a fully available file.
+  static std::unique_ptr<WorkerDocumentLoader> Create(CPDF_Document* doc) {
+    if (doc->GetExtension()) {
+      return nullptr;
+    }
+    CPDF_Parser* parser = doc->GetParser();
+    RetainPtr<CPDF_ReadValidator> validator =
+        parser ? parser->GetValidator() : nullptr;
+    if (!validator || !validator->IsWholeFileAvailable()) {
+      return nullptr;
+    }
+    return std::make_unique<WorkerDocumentLoader>(validator->GetFileRead(),
+                                                  parser->GetPassword());
+  }
+
+  WorkerDocumentLoader(RetainPtr<IFX_SeekableReadStream> source,
+                       const ByteString& password)
+      : source_(std::move(source)),
+        source_size_(source_->GetSize()),
+        source_resident_data_(source_->GetResidentSpan()),
+        password_(password) {}
+
+  // May be called on any thread with library state.
+  ScopedFPDFDocument Load() {
+    return ScopedFPDFDocument(LoadDocumentImpl(
+        pdfium::MakeRetain<LockedReadStream>(source_.Get(), source_size_,
+                                             source_resident_data_,
+                                             &source_lock_),
+        password_.c_str()));
+  }
+
+ private:
+  RetainPtr<IFX_SeekableReadStream> const source_;
+  const FX_FILESIZE source_size_;
+  const pdfium::raw_span<const uint8_t> source_resident_data_;
+  const ByteString password_;
+  std::mutex source_lock_;
+};
+
+// Same as fxcrt::RunOnThreads(), but also sets up library state for the new
+// threads.
+void RunOnWorkerThreads(size_t count,
+                        const std::function<void(size_t)>& task) {
+  fxcrt::RunOnThreads(count, [&task](size_t thread_index) {
+    // The calling thread already has its library state.
+    const bool init_thread = thread_index > 0;
+    if (init_thread) {
+      FPDF_InitLibraryForThread();
+    }
+    task(thread_index);
+    if (init_thread) {
+      FPDF_DestroyLibraryForThread();
+    }
+  });
+}
+
+// Returns whether `holder` has page objects changed since its content was last
+// generated, which other threads would not see when parsing the file.
+bool HasDirtyPageObjects(const CPDF_PageObjectHolder* holder) {
+  if (holder->HasDirtyStreams()) {
+    return true;
+  }
+  for (const auto& page_object : *holder) {
+    if (page_object->IsDirty()) {
+      return true;
+    }
+    const CPDF_FormObject* form_object = page_object->AsForm();
+    if (form_object && HasDirtyPageObjects(form_object->form())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns whether `page` may render differently once parsed again from the
+// file of its document.
+bool HasUnsavedChanges(const CPDF_Page* page) {
+  const CPDF_ModifiedObjects* modified =
+      page->GetDocument()->GetModifiedObjects();
+  return !modified->modified().empty() || !modified->deleted().empty() ||
+         HasDirtyPageObjects(page);
+}
+
 }  // namespace
 
 FPDF_EXPORT void FPDF_CALLCONV FPDF_InitLibrary() {
@@ -242,7 +421,9 @@ FPDF_InitLibraryWithConfig(const FPDF_LIBRARY_CONFIG* config) {
 
   FX_InitializeMemoryAllocators();
   CFX_Timer::InitializeGlobals();
-  CFX_GEModule::Create(config ? config->m_pUserFontPaths : nullptr);
+  g_init_thread_id = std::this_thread::get_id();
+  g_user_font_paths = config ? config->m_pUserFontPaths : nullptr;
+  CFX_GEModule::Create(g_user_font_paths);
   pdfium::InitializePageModule();
 
 #if defined(PDF_USE_SKIA)
@@ -288,9 +469,33 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary() {
   CFX_Timer::DestroyGlobals();
   FX_DestroyMemoryAllocators();
 
+  g_user_font_paths = nullptr;
+  g_init_thread_id = std::thread::id();
   g_bLibraryInitialized = false;
 }
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_InitLibraryForThread() {
+  if (!g_bLibraryInitialized || g_bThreadInitialized ||
+      std::this_thread::get_id() == g_init_thread_id) {
+    return false;
+  }
+
+  CFX_GEModule::CreateForThread(g_user_font_paths);
+  pdfium::InitializePageModuleForThread();
+  g_bThreadInitialized = true;
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibraryForThread() {
+  if (!g_bThreadInitialized) {
+    return;
+  }
+
+  pdfium::DestroyPageModuleForThread();
+  CFX_GEModule::DestroyForThread();
+  g_bThreadInitialized = false;
+}
+
 FPDF_EXPORT void FPDF_CALLCONV FPDF_SetSandBoxPolicy(FPDF_DWORD policy,
                                                      FPDF_BOOL enable) {
   return SetPDFSandboxPolicy(policy, enable);
@@ -364,7 +569,7 @@ FPDF_LoadMemDocument(const void* data_buf, int size, FPDF_BYTESTRING password) {
   // SAFETY: required from caller.
   auto data_span = UNSAFE_BUFFERS(pdfium::span(
       static_cast<const uint8_t*>(data_buf), static_cast<size_t>(size)));
-  return LoadDocumentImpl(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data_span),
+  return LoadDocumentImpl(pdfium::MakeRetain<MemDocumentStream>(data_span),
                           password);
 }
 
@@ -375,7 +580,7 @@ FPDF_LoadMemDocument64(const void* data_buf,
   // SAFETY: required from caller.
   auto data_span =
       UNSAFE_BUFFERS(pdfium::span(static_cast<const uint8_t*>(data_buf), size));
-  return LoadDocumentImpl(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data_span),
+  return LoadDocumentImpl(pdfium::MakeRetain<MemDocumentStream>(data_span),
                           password);
 }
 
@@ -829,6 +1034,154 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                      /*color_scheme=*/nullptr);
 }
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPagesParallel(FPDF_DOCUMENT document,
+                         int start_index,
+                         int page_count,
+                         int thread_count,
+                         int flags,
+                         FPDF_PAGE_BITMAP_PRODUCER* producer) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc || !producer || producer->version != 1 || !producer->GetBitmap ||
+      !producer->PageRendered || start_index < 0 || page_count < 0 ||
+      thread_count < 0) {
+    return false;
+  }
+
+  FX_SAFE_INT32 end_index = start_index;
+  end_index += page_count;
+  if (!end_index.IsValid() || end_index.ValueOrDie() > pDoc->GetPageCount()) {
+    return false;
+  }
+
+  std::unique_ptr<WorkerDocumentLoader> loader =
+      WorkerDocumentLoader::Create(pDoc);
+  if (!loader) {
+    return false;
+  }
+
+  std::atomic<int> next_index = start_index;
+  size_t max_threads = thread_count ? thread_count : fxcrt::GetMaxParallelism();
+  max_threads = std::min<size_t>(max_threads, std::max(page_count, 1));
+  RunOnWorkerThreads(max_threads, [&](size_t) {
+    ScopedFPDFDocument worker_doc = loader->Load();
+    for (int i = next_index++; i < end_index.ValueOrDie(); i = next_index++) {
+      ScopedFPDFPage page(
+          worker_doc ? FPDF_LoadPage(worker_doc.get(), i) : nullptr);
+      FPDF_BITMAP bitmap =
+          page ? producer->GetBitmap(producer, i,
+                                     FPDF_GetPageWidthF(page.get()),
+                                     FPDF_GetPageHeightF(page.get()))
+               : nullptr;
+      if (bitmap) {
+        FPDF_RenderPageBitmap(bitmap, page.get(), /*start_x=*/0,
+                              /*start_y=*/0, FPDFBitmap_GetWidth(bitmap),
+                              FPDFBitmap_GetHeight(bitmap), /*rotate=*/0,
+                              flags);
+      }
+      producer->PageRendered(producer, i, bitmap);
+    }
+  });
+  return true;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPageBitmapParallel(FPDF_BITMAP bitmap,
+                              FPDF_PAGE page,
+                              int start_x,
+                              int start_y,
+                              int size_x,
+                              int size_y,
+                              int rotate,
+                              int flags,
+                              int thread_count) {
+  // Bands per thread, so threads that finish early can take over work.
+  static constexpr int kBandsPerThread = 4;
+
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (!pPage || !pBitmap || thread_count < 0) {
+    return false;
+  }
+
+  CPDF_Document* pDoc = pPage->GetDocument();
+  const int page_index = pDoc->GetPageIndex(pPage->GetDict()->GetObjNum());
+  std::unique_ptr<WorkerDocumentLoader> loader =
+      WorkerDocumentLoader::Create(pDoc);
+  if (page_index < 0 || !loader) {
+    return false;
+  }
+
+  // Other threads parse the page from the file, so they would miss edits.
+  bool render_serially = HasUnsavedChanges(pPage);
+#if defined(PDF_USE_SKIA)
+  // Skia may premultiply the whole bitmap, so it cannot share it.
+  render_serially |= CFX_DefaultRenderDevice::UseSkiaRenderer();
+#endif
+  if (render_serially) {
+    FPDF_RenderPageBitmap(bitmap, page, start_x, start_y, size_x, size_y,
+                          rotate, flags);
+    return true;
+  }
+  ValidateBitmapPremultiplyState(pBitmap);
+
+  const FX_RECT page_rect(start_x, start_y, start_x + size_x,
+                          start_y + size_y);
+  FX_RECT render_rect = page_rect;
+  render_rect.Intersect(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight());
+  if (render_rect.IsEmpty()) {
+    return true;
+  }
+
+  // Each thread renders the whole page into its own bitmap object over the
+  // same pixels, clipped to the bands it claims. Clipping happens per span in
+  // the device, after rasterization, so the result matches a serial render.
+  const int width = pBitmap->GetWidth();
+  const int height = pBitmap->GetHeight();
+  const FXDIB_Format format = pBitmap->GetFormat();
+  const uint32_t pitch = pBitmap->GetPitch();
+  uint8_t* const pixels = pBitmap->GetWritableBuffer().data();
+  size_t max_threads = thread_count ? thread_count : fxcrt::GetMaxParallelism();
+  const int band_count = pdfium::checked_cast<int>(std::min<size_t>(
+      render_rect.Height(), max_threads * kBandsPerThread));
+  max_threads = std::min<size_t>(max_threads, band_count);
+  std::atomic<int> next_band = 0;
+  RunOnWorkerThreads(max_threads, [&](size_t) {
+    ScopedFPDFDocument worker_doc = loader->Load();
+    ScopedFPDFPage worker_page(
+        worker_doc ? FPDF_LoadPage(worker_doc.get(), page_index) : nullptr);
+    CPDF_Page* pWorkerPage = CPDFPageFromFPDFPage(worker_page.get());
+    auto pBand = pdfium::MakeRetain<CFX_DIBitmap>();
+    if (!pWorkerPage || !pBand->Create(width, height, format, pixels, pitch)) {
+      return;
+    }
+
+    const CFX_Matrix matrix = pWorkerPage->GetDisplayMatrix(page_rect, rotate);
+    for (int i = next_band++; i < band_count; i = next_band++) {
+      const FX_RECT band_rect(
+          render_rect.left,
+          render_rect.top + render_rect.Height() * i / band_count,
+          render_rect.right,
+          render_rect.top + render_rect.Height() * (i + 1) / band_count);
+
+      auto owned_context = std::make_unique<CPDF_PageRenderContext>();
+      CPDF_PageRenderContext* context = owned_context.get();
+      CPDF_Page::RenderContextClearer clearer(pWorkerPage);
+      pWorkerPage->SetRenderContext(std::move(owned_context));
+
+      auto device = std::make_unique<CFX_DefaultRenderDevice>();
+      device->AttachWithRgbByteOrder(pBand,
+                                     !!(flags & FPDF_REVERSE_BYTE_ORDER));
+      context->device_ = std::move(device);
+      CPDFSDK_RenderPage(context, pWorkerPage, matrix, band_rect, flags,
+                         /*color_scheme=*/nullptr);
+    }
+  });
+
+  // Bands are only left unclaimed if no thread could load the page.
+  return next_band >= band_count;
+}
+
 #if defined(PDF_USE_SKIA)
 FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageSkia(FPDF_SKIA_CANVAS canvas,
                                                    FPDF_PAGE page,
@@ -1528,3 +1881,74 @@ FPDF_GetTrailerEnds(FPDF_DOCUMENT document,
 
   return trailer_ends_len;
 }
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetObjectStreamCacheLimit(FPDF_DOCUMENT document, size_t max_bytes) {
+  auto* doc = CPDFDocumentFromFPDFDocument(document);
+  if (!doc || !doc->GetParser()) {
+    return false;
+  }
+
+  doc->GetParser()->object_stream_cache()->SetMaxBytes(max_bytes);
+  return true;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetObjectStreamCacheStats(FPDF_DOCUMENT document,
+                               unsigned long* hits,
+                               unsigned long* misses) {
+  auto* doc = CPDFDocumentFromFPDFDocument(document);
+  if (!doc || !doc->GetParser()) {
+    return false;
+  }
+
+  const CPDF_ObjectStreamCache* cache =
+      doc->GetParser()->object_stream_cache();
+  if (hits) {
+    *hits = static_cast<unsigned long>(cache->hit_count());
+  }
+  if (misses) {
+    *misses = static_cast<unsigned long>(cache->miss_count());
+  }
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetImageCacheLimit(size_t max_bytes) {
+  CPDF_DecodedImageCache::GetInstance()->SetMaxBytes(max_bytes);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_GetImageCacheStats(unsigned long* hits,
+                                                       unsigned long* misses,
+                                                       size_t* bytes) {
+  const CPDF_DecodedImageCache* cache = CPDF_DecodedImageCache::GetInstance();
+  if (hits) {
+    *hits = static_cast<unsigned long>(cache->hit_count());
+  }
+  if (misses) {
+    *misses = static_cast<unsigned long>(cache->miss_count());
+  }
+  if (bytes) {
+    *bytes = cache->total_bytes();
+  }
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetImageThreadCount(int thread_count) {
+  if (thread_count < 0) {
+    return false;
+  }
+
+  CFX_GEModule::Get()->SetImageThreadCount(
+      thread_count ? thread_count : fxcrt::GetMaxParallelism());
+  return true;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetRebuildThreadCount(int thread_count) {
+  if (thread_count < 0) {
+    return false;
+  }
+
+  CPDF_Parser::SetDefaultRebuildThreadCount(
+      thread_count ? thread_count : fxcrt::GetMaxParallelism());
+  return true;
+}
@@ -129,6 +129,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFAvail_Destroy);
     CHK(FPDFAvail_GetDocument);
     CHK(FPDFAvail_GetFirstPageNum);
+    CHK(FPDFAvail_GetDownloadHintStats);
     CHK(FPDFAvail_IsDocAvail);
     CHK(FPDFAvail_IsFormAvail);
     CHK(FPDFAvail_IsLinearized);
@@ -358,6 +359,7 @@ int CheckPDFiumCApi() {
 
     // fpdf_save.h
     CHK(FPDF_SaveAsCopy);
+    CHK(FPDF_SaveWithObjectStreams);
     CHK(FPDF_SaveWithVersion);
 
     // fpdf_searchex.h
@@ -499,6 +501,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_ClosePage);
     CHK(FPDF_CountNamedDests);
     CHK(FPDF_DestroyLibrary);
+    CHK(FPDF_DestroyLibraryForThread);
     CHK(FPDF_DeviceToPage);
     CHK(FPDF_DocumentHasValidCrossReferenceTable);
 #ifdef PDF_ENABLE_V8
@@ -507,9 +510,11 @@ int CheckPDFiumCApi() {
     CHK(FPDF_GetDocPermissions);
     CHK(FPDF_GetDocUserPermissions);
     CHK(FPDF_GetFileVersion);
+    CHK(FPDF_GetImageCacheStats);
     CHK(FPDF_GetLastError);
     CHK(FPDF_GetNamedDest);
     CHK(FPDF_GetNamedDestByName);
+    CHK(FPDF_GetObjectStreamCacheStats);
     CHK(FPDF_GetPageBoundingBox);
     CHK(FPDF_GetPageCount);
     CHK(FPDF_GetPageHeight);
@@ -527,6 +532,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_GetXFAPacketCount);
     CHK(FPDF_GetXFAPacketName);
     CHK(FPDF_InitLibrary);
+    CHK(FPDF_InitLibraryForThread);
     CHK(FPDF_InitLibraryWithConfig);
     CHK(FPDF_LoadCustomDocument);
     CHK(FPDF_LoadDocument);
@@ -538,13 +544,19 @@ int CheckPDFiumCApi() {
     CHK(FPDF_RenderPage);
 #endif
     CHK(FPDF_RenderPageBitmap);
+    CHK(FPDF_RenderPageBitmapParallel);
     CHK(FPDF_RenderPageBitmapWithMatrix);
+    CHK(FPDF_RenderPagesParallel);
 #if defined(PDF_USE_SKIA)
     CHK(FPDF_RenderPageSkia);
 #endif
+    CHK(FPDF_SetImageCacheLimit);
+    CHK(FPDF_SetImageThreadCount);
+    CHK(FPDF_SetObjectStreamCacheLimit);
 #if defined(_WIN32)
     CHK(FPDF_SetPrintMode);
 #endif
+    CHK(FPDF_SetRebuildThreadCount);
     CHK(FPDF_SetSandBoxPolicy);
     CHK(FPDF_VIEWERREF_GetDuplex);
     CHK(FPDF_VIEWERREF_GetName);
@@ -5,18 +5,25 @@
 #include <math.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "build/build_config.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/fx_folder.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_edit.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -1972,6 +1979,178 @@ TEST_F(FPDFViewEmbedderTest, GetTrailerEnds) {
   EXPECT_EQ(1U, ends[1]);
 }
 
+TEST_F(FPDFViewEmbedderTest, ObjectStreamCache) {
+  unsigned long hits = 0;
+  unsigned long misses = 0;
+  EXPECT_FALSE(FPDF_SetObjectStreamCacheLimit(nullptr, 0));
+  EXPECT_FALSE(FPDF_GetObjectStreamCacheStats(nullptr, &hits, &misses));
+
+  ASSERT_TRUE(OpenDocument("feature_linearized_loading.pdf"));
+  for (int i = 0; i < FPDF_GetPageCount(document()); ++i) {
+    ScopedEmbedderTestPage page = LoadScopedPage(i);
+    ASSERT_TRUE(page);
+  }
+  ASSERT_TRUE(FPDF_GetObjectStreamCacheStats(document(), &hits, &misses));
+  EXPECT_EQ(6u, hits);
+  EXPECT_EQ(5u, misses);
+  CloseDocument();
+
+  // With room for just one decoded stream, streams get decoded again.
+  ASSERT_TRUE(OpenDocument("feature_linearized_loading.pdf"));
+  ASSERT_TRUE(FPDF_SetObjectStreamCacheLimit(document(), 0));
+  for (int i = 0; i < FPDF_GetPageCount(document()); ++i) {
+    ScopedEmbedderTestPage page = LoadScopedPage(i);
+    ASSERT_TRUE(page);
+  }
+  ASSERT_TRUE(FPDF_GetObjectStreamCacheStats(document(), &hits, &misses));
+  EXPECT_EQ(5u, hits);
+  EXPECT_EQ(6u, misses);
+
+  EXPECT_TRUE(FPDF_GetObjectStreamCacheStats(document(), nullptr, nullptr));
+}
+
+TEST_F(FPDFViewEmbedderTest, ImageCache) {
+  unsigned long hits = 0;
+  unsigned long misses = 0;
+  size_t bytes = 0;
+  FPDF_GetImageCacheStats(&hits, &misses, &bytes);
+  const unsigned long initial_hits = hits;
+  const unsigned long initial_misses = misses;
+  EXPECT_EQ(0u, bytes);
+
+  // The cache is off by default.
+  FPDF_SetImageCacheLimit(256 * 1024 * 1024);
+  ASSERT_TRUE(OpenDocument("form_object_with_image.pdf"));
+  auto render_page = [this]() {
+    ScopedEmbedderTestPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    ASSERT_TRUE(bitmap);
+  };
+  render_page();
+  FPDF_GetImageCacheStats(&hits, &misses, &bytes);
+  EXPECT_EQ(initial_hits, hits);
+  EXPECT_EQ(initial_misses + 1, misses);
+  EXPECT_GT(bytes, 0u);
+
+  // The decoded image outlives the page.
+  render_page();
+  FPDF_GetImageCacheStats(&hits, &misses, &bytes);
+  EXPECT_EQ(initial_hits + 1, hits);
+  EXPECT_EQ(initial_misses + 1, misses);
+
+  // Without room, the image gets decoded again.
+  FPDF_SetImageCacheLimit(0);
+  FPDF_GetImageCacheStats(nullptr, nullptr, &bytes);
+  EXPECT_EQ(0u, bytes);
+  render_page();
+  FPDF_GetImageCacheStats(&hits, &misses, &bytes);
+  EXPECT_EQ(initial_hits + 1, hits);
+  EXPECT_EQ(initial_misses + 2, misses);
+  EXPECT_EQ(0u, bytes);
+
+  // Closing the document drops its images.
+  FPDF_SetImageCacheLimit(256 * 1024 * 1024);
+  render_page();
+  FPDF_GetImageCacheStats(nullptr, nullptr, &bytes);
+  EXPECT_GT(bytes, 0u);
+  CloseDocument();
+  FPDF_GetImageCacheStats(nullptr, nullptr, &bytes);
+  EXPECT_EQ(0u, bytes);
+
+  FPDF_GetImageCacheStats(nullptr, nullptr, nullptr);
+  FPDF_SetImageCacheLimit(0);
+}
+
+TEST_F(FPDFViewEmbedderTest, ImageCacheClippedRender) {
+  // Renders the page into a white bitmap, drawing only above `clip_bottom`.
+  auto render_page = [](FPDF_PAGE page, int width, int height,
+                        float clip_bottom) {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+    EXPECT_TRUE(
+        FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF));
+    const FS_MATRIX matrix{1, 0, 0, 1, 0, 0};
+    const FS_RECTF clip{0, 0, static_cast<float>(width), clip_bottom};
+    FPDF_RenderPageBitmapWithMatrix(bitmap.get(), page, &matrix, &clip, 0);
+    return bitmap;
+  };
+  auto same_lines = [](FPDF_BITMAP bitmap1, FPDF_BITMAP bitmap2, int lines) {
+    const int stride = FPDFBitmap_GetStride(bitmap1);
+    EXPECT_EQ(stride, FPDFBitmap_GetStride(bitmap2));
+    const uint8_t* buffer1 =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bitmap1));
+    const uint8_t* buffer2 =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bitmap2));
+    return std::equal(buffer1, buffer1 + stride * lines, buffer2);
+  };
+
+  for (const char* filename : {"embedded_images.pdf", "jpx_lzw.pdf"}) {
+    SCOPED_TRACE(filename);
+    ASSERT_TRUE(OpenDocument(filename));
+    {
+      ScopedEmbedderTestPage page = LoadScopedPage(0);
+      ASSERT_TRUE(page);
+      const int width = static_cast<int>(FPDF_GetPageWidth(page.get()));
+      const int height = static_cast<int>(FPDF_GetPageHeight(page.get()));
+      const int clip_bottom = height / 2;
+
+      // Images cut by the clip only get decoded in part, but draw the same.
+      FPDF_SetImageCacheLimit(0);
+      ScopedFPDFBitmap full = render_page(page.get(), width, height, height);
+      ScopedFPDFBitmap clipped =
+          render_page(page.get(), width, height, clip_bottom);
+      EXPECT_TRUE(same_lines(full.get(), clipped.get(), clip_bottom));
+
+      // A partly decoded image does not get used for the full page.
+      FPDF_SetImageCacheLimit(256 * 1024 * 1024);
+      clipped = render_page(page.get(), width, height, clip_bottom);
+      EXPECT_TRUE(same_lines(full.get(), clipped.get(), clip_bottom));
+      ScopedFPDFBitmap full_again =
+          render_page(page.get(), width, height, height);
+      EXPECT_TRUE(same_lines(full.get(), full_again.get(), height));
+      FPDF_SetImageCacheLimit(0);
+    }
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, ImageThreadCount) {
+  EXPECT_FALSE(FPDF_SetImageThreadCount(-1));
+
+  // Rendered big enough for the rotated image to be split between threads.
+  static constexpr int kSize = 2600;
+  ASSERT_TRUE(OpenDocument("rotated_image.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  auto render_page = [&page]() {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(kSize, kSize, 0));
+    EXPECT_TRUE(FPDFBitmap_FillRect(bitmap.get(), 0, 0, kSize, kSize,
+                                    0xFFFFFFFF));
+    FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, kSize, kSize, 0, 0);
+    return HashBitmap(bitmap.get());
+  };
+  const std::string expected = render_page();
+
+  EXPECT_TRUE(FPDF_SetImageThreadCount(4));
+  EXPECT_EQ(expected, render_page());
+
+  EXPECT_TRUE(FPDF_SetImageThreadCount(0));
+  EXPECT_EQ(expected, render_page());
+
+  EXPECT_TRUE(FPDF_SetImageThreadCount(1));
+}
+
+TEST_F(FPDFViewEmbedderTest, RebuildThreadCount) {
+  EXPECT_FALSE(FPDF_SetRebuildThreadCount(-1));
+
+  // The document has no cross-reference table, so loading it rebuilds one.
+  EXPECT_TRUE(FPDF_SetRebuildThreadCount(0));
+  ASSERT_TRUE(OpenDocument("parser_rebuildxref_correct.pdf"));
+  EXPECT_EQ(1, FPDF_GetPageCount(document()));
+
+  EXPECT_TRUE(FPDF_SetRebuildThreadCount(1));
+}
+
 TEST_F(FPDFViewEmbedderTest, GetTrailerEndsHelloWorld) {
   // Single trailer, \n line ending at the trailer end.
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
@@ -2243,3 +2422,297 @@ TEST_F(FPDFViewEmbedderTest, DocumentVersionInCatalog) {
   EXPECT_TRUE(FPDF_GetFileVersion(document(), &version));
   EXPECT_EQ(16, version);
 }
+
+TEST_F(FPDFViewEmbedderTest, RenderDocumentsOnMultipleThreads) {
+  // Every PDF file in the test data directory, rendered up to this many pages
+  // each, so that the test covers a real sample of the corpus.
+  static constexpr int kMaxPagesPerFile = 3;
+  static constexpr size_t kThreadCount = 4;
+
+  std::string test_data_dir;
+  ASSERT_TRUE(PathService::GetTestDataDir(&test_data_dir));
+  std::unique_ptr<FX_Folder> folder =
+      FX_Folder::OpenFolder(ByteString(test_data_dir.c_str()));
+  ASSERT_TRUE(folder);
+  std::vector<std::string> file_names;
+  ByteString file_name;
+  bool is_folder;
+  while (folder->GetNextFile(&file_name, &is_folder)) {
+    std::string name(file_name.c_str());
+    if (!is_folder && name.ends_with(".pdf")) {
+      file_names.push_back(std::move(name));
+    }
+  }
+  std::sort(file_names.begin(), file_names.end());
+  ASSERT_FALSE(file_names.empty());
+
+  std::vector<std::vector<uint8_t>> contents;
+  for (const std::string& name : file_names) {
+    contents.push_back(
+        GetFileContents(PathService::GetTestFilePath(name).c_str()));
+    EXPECT_FALSE(contents.back().empty()) << name;
+  }
+
+  // Returns the checksums of the first pages of `contents`, rendered with
+  // per-thread resources. Pages that fail to load get an empty checksum, so
+  // that failures show up as mismatches too. Always releases the per-thread
+  // resources, even on failure.
+  auto render_pages = [](pdfium::span<const uint8_t> contents) {
+    std::vector<std::string> checksums;
+    {
+      ScopedFPDFDocument doc(FPDF_LoadMemDocument64(
+          contents.data(), contents.size(), /*password=*/nullptr));
+      const int page_count =
+          doc ? std::min(FPDF_GetPageCount(doc.get()), kMaxPagesPerFile) : 0;
+      for (int i = 0; i < page_count; ++i) {
+        ScopedFPDFPage page(FPDF_LoadPage(doc.get(), i));
+        if (!page) {
+          checksums.emplace_back();
+          continue;
+        }
+        ScopedFPDFBitmap bitmap = RenderPage(page.get());
+        checksums.push_back(bitmap ? HashBitmap(bitmap.get()) : std::string());
+      }
+    }
+    return checksums;
+  };
+
+  // Renders the files from `next_file` onwards into `results` on a new
+  // thread, until none are left.
+  auto render_files = [&contents, &render_pages](
+                          std::atomic<size_t>* next_file,
+                          std::vector<std::vector<std::string>>* results) {
+    const bool initialized = FPDF_InitLibraryForThread();
+    EXPECT_TRUE(initialized);
+    if (initialized) {
+      for (size_t i = (*next_file)++; i < contents.size(); i = (*next_file)++) {
+        (*results)[i] = render_pages(contents[i]);
+      }
+    }
+    FPDF_DestroyLibraryForThread();
+  };
+
+  // The initializing thread already owns per-thread resources.
+  EXPECT_FALSE(FPDF_InitLibraryForThread());
+
+  // Render the files on one thread first to get the expected results.
+  std::vector<std::vector<std::string>> expected(contents.size());
+  std::atomic<size_t> next_file = 0;
+  std::thread(render_files, &next_file, &expected).join();
+
+  // Render them again on several threads at once.
+  std::vector<std::vector<std::string>> actual(contents.size());
+  next_file = 0;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back(render_files, &next_file, &actual);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < contents.size(); ++i) {
+    EXPECT_EQ(expected[i], actual[i]) << file_names[i];
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderOnThreadWithoutThreadInit) {
+  // Threads that do not call FPDF_InitLibraryForThread() share the library
+  // state of the initializing thread, so they can use its documents as long
+  // as their calls do not overlap.
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  const std::string expected = HashBitmap(RenderPage(page.get()).get());
+
+  std::string actual;
+  std::thread([&page, &actual]() {
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    actual = HashBitmap(bitmap.get());
+  }).join();
+  EXPECT_EQ(expected, actual);
+}
+
+namespace {
+
+// Creates white page-sized bitmaps and keeps the rendered results.
+struct CollectingProducer : public FPDF_PAGE_BITMAP_PRODUCER {
+  CollectingProducer() {
+    version = 1;
+    GetBitmap = GetBitmapImpl;
+    PageRendered = PageRenderedImpl;
+  }
+
+  static FPDF_BITMAP GetBitmapImpl(FPDF_PAGE_BITMAP_PRODUCER* pThis,
+                                   int page_index,
+                                   float page_width,
+                                   float page_height) {
+    const int width = static_cast<int>(page_width);
+    const int height = static_cast<int>(page_height);
+    FPDF_BITMAP bitmap = FPDFBitmap_Create(width, height, /*alpha=*/0);
+    FPDFBitmap_FillRect(bitmap, 0, 0, width, height, 0xFFFFFFFF);
+    return bitmap;
+  }
+
+  static void PageRenderedImpl(FPDF_PAGE_BITMAP_PRODUCER* pThis,
+                               int page_index,
+                               FPDF_BITMAP bitmap) {
+    auto* producer = static_cast<CollectingProducer*>(pThis);
+    std::lock_guard<std::mutex> lock(producer->lock);
+    producer->bitmaps[page_index].reset(bitmap);
+  }
+
+  std::mutex lock;
+  std::map<int, ScopedFPDFBitmap> bitmaps;
+};
+
+}  // namespace
+
+TEST_F(FPDFViewEmbedderTest, RenderPagesParallel) {
+  ASSERT_TRUE(OpenDocument("rectangles_multi_pages.pdf"));
+  const int page_count = FPDF_GetPageCount(document());
+  ASSERT_GT(page_count, 1);
+
+  std::map<int, std::string> expected;
+  for (int i = 0; i < page_count; ++i) {
+    ScopedEmbedderTestPage page = LoadScopedPage(i);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    expected[i] = HashBitmap(bitmap.get());
+  }
+
+  auto get_checksums = [](const CollectingProducer& producer) {
+    std::map<int, std::string> checksums;
+    for (const auto& it : producer.bitmaps) {
+      checksums[it.first] = HashBitmap(it.second.get());
+    }
+    return checksums;
+  };
+
+  for (int thread_count : {0, 1, 2, 3}) {
+    CollectingProducer producer;
+    EXPECT_TRUE(FPDF_RenderPagesParallel(document(), 0, page_count,
+                                         thread_count, 0, &producer));
+    EXPECT_EQ(expected, get_checksums(producer));
+  }
+
+  // A sub-range only renders the requested pages.
+  CollectingProducer producer;
+  EXPECT_TRUE(FPDF_RenderPagesParallel(document(), 1, page_count - 1, 2, 0,
+                                       &producer));
+  expected.erase(0);
+  EXPECT_EQ(expected, get_checksums(producer));
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderPagesParallelBadParams) {
+  ASSERT_TRUE(OpenDocument("rectangles_multi_pages.pdf"));
+  const int page_count = FPDF_GetPageCount(document());
+
+  CollectingProducer producer;
+  EXPECT_FALSE(FPDF_RenderPagesParallel(nullptr, 0, 1, 1, 0, &producer));
+  EXPECT_FALSE(FPDF_RenderPagesParallel(document(), 0, 1, 1, 0, nullptr));
+  EXPECT_FALSE(FPDF_RenderPagesParallel(document(), -1, 1, 1, 0, &producer));
+  EXPECT_FALSE(FPDF_RenderPagesParallel(document(), 0, page_count + 1, 1, 0,
+                                        &producer));
+  EXPECT_FALSE(FPDF_RenderPagesParallel(document(), 0, 1, -1, 0, &producer));
+
+  CollectingProducer bad_version;
+  bad_version.version = 2;
+  EXPECT_FALSE(FPDF_RenderPagesParallel(document(), 0, 1, 1, 0, &bad_version));
+  EXPECT_TRUE(producer.bitmaps.empty());
+
+  // New documents have no file to parse on other threads.
+  ScopedFPDFDocument new_doc(FPDF_CreateNewDocument());
+  EXPECT_FALSE(FPDF_RenderPagesParallel(new_doc.get(), 0, 0, 1, 0, &producer));
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderPageBitmapParallel) {
+  static constexpr const char* kFileNames[] = {
+      "rectangles.pdf",
+      "annotation_stamp_with_ap.pdf",
+      "embedded_images.pdf",
+      "rotated_text.pdf",
+  };
+
+  for (const char* file_name : kFileNames) {
+    SCOPED_TRACE(file_name);
+    ASSERT_TRUE(OpenDocument(file_name));
+    {
+      ScopedEmbedderTestPage page = LoadScopedPage(0);
+      ASSERT_TRUE(page);
+
+      const int width = static_cast<int>(FPDF_GetPageWidthF(page.get()) * 2);
+      const int height =
+          static_cast<int>(FPDF_GetPageHeightF(page.get()) * 2);
+      auto create_bitmap = [width, height]() {
+        ScopedFPDFBitmap bitmap(
+            FPDFBitmap_Create(width, height, /*alpha=*/0));
+        FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+        return bitmap;
+      };
+
+      for (int rotate : {0, 1}) {
+        ScopedFPDFBitmap expected = create_bitmap();
+        FPDF_RenderPageBitmap(expected.get(), page.get(), 0, 0, width, height,
+                              rotate, FPDF_ANNOT);
+        const std::string expected_checksum = HashBitmap(expected.get());
+
+        for (int thread_count : {0, 1, 2, 3, 8}) {
+          ScopedFPDFBitmap actual = create_bitmap();
+          EXPECT_TRUE(FPDF_RenderPageBitmapParallel(
+              actual.get(), page.get(), 0, 0, width, height, rotate,
+              FPDF_ANNOT, thread_count));
+          EXPECT_EQ(expected_checksum, HashBitmap(actual.get()));
+        }
+      }
+    }
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderPageBitmapParallelBadParams) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  ScopedFPDFBitmap bitmap(FPDFBitmap_Create(20, 20, /*alpha=*/0));
+  EXPECT_FALSE(FPDF_RenderPageBitmapParallel(nullptr, page.get(), 0, 0, 20,
+                                             20, 0, 0, 1));
+  EXPECT_FALSE(FPDF_RenderPageBitmapParallel(bitmap.get(), nullptr, 0, 0, 20,
+                                             20, 0, 0, 1));
+  EXPECT_FALSE(FPDF_RenderPageBitmapParallel(bitmap.get(), page.get(), 0, 0,
+                                             20, 20, 0, 0, -1));
+
+  // Pages of new documents have no file to parse on other threads.
+  ScopedFPDFDocument new_doc(FPDF_CreateNewDocument());
+  ScopedFPDFPage new_page(FPDFPage_New(new_doc.get(), 0, 100, 100));
+  EXPECT_FALSE(FPDF_RenderPageBitmapParallel(bitmap.get(), new_page.get(), 0,
+                                             0, 20, 20, 0, 0, 1));
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderPageBitmapParallelWithEdits) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  const int width = static_cast<int>(FPDF_GetPageWidthF(page.get()));
+  const int height = static_cast<int>(FPDF_GetPageHeightF(page.get()));
+  auto render_parallel = [&]() {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, /*alpha=*/0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+    EXPECT_TRUE(FPDF_RenderPageBitmapParallel(bitmap.get(), page.get(), 0, 0,
+                                              width, height, 0, 0,
+                                              /*thread_count=*/2));
+    return HashBitmap(bitmap.get());
+  };
+  const std::string original_checksum = render_parallel();
+
+  // An object removed but not yet written to the content stream.
+  ScopedFPDFPageObject removed(FPDFPage_GetObject(page.get(), 0));
+  ASSERT_TRUE(FPDFPage_RemoveObject(page.get(), removed.get()));
+  const std::string edited_checksum = render_parallel();
+  EXPECT_NE(original_checksum, edited_checksum);
+
+  // The same, once written to the content stream.
+  ASSERT_TRUE(FPDFPage_GenerateContent(page.get()));
+  EXPECT_EQ(edited_checksum, render_parallel());
+}
@@ -197,6 +197,23 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsFormAvail(FPDF_AVAIL avail,
 // if the PDF is linearlized.
 FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsLinearized(FPDF_AVAIL avail);
 
+// Experimental API.
+// Get statistics about the download hints given so far.
+//
+//   avail    - handle to document availability provider.
+//   batches  - receives the number of FPDFAvail_IsDocAvail(),
+//              FPDFAvail_IsPageAvail() and FPDFAvail_IsFormAvail() calls that
+//              added segments to their |FX_DOWNLOADHINTS|. Each such call
+//              needs one round trip to fetch the data. May be NULL.
+//   segments - receives the total number of segments added. Overlapping and
+//              nearby segments are merged before they are added. May be NULL.
+//
+// Returns TRUE on success.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDFAvail_GetDownloadHintStats(FPDF_AVAIL avail,
+                               unsigned long* batches,
+                               unsigned long* segments);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
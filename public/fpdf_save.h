@@ -45,6 +45,11 @@ typedef struct FPDF_FILEWRITE_ {
 #define FPDF_INCREMENTAL 1
 #define FPDF_NO_INCREMENTAL 2
 #define FPDF_REMOVE_SECURITY 3
+// Experimental. Like FPDF_INCREMENTAL, but also appends the objects that
+// changed since the document was loaded, and a cross-reference stream for
+// them that also frees the deleted objects. The original file is copied
+// unchanged.
+#define FPDF_INCREMENTAL_CHANGES 4
 
 // Function: FPDF_SaveAsCopy
 //          Saves the copy of specified document in custom way.
@@ -78,6 +83,29 @@ FPDF_SaveWithVersion(FPDF_DOCUMENT document,
                      FPDF_DWORD flags,
                      int fileVersion);
 
+// Experimental API.
+// Function: FPDF_SaveWithObjectStreams
+//          Same as FPDF_SaveAsCopy(), except that objects other than streams
+//          are packed into compressed object streams, and the cross-reference
+//          section is written as a cross-reference stream. The saved document
+//          is at least PDF 1.5.
+// Parameters:
+//          document            -   Handle to document.
+//          pFileWrite          -   A pointer to a custom file write structure.
+//          flags               -   The creating flags. FPDF_INCREMENTAL and
+//                                  FPDF_INCREMENTAL_CHANGES are not supported.
+//          objects_per_stream  -   The maximum number of objects in each object
+//                                  stream, from 1 to 65535, or 0 for the
+//                                  default of 100.
+// Return value:
+//          TRUE if succeed, FALSE if failed.
+//
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SaveWithObjectStreams(FPDF_DOCUMENT document,
+                           FPDF_FILEWRITE* pFileWrite,
+                           FPDF_DWORD flags,
+                           int objects_per_stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,9 @@
 // NOTE: None of the PDFium APIs are thread-safe. They expect to be called
 // from a single thread. Barring that, embedders are required to ensure (via
 // a mutex or similar) that only a single PDFium call can be made at a time.
+// Any thread may make those calls. The one exception is threads set up with
+// FPDF_InitLibraryForThread(), which may each work on their own documents
+// concurrently.
 //
 // NOTE: External docs refer to this file as "fpdfview.h", so do not rename
 // despite lack of consistency with other public files.
@@ -323,6 +326,46 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_InitLibrary();
 //          closing the library with this function.
 FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary();
 
+// Experimental API.
+// Function: FPDF_InitLibraryForThread
+//          Allocate per-thread resources for the calling thread, so that it
+//          can load and render documents concurrently with other threads.
+// Parameters:
+//          None.
+// Return value:
+//          TRUE if per-thread resources were allocated, FALSE if the library
+//          is not initialized or the calling thread already has them.
+// Comments:
+//          FPDF_InitLibrary() or FPDF_InitLibraryWithConfig() must have been
+//          called first. The thread that initialized the library does not
+//          need to call this function.
+//
+//          Threads that do not call this function share the library state
+//          set up by FPDF_InitLibrary(), and must not call into the library
+//          concurrently. On a thread that does, font, color space and cache
+//          state is private to that thread, so every handle obtained on it
+//          (documents, pages, bitmaps rendered from them, etc.) must only be
+//          used and closed on that same thread. Settings such as
+//          FPDF_SetSystemFontInfo() then only affect the calling thread.
+//
+//          Calling FPDF_DestroyLibrary() while other threads still hold
+//          per-thread resources is not supported.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_InitLibraryForThread();
+
+// Experimental API.
+// Function: FPDF_DestroyLibraryForThread
+//          Release per-thread resources allocated by
+//          FPDF_InitLibraryForThread() for the calling thread.
+// Parameters:
+//          None.
+// Return value:
+//          None.
+// Comments:
+//          All objects created on the calling thread must be closed first.
+//          Does nothing on threads that did not call
+//          FPDF_InitLibraryForThread().
+FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibraryForThread();
+
 // Policy for accessing the local machine time.
 #define FPDF_POLICY_MACHINETIME_ACCESS 0
 
@@ -638,6 +681,120 @@ FPDF_GetTrailerEnds(FPDF_DOCUMENT document,
                     unsigned int* buffer,
                     unsigned long length);
 
+// Experimental API.
+// Function: FPDF_SetObjectStreamCacheLimit
+//          Set how much memory the document may use to keep decoded object
+//          streams.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          max_bytes   -   The maximum number of bytes of decoded object
+//                          stream data to keep.
+// Return value:
+//          TRUE if the limit was set, FALSE if |document| is invalid.
+// Comments:
+//          Objects stored in object streams are parsed from the decoded
+//          stream. Decoded streams are kept so that other objects in them can
+//          be parsed without decoding the stream again. Once the limit is
+//          reached, the least recently used streams are released, and are
+//          decoded again if needed. The default limit is 32 MB. Objects that
+//          have already been parsed are not affected.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetObjectStreamCacheLimit(FPDF_DOCUMENT document, size_t max_bytes);
+
+// Experimental API.
+// Function: FPDF_GetObjectStreamCacheStats
+//          Get how often the document found a decoded object stream in its
+//          cache.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          hits        -   Receives the number of times a decoded object
+//                          stream was found in the cache. May be NULL.
+//          misses      -   Receives the number of times an object stream had
+//                          to be decoded. May be NULL.
+// Return value:
+//          TRUE on success, FALSE if |document| is invalid.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetObjectStreamCacheStats(FPDF_DOCUMENT document,
+                               unsigned long* hits,
+                               unsigned long* misses);
+
+// Experimental API.
+// Function: FPDF_SetImageCacheLimit
+//          Set how much memory may be used to keep decoded images.
+// Parameters:
+//          max_bytes   -   The maximum number of bytes of decoded images to
+//                          keep.
+// Return value:
+//          None.
+// Comments:
+//          Decoded images are kept across pages and documents, so that an
+//          image drawn on several pages, or drawn again after its page was
+//          closed, is not decoded again. Once the limit is reached, the least
+//          recently used images are released, and are decoded again if
+//          needed. The images of a document are released when it is closed.
+//          The default limit is 0, which keeps no images.
+//
+//          Threads set up with FPDF_InitLibraryForThread() have their own
+//          cache. Otherwise, the cache is shared by all threads.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetImageCacheLimit(size_t max_bytes);
+
+// Experimental API.
+// Function: FPDF_GetImageCacheStats
+//          Get how often rendering found a decoded image in the image cache
+//          used by the calling thread.
+// Parameters:
+//          hits        -   Receives the number of times a decoded image was
+//                          found in the cache. May be NULL.
+//          misses      -   Receives the number of times an image had to be
+//                          decoded. May be NULL.
+//          bytes       -   Receives the number of bytes of decoded images
+//                          currently kept. May be NULL.
+// Return value:
+//          None.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_GetImageCacheStats(unsigned long* hits,
+                                                       unsigned long* misses,
+                                                       size_t* bytes);
+
+// Experimental API.
+// Function: FPDF_SetImageThreadCount
+//          Set how many threads may be used to scale or rotate one large
+//          image while rendering.
+// Parameters:
+//          thread_count    -   Maximum number of threads to use, including the
+//                              rendering thread. 0 means the number of
+//                              hardware threads.
+// Return value:
+//          TRUE on success, FALSE if |thread_count| is negative.
+// Comments:
+//          The default is 1, which keeps all work on the rendering thread.
+//          Only images big enough to make starting threads worthwhile are
+//          split up, and the rendered pixels are the same for any thread
+//          count. Progressive rendering still pauses as requested, between
+//          groups of rows.
+//
+//          Threads set up with FPDF_InitLibraryForThread() have their own
+//          setting. Otherwise, the setting is shared by all threads.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetImageThreadCount(int thread_count);
+
+// Experimental API.
+// Function: FPDF_SetRebuildThreadCount
+//          Set how many threads may be used to rebuild the cross-reference
+//          table of a damaged document while loading it.
+// Parameters:
+//          thread_count    -   Maximum number of threads to use, including the
+//                              loading thread. 0 means the number of hardware
+//                              threads.
+// Return value:
+//          TRUE on success, FALSE if |thread_count| is negative.
+// Comments:
+//          The default is 1, which keeps all work on the loading thread. Only
+//          documents of at least 1 MB that are loaded from memory are split
+//          up, and the loaded document is the same for any thread count.
+//
+//          The setting is shared by all threads, and applies to documents
+//          loaded afterwards.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetRebuildThreadCount(int thread_count);
+
 // Function: FPDF_GetDocPermissions
 //          Get file permission flags of the document.
 // Parameters:
@@ -930,6 +1087,138 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 const FS_RECTF* clipping,
                                 int flags);
 
+// Experimental API.
+// Structure for supplying and receiving bitmaps in FPDF_RenderPagesParallel().
+// All callbacks are invoked on worker threads, possibly several at once, so
+// they must be thread-safe.
+typedef struct FPDF_PAGE_BITMAP_PRODUCER_ {
+  // Version number of the interface. Currently must be 1.
+  int version;
+
+  // Method: GetBitmap
+  //          Provides the bitmap to render a page into. The page is scaled to
+  //          fill the whole bitmap.
+  // Interface Version:
+  //          1
+  // Implementation Required:
+  //          Yes
+  // Parameters:
+  //          pThis       -   Pointer to the interface structure itself.
+  //          page_index  -   Index number of the page, starting from 0.
+  //          page_width  -   Page width in points.
+  //          page_height -   Page height in points.
+  // Return value:
+  //          A bitmap created by FPDFBitmap_Create() or
+  //          FPDFBitmap_CreateEx(), or NULL to skip the page.
+  FPDF_BITMAP (*GetBitmap)(struct FPDF_PAGE_BITMAP_PRODUCER_* pThis,
+                           int page_index,
+                           float page_width,
+                           float page_height);
+
+  // Method: PageRendered
+  //          Reports that a page is done. Ownership of |bitmap| returns to
+  //          the embedder, who must destroy it.
+  // Interface Version:
+  //          1
+  // Implementation Required:
+  //          Yes
+  // Parameters:
+  //          pThis       -   Pointer to the interface structure itself.
+  //          page_index  -   Index number of the page, starting from 0.
+  //          bitmap      -   The bitmap returned by GetBitmap(), or NULL if
+  //                          GetBitmap() returned NULL or the page failed to
+  //                          load.
+  // Return value:
+  //          None.
+  void (*PageRendered)(struct FPDF_PAGE_BITMAP_PRODUCER_* pThis,
+                       int page_index,
+                       FPDF_BITMAP bitmap);
+} FPDF_PAGE_BITMAP_PRODUCER;
+
+// Experimental API.
+// Function: FPDF_RenderPagesParallel
+//          Render a range of pages on several threads at once.
+// Parameters:
+//          document     -   Handle to a document loaded from a file or from
+//                           memory.
+//          start_index  -   Index of the first page to render.
+//          page_count   -   Number of pages to render.
+//          thread_count -   Maximum number of threads to use, including the
+//                           calling thread. 0 means one per processor.
+//          flags        -   Same as for FPDF_RenderPageBitmap().
+//          producer     -   Callbacks that supply and receive the bitmaps.
+// Return value:
+//          TRUE if all pages were handed to |producer|, FALSE on invalid
+//          arguments, or if the document cannot be rendered this way.
+// Comments:
+//          Each thread parses its own copy of |document| from the document's
+//          file source, because parsed PDF objects cannot be shared between
+//          threads. Unsaved changes to |document| are therefore not rendered,
+//          and documents created by FPDF_CreateNewDocument() or using XFA are
+//          rejected. Threads pick up the next unrendered page as soon as they
+//          finish one, so uneven page costs are balanced. Pages are rendered
+//          without forms, as with FPDF_RenderPageBitmap().
+//
+//          The file source is shared by all threads under a lock, so custom
+//          FPDF_FILEACCESS implementations need no extra synchronization.
+//          The worker threads get their own library state, as if set up with
+//          FPDF_InitLibraryForThread().
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPagesParallel(FPDF_DOCUMENT document,
+                         int start_index,
+                         int page_count,
+                         int thread_count,
+                         int flags,
+                         FPDF_PAGE_BITMAP_PRODUCER* producer);
+
+// Experimental API.
+// Function: FPDF_RenderPageBitmapParallel
+//          Render contents of a page to a device independent bitmap, using
+//          several threads at once.
+// Parameters:
+//          bitmap       -   Handle to the device independent bitmap (as the
+//                           output buffer). The bitmap handle can be created
+//                           by FPDFBitmap_Create or retrieved from an image
+//                           object by FPDFImageObj_GetBitmap.
+//          page         -   Handle to the page. Returned by FPDF_LoadPage.
+//          start_x      -   Left pixel position of the display area in
+//                           bitmap coordinates.
+//          start_y      -   Top pixel position of the display area in bitmap
+//                           coordinates.
+//          size_x       -   Horizontal size (in pixels) for displaying the
+//                           page.
+//          size_y       -   Vertical size (in pixels) for displaying the
+//                           page.
+//          rotate       -   Page orientation, same as for
+//                           FPDF_RenderPageBitmap().
+//          flags        -   Same as for FPDF_RenderPageBitmap().
+//          thread_count -   Maximum number of threads to use, including the
+//                           calling thread. 0 means one per processor.
+// Return value:
+//          TRUE if the page was rendered, FALSE on invalid arguments, or if
+//          the page cannot be rendered this way.
+// Comments:
+//          Splits the display area into horizontal bands, and renders each
+//          band with its own clip on the first free thread. This pays off for
+//          pages that take long to render, such as large drawings at high
+//          resolutions.
+//
+//          Each thread parses its own copy of the page from the document's
+//          file source, with the same restrictions as for
+//          FPDF_RenderPagesParallel(). If |page| or its document has unsaved
+//          changes, the page is rendered on the calling thread only, as by
+//          FPDF_RenderPageBitmap().
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPageBitmapParallel(FPDF_BITMAP bitmap,
+                              FPDF_PAGE page,
+                              int start_x,
+                              int start_y,
+                              int size_x,
+                              int size_y,
+                              int rotate,
+                              int flags,
+                              int thread_count);
+
 #if defined(PDF_USE_SKIA)
 // Experimental API.
 // Function: FPDF_RenderPageSkia
@@ -0,0 +1,34 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "testing/benchmarks/benchmark.h"
+
+#include <stdio.h>
+
+#include <chrono>
+
+namespace pdfium::benchmark {
+
+double ItemsPerSecond(const std::function<size_t()>& run) {
+  static constexpr std::chrono::seconds kMinDuration(1);
+
+  // Warm up caches and lazily initialized state first.
+  run();
+
+  size_t items = 0;
+  const auto start = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed{};
+  do {
+    items += run();
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed < kMinDuration);
+  return items / elapsed.count();
+}
+
+void Report(const char* name, double items_per_second, const char* unit) {
+  printf("%-40s %10.1f million %s per second\n", name, items_per_second / 1e6,
+         unit);
+}
+
+}  // namespace pdfium::benchmark
@@ -0,0 +1,27 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TESTING_BENCHMARKS_BENCHMARK_H_
+#define TESTING_BENCHMARKS_BENCHMARK_H_
+
+#include <stddef.h>
+
+#include <functional>
+
+namespace pdfium::benchmark {
+
+// Calls `run` repeatedly for at least a second, and returns the number of
+// items processed per second. `run` returns how many items it processed.
+double ItemsPerSecond(const std::function<size_t()>& run);
+
+// Prints one line of results for the benchmark called `name`.
+void Report(const char* name, double items_per_second, const char* unit);
+
+// The benchmark groups. Each one prints the results of its benchmarks.
+void RunScanlineCompositorBenchmarks();
+void RunSyntaxParserBenchmarks();
+
+}  // namespace pdfium::benchmark
+
+#endif  // TESTING_BENCHMARKS_BENCHMARK_H_
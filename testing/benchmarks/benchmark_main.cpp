@@ -0,0 +1,52 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Times hot loops of PDFium on generated input. Pass the name of a benchmark
+// group to only run that group. Build in release mode for meaningful results.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "core/fxcrt/fx_memory.h"
+#include "testing/benchmarks/benchmark.h"
+
+namespace {
+
+struct BenchmarkGroup {
+  const char* name;
+  void (*run)();
+};
+
+constexpr BenchmarkGroup kGroups[] = {
+    {"scanline_compositor",
+     pdfium::benchmark::RunScanlineCompositorBenchmarks},
+    {"syntax_parser", pdfium::benchmark::RunSyntaxParserBenchmarks},
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 2) {
+    fprintf(stderr, "Usage: %s [group]\n", argv[0]);
+    return 1;
+  }
+
+  FX_InitializeMemoryAllocators();
+
+  bool found = false;
+  for (const BenchmarkGroup& group : kGroups) {
+    if (argc == 2 && strcmp(argv[1], group.name) != 0) {
+      continue;
+    }
+    found = true;
+    group.run();
+  }
+  FX_DestroyMemoryAllocators();
+
+  if (!found) {
+    fprintf(stderr, "Unknown benchmark group: %s\n", argv[1]);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/dib/fx_dib_simd.h"
+#include "testing/benchmarks/benchmark.h"
+
+namespace pdfium::benchmark {
+
+namespace {
+
+// A typical page width in pixels.
+constexpr int kWidth = 2000;
+
+// The number of rows each timed call composites.
+constexpr int kRows = 100;
+
+std::vector<uint8_t> MakeBytes(size_t size, uint32_t seed) {
+  std::vector<uint8_t> bytes(size);
+  for (auto& byte : bytes) {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<uint8_t>(seed >> 16);
+  }
+  return bytes;
+}
+
+// Reports the speed of compositing with the vectorized kernels, then with
+// only the scalar code that they replace.
+void ReportWithAndWithoutKernels(const std::string& name,
+                                 const std::function<size_t()>& run) {
+  const double simd = ItemsPerSecond(run);
+  fxge::SetSimdKernelsEnabledForTesting(false);
+  const double scalar = ItemsPerSecond(run);
+  fxge::SetSimdKernelsEnabledForTesting(true);
+  Report(name.c_str(), simd, "pixels");
+  Report((name + " (scalar)").c_str(), scalar, "pixels");
+}
+
+void RunRgbBenchmark(const char* name,
+                     FXDIB_Format dest_format,
+                     FXDIB_Format src_format,
+                     bool use_clip) {
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(dest_format, src_format, /*src_palette=*/{},
+                       /*mask_color=*/0, BlendMode::kNormal,
+                       /*bRgbByteOrder=*/false)) {
+    return;
+  }
+  const std::vector<uint8_t> src =
+      MakeBytes(kWidth * GetCompsFromFormat(src_format), /*seed=*/1);
+  const std::vector<uint8_t> clip =
+      use_clip ? MakeBytes(kWidth, /*seed=*/2) : std::vector<uint8_t>();
+  std::vector<uint8_t> dest =
+      MakeBytes(kWidth * GetCompsFromFormat(dest_format), /*seed=*/3);
+  ReportWithAndWithoutKernels(name, [&] {
+    for (int row = 0; row < kRows; ++row) {
+      compositor.CompositeRgbBitmapLine(dest, src, kWidth, clip);
+    }
+    return static_cast<size_t>(kWidth * kRows);
+  });
+}
+
+void RunByteMaskBenchmark(const char* name, bool use_clip) {
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(FXDIB_Format::kBgra, FXDIB_Format::k8bppMask,
+                       /*src_palette=*/{}, /*mask_color=*/0xff336699,
+                       BlendMode::kNormal, /*bRgbByteOrder=*/false)) {
+    return;
+  }
+  const std::vector<uint8_t> mask = MakeBytes(kWidth, /*seed=*/4);
+  const std::vector<uint8_t> clip =
+      use_clip ? MakeBytes(kWidth, /*seed=*/5) : std::vector<uint8_t>();
+  std::vector<uint8_t> dest = MakeBytes(kWidth * 4, /*seed=*/6);
+  ReportWithAndWithoutKernels(name, [&] {
+    for (int row = 0; row < kRows; ++row) {
+      compositor.CompositeByteMaskLine(dest, mask, kWidth, clip);
+    }
+    return static_cast<size_t>(kWidth * kRows);
+  });
+}
+
+}  // namespace
+
+// Reports how fast CFX_ScanlineCompositor composites the rows that the
+// kernels in fx_dib_simd.h speed up.
+void RunScanlineCompositorBenchmarks() {
+  RunRgbBenchmark("Bgra over Bgra", FXDIB_Format::kBgra, FXDIB_Format::kBgra,
+                  /*use_clip=*/false);
+  RunRgbBenchmark("Bgra over Bgra, clipped", FXDIB_Format::kBgra,
+                  FXDIB_Format::kBgra, /*use_clip=*/true);
+  RunRgbBenchmark("Bgr to Bgra", FXDIB_Format::kBgra, FXDIB_Format::kBgr,
+                  /*use_clip=*/false);
+  RunRgbBenchmark("Bgr to Bgrx", FXDIB_Format::kBgrx, FXDIB_Format::kBgr,
+                  /*use_clip=*/false);
+  RunByteMaskBenchmark("Byte mask over Bgra", /*use_clip=*/false);
+  RunByteMaskBenchmark("Byte mask over Bgra, clipped", /*use_clip=*/true);
+}
+
+}  // namespace pdfium::benchmark
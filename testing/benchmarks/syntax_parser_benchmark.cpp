@@ -0,0 +1,37 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/benchmarks/benchmark.h"
+
+namespace pdfium::benchmark {
+
+// Reports how fast GetNextWord() goes through typical object syntax.
+void RunSyntaxParserBenchmarks() {
+  static constexpr char kObjects[] =
+      "12 0 obj\n<< /Type /Page /Parent 3 0 R /MediaBox [0 0 612 792]\n"
+      "   /Resources << /Font << /F1 5 0 R /F2 6 0 R >> >>\n"
+      "   /Contents 13 0 R /Annots [14 0 R 15 0 R 16 0 R] >>\nendobj\n"
+      "%a comment line, as some generators write between objects\n";
+  ByteString content;
+  while (content.GetLength() < 16 * 1024 * 1024) {
+    content += kObjects;
+  }
+
+  Report("CPDF_SyntaxParser::GetNextWord", ItemsPerSecond([&content] {
+           CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+               content.unsigned_span()));
+           size_t tokens = 0;
+           while (!parser.GetNextWord().word.IsEmpty()) {
+             ++tokens;
+           }
+           return tokens;
+         }),
+         "tokens");
+}
+
+}  // namespace pdfium::benchmark
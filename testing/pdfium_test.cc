@@ -10,10 +10,12 @@
 #include <string.h>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -200,6 +202,7 @@ struct Options {
   std::string font_directory;
   int first_page = 0;  // First 0-based page number to renderer.
   int last_page = 0;   // Last 0-based page number to renderer.
+  int threads = 0;     // Render pages on this many threads, if non-zero.
   time_t time = -1;
 };
 
@@ -241,6 +244,87 @@ int PageRenderFlagsFromOptions(const Options& options) {
   return flags;
 }
 
+// Renders pages with FPDF_RenderPagesParallel() and writes them out as they
+// complete.
+class ParallelPageWriter : public FPDF_PAGE_BITMAP_PRODUCER {
+ public:
+  ParallelPageWriter(const std::string& name, const Options& options)
+      : name_(name), options_(options) {
+    version = 1;
+    GetBitmap = GetBitmapImpl;
+    PageRendered = PageRenderedImpl;
+    if (!options_.scale_factor_as_string.empty()) {
+      std::stringstream(options_.scale_factor_as_string) >> scale_;
+    }
+  }
+
+  // Returns the number of pages rendered successfully.
+  int Render(FPDF_DOCUMENT doc, int first_page, int last_page) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!FPDF_RenderPagesParallel(doc, first_page, last_page - first_page,
+                                  options_.threads,
+                                  PageRenderFlagsFromOptions(options_), this)) {
+      fprintf(stderr, "Parallel rendering failed.\n");
+      return 0;
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    fprintf(stderr, "Rendered %d pages on %d threads in %.1f ms.\n",
+            rendered_pages_, options_.threads, elapsed.count());
+    return rendered_pages_;
+  }
+
+ private:
+  static FPDF_BITMAP GetBitmapImpl(FPDF_PAGE_BITMAP_PRODUCER* pThis,
+                                   int page_index,
+                                   float page_width,
+                                   float page_height) {
+    auto* writer = static_cast<ParallelPageWriter*>(pThis);
+    const int width = static_cast<int>(page_width * writer->scale_);
+    const int height = static_cast<int>(page_height * writer->scale_);
+    FPDF_BITMAP bitmap = FPDFBitmap_Create(width, height, /*alpha=*/0);
+    if (bitmap) {
+      FPDFBitmap_FillRect(bitmap, 0, 0, width, height, 0xFFFFFFFF);
+    }
+    return bitmap;
+  }
+
+  static void PageRenderedImpl(FPDF_PAGE_BITMAP_PRODUCER* pThis,
+                               int page_index,
+                               FPDF_BITMAP bitmap) {
+    auto* writer = static_cast<ParallelPageWriter*>(pThis);
+    ScopedFPDFBitmap owned_bitmap(bitmap);
+    std::lock_guard<std::mutex> lock(writer->lock_);
+    if (!bitmap) {
+      fprintf(stderr, "Failed to render page %d.\n", page_index);
+      return;
+    }
+
+    ++writer->rendered_pages_;
+    void* buffer = FPDFBitmap_GetBuffer(bitmap);
+    const int stride = FPDFBitmap_GetStride(bitmap);
+    const int width = FPDFBitmap_GetWidth(bitmap);
+    const int height = FPDFBitmap_GetHeight(bitmap);
+    const char* name = writer->name_.c_str();
+    switch (writer->options_.output_format) {
+      case OutputFormat::kPpm:
+        WritePpm(name, page_index, buffer, stride, width, height);
+        break;
+      case OutputFormat::kPng:
+        WritePng(name, page_index, buffer, stride, width, height);
+        break;
+      default:
+        break;
+    }
+  }
+
+  const std::string& name_;
+  const Options& options_;
+  double scale_ = 1.0;
+  std::mutex lock_;
+  int rendered_pages_ = 0;
+};
+
 std::optional<std::string> ExpandDirectoryPath(const std::string& path) {
 #if defined(WORDEXP_AVAILABLE)
   wordexp_t expansion;
@@ -745,6 +829,17 @@ bool ParseCommandLine(const std::vector<std::string>& args,
         fprintf(stderr, "Invalid --time argument, must be non-negative\n");
         return false;
       }
+    } else if (ParseSwitchKeyValue(cur_arg, "--threads=", &value)) {
+      if (options->threads) {
+        fprintf(stderr, "Duplicate --threads argument\n");
+        return false;
+      }
+      const std::string threads_string = value;
+      std::stringstream(threads_string) >> options->threads;
+      if (options->threads <= 0) {
+        fprintf(stderr, "Invalid --threads argument, must be positive\n");
+        return false;
+      }
     } else if (cur_arg.size() >= 2 && cur_arg[0] == '-' && cur_arg[1] == '-') {
       fprintf(stderr, "Unrecognized argument %s\n", cur_arg.c_str());
       return false;
@@ -1702,6 +1797,15 @@ void Processor::ProcessPdf(const std::string& name,
   int bad_pages = 0;
   int first_page = options().pages ? options().first_page : 0;
   int last_page = options().pages ? options().last_page + 1 : page_count;
+  if (options().threads) {
+    // Is_Data_Avail() reports all data as available, so the workers can
+    // parse their own copies of linearized documents too.
+    ParallelPageWriter writer(name, options());
+    processed_pages = writer.Render(doc.get(), first_page, last_page);
+    bad_pages = last_page - first_page - processed_pages;
+    first_page = last_page;
+  }
+
   PdfProcessor pdf_processor(this, &name, &events, doc.get(), form.get(),
                              &form_callbacks);
   for (int i = first_page; i < last_page; ++i) {
@@ -1835,6 +1939,9 @@ constexpr char kUsageString[] =
     "  --scale=<number>       - scale output size by number (e.g. 0.5)\n"
     "  --password=<secret>    - password to decrypt the PDF with\n"
     "  --pages=<number>(-<number>) - only render the given 0-based page(s)\n"
+    "  --threads=<number>     - render pages concurrently on this many "
+    "threads,\n"
+    "                           without forms; only --ppm and --png output\n"
 #ifdef _WIN32
     "  --bmp   - write page images <pdf-name>.<page-number>.bmp\n"
     "  --emf   - write page meta files <pdf-name>.<page-number>.emf\n"